@@ -35,4 +35,46 @@ namespace Devel {
     /// This variable is a predefined instance of std::logic_error exception
     /// which is initialized with the error message "This Code should not get executed!".
     static auto ShouldNotExecuteException = std::logic_error("This Code should not get executed!");
+
+    /// @var static auto BrokenPromiseException
+    /// @brief This exception is stored in a task future whose task was destroyed before it was executed.
+    ///
+    /// This variable is a predefined instance of std::logic_error exception
+    /// which is initialized with the error message "Task was destroyed before it was executed!".
+    static auto BrokenPromiseException = std::logic_error("Task was destroyed before it was executed!");
+
+    /// @var static auto InvalidFutureException
+    /// @brief This exception is thrown when a task future without shared state is accessed.
+    ///
+    /// This variable is a predefined instance of std::logic_error exception
+    /// which is initialized with the error message "Future has no shared state!".
+    static auto InvalidFutureException = std::logic_error("Future has no shared state!");
+
+    /// @var static auto CyclicGraphException
+    /// @brief This exception is thrown when a task graph whose dependencies form a cycle is run.
+    ///
+    /// This variable is a predefined instance of std::logic_error exception
+    /// which is initialized with the error message "Task graph contains a cycle!".
+    static auto CyclicGraphException = std::logic_error("Task graph contains a cycle!");
+
+    /// @var static auto GraphIsRunningException
+    /// @brief This exception is thrown when a running task graph is run again or cleared.
+    ///
+    /// This variable is a predefined instance of std::logic_error exception
+    /// which is initialized with the error message "Task graph is already running!".
+    static auto GraphIsRunningException = std::logic_error("Task graph is already running!");
+
+    /// @var static auto TaskCancelledException
+    /// @brief This exception is thrown when a task observes that it was cancelled or its deadline has passed.
+    ///
+    /// This variable is a predefined instance of std::runtime_error exception
+    /// which is initialized with the error message "Task was cancelled!".
+    static auto TaskCancelledException = std::runtime_error("Task was cancelled!");
+
+    /// @var static auto EmptyWhenAnyException
+    /// @brief This exception is thrown when whenAny() is called without a task, it could never complete.
+    ///
+    /// This variable is a predefined instance of std::invalid_argument exception
+    /// which is initialized with the error message "whenAny() needs at least one task!".
+    static auto EmptyWhenAnyException = std::invalid_argument("whenAny() needs at least one task!");
 }
\ No newline at end of file
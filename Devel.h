@@ -22,9 +22,32 @@
 #include "Threading/ThreadUtils.h"
 #include "Threading/Mutex/Mutex.h"
 #include "Threading/LockGuard/LockGuard.h"
+#include "Threading/LockProfiler/LockProfiler.h"
+#include "Threading/LockProfiler/ProfiledLock.h"
+#include "Threading/SharedMutex/SharedMutex.h"
+#include "Threading/FutexMutex/FutexMutex.h"
+#include "Threading/SpinLock/SpinLock.h"
+#include "Threading/NullLock/NullLock.h"
 #include "Threading/MutexVector/MutexVector.h"
+#include "Threading/ConcurrentHashMap/ConcurrentHashMap.h"
+#include "Threading/SnapshotVector/SnapshotVector.h"
 #include "Threading/SafeQueue/SafeQueue.h"
+#include "Threading/BoundedQueue/BoundedQueue.h"
+#include "Threading/SpscQueue/SpscQueue.h"
+#include "Threading/WorkStealingDeque/WorkStealingDeque.h"
+#include "Threading/PoolAllocator/PoolAllocator.h"
+#include "Threading/ScratchArena/ScratchArena.h"
+#include "Threading/InplaceTask/InplaceTask.h"
+#include "Threading/TaskFuture/TaskFuture.h"
+#include "Threading/Latch/Latch.h"
+#include "Threading/CancellationToken/CancellationToken.h"
+#include "Threading/CpuTopology/CpuTopology.h"
 #include "Threading/ThreadPool/ThreadPool.h"
+#include "Threading/TimerWheel/TimerWheel.h"
+#include "Threading/Task/Task.h"
+#include "Threading/TaskGraph/TaskGraph.h"
+#include "Threading/Pipeline/Pipeline.h"
+#include "Threading/Parallel/Parallel.h"
 
 #include "Serializing/SerializingDefines.h"
 #include "Serializing/Serializing.h"
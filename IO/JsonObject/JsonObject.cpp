@@ -10,18 +10,20 @@ Devel::IO::CJsonObject::~CJsonObject() {
 
 void Devel::IO::CJsonObject::addObject(const std::string &i_stName, Devel::IO::CJsonObject &&i_oObject) {
     if (!i_stName.empty()) {
+        Threading::RecursiveLockGuard(this->m_oMutex);
         this->m_aoData[i_stName] = std::move(i_oObject);
     }
 }
 
 Devel::IO::CJsonObject *Devel::IO::CJsonObject::find(const std::string_view i_stName) {
     Threading::RecursiveLockGuard(this->m_oMutex);
-    std::string str(i_stName);
-    return this->m_aoData.count(str) ? &this->m_aoData[str] : nullptr;
+    const auto it = this->m_aoData.find(std::string(i_stName));
+    return it != this->m_aoData.end() ? &it->second : nullptr;
 }
 
 
 void Devel::IO::CJsonObject::clear() {
+    Threading::RecursiveLockGuard(this->m_oMutex);
     delete this->m_pArray;
     this->m_pArray = nullptr;
     this->m_eType = EJsonType::JTObject;
@@ -42,6 +44,7 @@ std::vector<std::string> Devel::IO::CJsonObject::getKeys() {
 }
 
 Devel::IO::CJsonArray Devel::IO::CJsonObject::toArray() const {
+    Threading::RecursiveLockGuard(this->m_oMutex);
     if (this->m_pArray) {
         return *this->m_pArray;
     }
@@ -50,32 +53,60 @@ Devel::IO::CJsonArray Devel::IO::CJsonObject::toArray() const {
 }
 
 Devel::IO::CJsonObject &Devel::IO::CJsonObject::operator=(const Devel::IO::CJsonObject &i_oOther) {
-    this->clear();
-
-    this->m_eType = i_oOther.m_eType;
-    this->m_aoData = i_oOther.m_aoData;
+    // The source is copied under its own lock first, so two objects are never locked at once
+    EJsonType eType;
+    std::map<std::string, CJsonObject> aoData;
+    CJsonArray *pArray = nullptr;
+    std::string stValue;
+    {
+        Threading::RecursiveLockGuard(i_oOther.m_oMutex);
+        eType = i_oOther.m_eType;
+        aoData = i_oOther.m_aoData;
+        if (i_oOther.m_pArray)
+            pArray = new Devel::IO::CJsonArray(*i_oOther.m_pArray);
+        stValue = i_oOther;
+    }
 
+    Threading::RecursiveLockGuard(this->m_oMutex);
+    this->clear();
 
-    if (i_oOther.m_pArray)
-        this->m_pArray = new Devel::IO::CJsonArray(*i_oOther.m_pArray);
+    this->m_eType = eType;
+    this->m_aoData = std::move(aoData);
+    this->m_pArray = pArray;
 
-    std::string::operator=(i_oOther);
+    std::string::operator=(std::move(stValue));
     return *this;
 }
 
 Devel::IO::CJsonObject &Devel::IO::CJsonObject::operator=(Devel::IO::CJsonObject &&i_oOther) noexcept {
-    this->clear();
-    this->m_eType = i_oOther.m_eType;
-    this->m_aoData = i_oOther.m_aoData;
-    this->m_pArray = i_oOther.m_pArray;
-    std::string::operator=(i_oOther);
+    if (this == &i_oOther) {
+        return *this;
+    }
+
+    EJsonType eType;
+    std::map<std::string, CJsonObject> aoData;
+    CJsonArray *pArray;
+    std::string stValue;
+    {
+        Threading::RecursiveLockGuard(i_oOther.m_oMutex);
+        eType = i_oOther.m_eType;
+        aoData = std::move(i_oOther.m_aoData);
+        pArray = std::exchange(i_oOther.m_pArray, nullptr);
+        stValue = std::move(static_cast<std::string &>(i_oOther));
+        i_oOther.clear();
+    }
 
-    i_oOther.m_pArray = nullptr;
-    i_oOther.clear();
+    Threading::RecursiveLockGuard(this->m_oMutex);
+    this->clear();
+    this->m_eType = eType;
+    this->m_aoData = std::move(aoData);
+    this->m_pArray = pArray;
+    std::string::operator=(std::move(stValue));
     return *this;
 }
 
 Devel::IO::CJsonObject &Devel::IO::CJsonObject::operator=(const Devel::IO::CJsonArray &i_oOther) {
+    Threading::RecursiveLockGuard(this->m_oMutex);
     this->m_eType = EJsonType::JTArray;
 
     if (this->m_pArray) {
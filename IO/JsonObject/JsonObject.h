@@ -8,6 +8,7 @@
 #include <string_view>
 #include <string>
 #include <map>
+#include <utility>
 
 /// @namespace Devel::IO
 /// @brief The namespace encapsulating I/O related classes and functions in the Devel framework.
@@ -75,7 +76,7 @@ namespace Devel::IO {
         EJsonType m_eType;
     private:
         /// @var Threading::CMutex m_oMutex
-        /// @brief The mutex used for thread synchronization.
+        /// @brief The recursive mutex used for thread synchronization, every access to the data takes it.
         Threading::CMutex m_oMutex;
         /// @var CJsonArray *m_pArray
         /// @brief A pointer to the JSON array, if this object represents an array type.
@@ -92,7 +93,10 @@ namespace Devel::IO {
 
         /// @brief Sets the type of JSON value this object represents.
         /// @param i_eType - The type to set
-        void setType(const EJsonType i_eType) { this->m_eType = i_eType; }
+        void setType(const EJsonType i_eType) {
+            Threading::RecursiveLockGuard(this->m_oMutex);
+            this->m_eType = i_eType;
+        }
 
         /// @brief Clears all data from the object.
         void clear();
@@ -113,6 +117,7 @@ namespace Devel::IO {
 
     public:
         /// @brief Returns a reference to the mutex.
+        /// The mutex is recursive, a caller holding it may still call find() or operator[].
         /// @return A reference to the mutex.
         inline Threading::CMutex &mutex() {
             return this->m_oMutex;
@@ -129,7 +134,10 @@ namespace Devel::IO {
 
     public:
         /// @brief Sets the type of the JSON object to null.
-        inline void setNull() { this->m_eType = EJsonType::JTNull; }
+        inline void setNull() {
+            Threading::RecursiveLockGuard(this->m_oMutex);
+            this->m_eType = EJsonType::JTNull;
+        }
 
     public:
         /// @brief Converts the JSON object to a 64-bit unsigned integer.
@@ -177,48 +185,56 @@ namespace Devel::IO {
         }
 
         inline CJsonObject &operator=(const std::string &i_stValue) {
+            Threading::RecursiveLockGuard(this->m_oMutex);
             this->m_eType = EJsonType::JTString;
             std::string::operator=(i_stValue);
             return *this;
         }
 
         inline CJsonObject &operator=(const uint64 i_nValue) {
+            Threading::RecursiveLockGuard(this->m_oMutex);
             this->m_eType = EJsonType::JTNumber;
             std::string::operator=(std::to_string(i_nValue));
             return *this;
         }
 
         inline CJsonObject &operator=(const uint i_nValue) {
+            Threading::RecursiveLockGuard(this->m_oMutex);
             this->m_eType = EJsonType::JTNumber;
             std::string::operator=(std::to_string(i_nValue));
             return *this;
         }
 
         inline CJsonObject &operator=(const int64 i_nValue) {
+            Threading::RecursiveLockGuard(this->m_oMutex);
             this->m_eType = EJsonType::JTNumber;
             std::string::operator=(std::to_string(i_nValue));
             return *this;
         }
 
         inline CJsonObject &operator=(const float i_fValue) {
+            Threading::RecursiveLockGuard(this->m_oMutex);
             this->m_eType = EJsonType::JTNumber;
             std::string::operator=(std::to_string(i_fValue));
             return *this;
         }
 
         inline CJsonObject &operator=(const double i_dValue) {
+            Threading::RecursiveLockGuard(this->m_oMutex);
             this->m_eType = EJsonType::JTNumber;
             std::string::operator=(std::to_string(i_dValue));
             return *this;
         }
 
         inline CJsonObject &operator=(const int i_nValue) {
+            Threading::RecursiveLockGuard(this->m_oMutex);
             this->m_eType = EJsonType::JTNumber;
             std::string::operator=(std::to_string(i_nValue));
             return *this;
         }
 
         inline CJsonObject &operator=(const bool i_bState) {
+            Threading::RecursiveLockGuard(this->m_oMutex);
             this->operator=((i_bState ? "t" : "f"));
             this->m_eType = EJsonType::JTBoolean;
             return *this;
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "Threading/ThreadUtils.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CBoundedQueue<T, Capacity>
+    /// @brief A lock-free bounded multi-producer multi-consumer queue.
+    ///
+    /// The queue is a ring buffer of cells which carry a sequence number (Dmitry Vyukov's MPMC queue).
+    /// Producers and consumers claim a cell with a single compare-and-swap on the tail or head index,
+    /// which live on separate cache lines. The storage is allocated once, the queue never allocates afterwards.
+    ///
+    /// tryEnqueue() and tryDequeue() never block and never throw. enqueue() and dequeue() spin and yield
+    /// until they succeed.
+    ///
+    /// @tparam T The type of elements stored in the queue. It must be nothrow move constructible.
+    /// @tparam Capacity The maximum number of elements, must be a power of two.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CBoundedQueue<int, 1024> queue;
+    ///
+    ///     // Producer threads
+    ///     if (!queue.tryEnqueue(42)) {
+    ///         // The queue is full
+    ///     }
+    ///
+    ///     // Consumer threads
+    ///     int value;
+    ///     if (queue.tryDequeue(value)) {
+    ///         std::cout << value << std::endl;
+    ///     }
+    /// @endcode
+    template<typename T, size_t Capacity>
+    class CBoundedQueue {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two");
+        static_assert(std::is_nothrow_move_constructible_v<T>, "CBoundedQueue requires a nothrow move constructible type");
+
+    private:
+        /// @class CCell
+        /// @brief A slot of the ring buffer.
+        class CCell {
+        public:
+            /// @var std::atomic<size_t> m_nSequence
+            /// @brief The sequence number telling producers and consumers whose turn it is.
+            std::atomic<size_t> m_nSequence;
+
+            /// @var unsigned char m_aStorage[sizeof(T)]
+            /// @brief The storage of the element.
+            alignas(T) unsigned char m_aStorage[sizeof(T)];
+
+        public:
+            /// @brief Returns the element stored in the cell.
+            /// @return A pointer to the element.
+            T *value() { return std::launder(reinterpret_cast<T *>(this->m_aStorage)); }
+        };
+
+    public:
+        /// @brief Constructs an empty queue.
+        CBoundedQueue()
+                : m_aoCells(new CCell[Capacity]), m_nEnqueuePosition(0), m_nDequeuePosition(0) {
+            for (size_t i = 0; i < Capacity; i++) {
+                this->m_aoCells[i].m_nSequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Deleted copy constructor.
+        CBoundedQueue(const CBoundedQueue &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CBoundedQueue &operator=(const CBoundedQueue &) = delete;
+
+        /// @brief Destructor, destroys the remaining elements.
+        ~CBoundedQueue() {
+            this->clear();
+        }
+
+    public:
+        /// @brief Returns the maximum number of elements.
+        /// @return The capacity.
+        static constexpr size_t capacity() { return Capacity; }
+
+        /// @brief Returns an approximation of the number of elements in the queue.
+        /// @return The number of elements.
+        size_t size() const {
+            const size_t nEnqueue = this->m_nEnqueuePosition.load(std::memory_order_relaxed);
+            const size_t nDequeue = this->m_nDequeuePosition.load(std::memory_order_relaxed);
+            return (nEnqueue > nDequeue ? nEnqueue - nDequeue : 0);
+        }
+
+        /// @brief Checks if the queue is (approximately) empty.
+        /// @return True if the queue is empty, false otherwise.
+        bool isEmpty() const {
+            return this->size() == 0;
+        }
+
+    public:
+        /// @brief Tries to enqueue an element.
+        /// @param i_tValue The element to move into the queue.
+        /// @return True if the element was enqueued, false if the queue is full.
+        bool tryEnqueue(T &&i_tValue) noexcept {
+            size_t nPosition = this->m_nEnqueuePosition.load(std::memory_order_relaxed);
+            CCell *pCell;
+
+            while (true) {
+                pCell = &this->m_aoCells[nPosition & (Capacity - 1)];
+                const size_t nSequence = pCell->m_nSequence.load(std::memory_order_acquire);
+                const auto nDifference = static_cast<intptr_t>(nSequence) - static_cast<intptr_t>(nPosition);
+
+                if (nDifference == 0) {
+                    if (this->m_nEnqueuePosition.compare_exchange_weak(nPosition, nPosition + 1,
+                                                                       std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (nDifference < 0) {
+                    return false;
+                } else {
+                    nPosition = this->m_nEnqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            new(pCell->m_aStorage) T(std::move(i_tValue));
+            pCell->m_nSequence.store(nPosition + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Tries to enqueue a copy of an element.
+        /// @param i_tValue The element to copy into the queue.
+        /// @return True if the element was enqueued, false if the queue is full.
+        bool tryEnqueue(const T &i_tValue) {
+            T tCopy(i_tValue);
+            return this->tryEnqueue(std::move(tCopy));
+        }
+
+        /// @brief Tries to dequeue an element.
+        /// @param i_tOutValue Receives the element on success.
+        /// @return True if an element was dequeued, false if the queue is empty.
+        bool tryDequeue(T &i_tOutValue) noexcept(std::is_nothrow_move_assignable_v<T>) {
+            return this->tryConsume([&i_tOutValue](T &i_tValue) { i_tOutValue = std::move(i_tValue); });
+        }
+
+    public:
+        /// @brief Enqueues an element, spinning and yielding while the queue is full.
+        /// @param i_tValue The element to move into the queue.
+        void enqueue(T &&i_tValue) {
+            for (size_t nAttempt = 0; !this->tryEnqueue(std::move(i_tValue)); nAttempt++) {
+                CBoundedQueue::backoff(nAttempt);
+            }
+        }
+
+        /// @brief Enqueues a copy of an element, spinning and yielding while the queue is full.
+        /// @param i_tValue The element to copy into the queue.
+        void enqueue(const T &i_tValue) {
+            return this->enqueue(T(i_tValue));
+        }
+
+        /// @brief Dequeues an element, spinning and yielding while the queue is empty.
+        /// @return The dequeued element.
+        T dequeue() {
+            std::optional<T> oValue;
+            for (size_t nAttempt = 0; !this->tryConsume([&oValue](T &i_tValue) { oValue.emplace(std::move(i_tValue)); });
+                 nAttempt++) {
+                CBoundedQueue::backoff(nAttempt);
+            }
+
+            return std::move(*oValue);
+        }
+
+        /// @brief Destroys all elements in the queue.
+        void clear() {
+            while (this->tryConsume([](T &) {})) {}
+        }
+
+    private:
+        /// @brief Claims the oldest element, passes it to a function and destroys it.
+        /// @param i_fnConsume The function receiving the element.
+        /// @return True if an element was consumed, false if the queue is empty.
+        template<typename F>
+        bool tryConsume(F &&i_fnConsume) {
+            size_t nPosition = this->m_nDequeuePosition.load(std::memory_order_relaxed);
+            CCell *pCell;
+
+            while (true) {
+                pCell = &this->m_aoCells[nPosition & (Capacity - 1)];
+                const size_t nSequence = pCell->m_nSequence.load(std::memory_order_acquire);
+                const auto nDifference = static_cast<intptr_t>(nSequence) - static_cast<intptr_t>(nPosition + 1);
+
+                if (nDifference == 0) {
+                    if (this->m_nDequeuePosition.compare_exchange_weak(nPosition, nPosition + 1,
+                                                                       std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (nDifference < 0) {
+                    return false;
+                } else {
+                    nPosition = this->m_nDequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            i_fnConsume(*pCell->value());
+            pCell->value()->~T();
+            pCell->m_nSequence.store(nPosition + Capacity, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Waits a little before the next attempt of a blocking operation.
+        /// @param i_nAttempt The number of failed attempts so far.
+        static void backoff(const size_t i_nAttempt) {
+            if (i_nAttempt < 64) {
+                Utils::cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        /// @var std::unique_ptr<CCell[]> m_aoCells
+        /// @brief The ring buffer.
+        std::unique_ptr<CCell[]> m_aoCells;
+
+        /// @var std::atomic<size_t> m_nEnqueuePosition
+        /// @brief The next position producers claim.
+        alignas(64) std::atomic<size_t> m_nEnqueuePosition;
+
+        /// @var std::atomic<size_t> m_nDequeuePosition
+        /// @brief The next position consumers claim.
+        alignas(64) std::atomic<size_t> m_nDequeuePosition;
+    };
+}
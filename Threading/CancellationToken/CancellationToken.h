@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+#include "Core/Exceptions.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CCancellationState
+    /// @brief The reference counted flag shared by a CCancellationSource and its tokens.
+    class CCancellationState {
+    public:
+        /// @brief Constructs a state which is not cancelled, referenced once.
+        CCancellationState()
+                : m_nReferences(1), m_fIsCancelled(false) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CCancellationState(const CCancellationState &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CCancellationState &operator=(const CCancellationState &) = delete;
+
+    public:
+        /// @brief Increments the reference count.
+        void addReference() {
+            this->m_nReferences.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// @brief Decrements the reference count and destroys the state when it reaches zero.
+        void release() {
+            if (this->m_nReferences.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+
+        /// @brief Sets the cancellation flag.
+        void cancel() {
+            this->m_fIsCancelled.store(true, std::memory_order_release);
+        }
+
+        /// @brief Checks the cancellation flag.
+        /// @return True if the state was cancelled.
+        bool isCancelled() const {
+            return this->m_fIsCancelled.load(std::memory_order_acquire);
+        }
+
+    private:
+        /// @var std::atomic<size_t> m_nReferences
+        /// @brief The number of sources and tokens referencing the state.
+        std::atomic<size_t> m_nReferences;
+
+        /// @var std::atomic<bool> m_fIsCancelled
+        /// @brief Whether the source was cancelled.
+        std::atomic<bool> m_fIsCancelled;
+    };
+
+    /// @class Devel::Threading::CCancellationToken
+    /// @brief A cheap, copyable handle a task polls to find out that its result is no longer wanted.
+    ///
+    /// A token is cancelled when its CCancellationSource is cancelled or when its deadline has passed.
+    /// A default constructed token is never cancelled, a token with only a deadline needs no source and does not
+    /// allocate. Checking a token is an atomic load, plus a clock read if it has a deadline.
+    ///
+    /// CThreadPool::addTask() and CThreadPool::submit() accept a token, tasks whose token is cancelled when a worker
+    /// picks them up are dropped without running, see CThreadPoolMetrics::droppedCount().
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     // The client waits at most 50ms for the answer
+    ///     Devel::Threading::CCancellationSource source;
+    ///     Devel::Threading::CCancellationToken token = source.token().withTimeout(std::chrono::milliseconds(50));
+    ///
+    ///     pool.addTask([token]() {
+    ///         for (Chunk &chunk: chunks) {
+    ///             if (token.isCancelled()) {
+    ///                 return;
+    ///             }
+    ///             process(chunk);
+    ///         }
+    ///     }, token);
+    ///
+    ///     // The client disconnected, queued tasks are dropped and running tasks stop at their next check
+    ///     source.cancel();
+    /// @endcode
+    class CCancellationToken {
+    public:
+        /// @typedef Clock
+        /// @brief The clock of the deadlines.
+        typedef std::chrono::steady_clock Clock;
+
+        /// @typedef TimePoint
+        /// @brief The time point type of the deadlines.
+        typedef Clock::time_point TimePoint;
+
+        /// @typedef Duration
+        /// @brief The duration type of the timeouts.
+        typedef Clock::duration Duration;
+
+    public:
+        /// @brief Constructs a token which is never cancelled.
+        CCancellationToken()
+                : m_pState(nullptr), m_tDeadline(TimePoint::max()) {
+        }
+
+        /// @brief Constructs a token of a cancellation state.
+        /// @param i_pState The state, referenced by the token, or nullptr.
+        /// @param i_tDeadline The deadline, TimePoint::max() for none.
+        CCancellationToken(CCancellationState *i_pState, const TimePoint i_tDeadline)
+                : m_pState(i_pState), m_tDeadline(i_tDeadline) {
+            if (this->m_pState) {
+                this->m_pState->addReference();
+            }
+        }
+
+        /// @brief Copy constructor, references the same state.
+        /// @param i_oOther The token to copy.
+        CCancellationToken(const CCancellationToken &i_oOther)
+                : CCancellationToken(i_oOther.m_pState, i_oOther.m_tDeadline) {
+        }
+
+        /// @brief Move constructor.
+        /// @param i_oOther The token to move.
+        CCancellationToken(CCancellationToken &&i_oOther) noexcept
+                : m_pState(std::exchange(i_oOther.m_pState, nullptr)), m_tDeadline(i_oOther.m_tDeadline) {
+        }
+
+        /// @brief Destructor, releases the state.
+        ~CCancellationToken() {
+            if (this->m_pState) {
+                this->m_pState->release();
+            }
+        }
+
+        /// @brief Assignment operator.
+        /// @param i_oOther The token to assign.
+        /// @return This token.
+        CCancellationToken &operator=(CCancellationToken i_oOther) noexcept {
+            std::swap(this->m_pState, i_oOther.m_pState);
+            this->m_tDeadline = i_oOther.m_tDeadline;
+            return *this;
+        }
+
+    public:
+        /// @brief Creates a token which is only cancelled by a deadline.
+        /// @param i_tDeadline The deadline.
+        /// @return The token.
+        static CCancellationToken deadline(const TimePoint i_tDeadline) {
+            return CCancellationToken(nullptr, i_tDeadline);
+        }
+
+        /// @brief Creates a token which is only cancelled by a timeout.
+        /// @param i_oTimeout The timeout, starting now.
+        /// @return The token.
+        static CCancellationToken timeout(const Duration i_oTimeout) {
+            return CCancellationToken::deadline(Clock::now() + i_oTimeout);
+        }
+
+        /// @brief Returns a copy of the token with a deadline, an earlier deadline of the token is kept.
+        /// @param i_tDeadline The deadline.
+        /// @return The token.
+        CCancellationToken withDeadline(const TimePoint i_tDeadline) const {
+            return CCancellationToken(this->m_pState, std::min(this->m_tDeadline, i_tDeadline));
+        }
+
+        /// @brief Returns a copy of the token with a timeout, an earlier deadline of the token is kept.
+        /// @param i_oTimeout The timeout, starting now.
+        /// @return The token.
+        CCancellationToken withTimeout(const Duration i_oTimeout) const {
+            return this->withDeadline(Clock::now() + i_oTimeout);
+        }
+
+        /// @brief Throws TaskCancelledException if the token is cancelled.
+        /// Inside a task added with CThreadPool::submit() the exception ends up in the future.
+        void throwIfCancelled() const {
+            if (this->isCancelled()) {
+                throw TaskCancelledException;
+            }
+        }
+
+    public:
+        /// @brief Checks if the source was cancelled or the deadline has passed.
+        /// @return True if the work guarded by the token should stop.
+        bool isCancelled() const {
+            return (this->m_pState && this->m_pState->isCancelled()) || this->hasExpired();
+        }
+
+        /// @brief Checks if the deadline has passed.
+        /// @return True if the token has a deadline in the past.
+        bool hasExpired() const {
+            return this->m_tDeadline != TimePoint::max() && Clock::now() >= this->m_tDeadline;
+        }
+
+        /// @brief Checks if the token can become cancelled at all.
+        /// @return True if the token has a source or a deadline.
+        bool canBeCancelled() const {
+            return this->m_pState || this->m_tDeadline != TimePoint::max();
+        }
+
+        /// @brief Returns the deadline of the token.
+        /// @return The deadline, TimePoint::max() if the token has none.
+        TimePoint deadline() const { return this->m_tDeadline; }
+
+    private:
+        /// @var CCancellationState *m_pState
+        /// @brief The state shared with the source, nullptr if the token has no source.
+        CCancellationState *m_pState;
+
+        /// @var TimePoint m_tDeadline
+        /// @brief The deadline, TimePoint::max() if the token has none.
+        TimePoint m_tDeadline;
+    };
+
+    /// @class Devel::Threading::CCancellationSource
+    /// @brief The owner side of a cancellation, it hands out tokens and cancels all of them at once.
+    ///
+    /// Copies of a source share the same state. Cancelling is a single atomic store, cancelled sources stay
+    /// cancelled.
+    class CCancellationSource {
+    public:
+        /// @brief Constructs a source which is not cancelled.
+        CCancellationSource()
+                : m_pState(new CCancellationState()) {
+        }
+
+        /// @brief Copy constructor, shares the state.
+        /// @param i_oOther The source to copy.
+        CCancellationSource(const CCancellationSource &i_oOther)
+                : m_pState(i_oOther.m_pState) {
+            this->m_pState->addReference();
+        }
+
+        /// @brief Destructor, releases the state. The tokens of the source stay valid.
+        ~CCancellationSource() {
+            this->m_pState->release();
+        }
+
+        /// @brief Deleted copy assignment operator.
+        CCancellationSource &operator=(const CCancellationSource &) = delete;
+
+    public:
+        /// @brief Cancels every token of the source.
+        void cancel() {
+            this->m_pState->cancel();
+        }
+
+        /// @brief Returns a token of the source without a deadline.
+        /// @return The token.
+        CCancellationToken token() const {
+            return CCancellationToken(this->m_pState, CCancellationToken::TimePoint::max());
+        }
+
+    public:
+        /// @brief Checks if the source was cancelled.
+        /// @return True if cancel() was called.
+        bool isCancelled() const { return this->m_pState->isCancelled(); }
+
+    private:
+        /// @var CCancellationState *m_pState
+        /// @brief The state shared with the tokens.
+        CCancellationState *m_pState;
+    };
+}
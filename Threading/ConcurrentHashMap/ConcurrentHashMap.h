@@ -0,0 +1,315 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "Threading/LockGuard/LockGuard.h"
+#include "Threading/SharedMutex/SharedMutex.h"
+#include "Core/Exceptions.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CConcurrentHashMap<K, V, Hash, TLock, ShardCount>
+    /// @brief A thread-safe hash map split into lock-striped shards.
+    ///
+    /// Every key belongs to one of ShardCount shards, each shard is a std::unordered_map with its own lock on its
+    /// own cache line. Operations on different shards never contend, lookups are O(1) instead of the linear scan
+    /// of CMutexVector. With the default CSharedMutex concurrent lookups on the same shard do not block each other.
+    ///
+    /// Values are returned by copy, since a reference would outlive the shard lock. update() and findOrInsert()
+    /// run under the shard lock, so read-modify-write sequences are atomic per key. The callbacks must not access
+    /// the map again.
+    ///
+    /// Iteration is consistent per shard: forEach() and forEachShard() hold the lock of one shard at a time.
+    ///
+    /// @tparam K The key type.
+    /// @tparam V The value type.
+    /// @tparam Hash The hash function of the keys.
+    /// @tparam TLock The lock type of a shard, e.g. CSharedMutex, CFutexMutex or CSpinLock.
+    /// @tparam ShardCount The number of shards, must be a power of two.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CConcurrentHashMap<uint64_t, CSession> sessions;
+    ///
+    ///     // Creates the session on first use
+    ///     CSession session = sessions.findOrInsert(nSessionId, [&]() { return CSession(nSessionId); });
+    ///
+    ///     // Atomic update of a single entry
+    ///     sessions.update(nSessionId, [](CSession &session) { session.touch(); });
+    ///
+    ///     sessions.erase(nSessionId);
+    /// @endcode
+    template<typename K, typename V, typename Hash = std::hash<K>, typename TLock = CSharedMutex, size_t ShardCount = 64>
+    class CConcurrentHashMap {
+        static_assert(ShardCount > 0 && (ShardCount & (ShardCount - 1)) == 0, "The shard count must be a power of two");
+
+    public:
+        /// @typedef Map
+        /// @brief The map type of a single shard.
+        typedef std::unordered_map<K, V, Hash> Map;
+
+    private:
+        /// @class CShard
+        /// @brief A shard, its lock and map on a separate cache line.
+        class alignas(64) CShard {
+        public:
+            /// @var TLock m_oMutex
+            /// @brief The lock of the shard.
+            TLock m_oMutex;
+
+            /// @var Map m_aoMap
+            /// @brief The entries of the shard.
+            Map m_aoMap;
+        };
+
+    public:
+        /// @brief Constructs an empty map.
+        CConcurrentHashMap() = default;
+
+        /// @brief Deleted copy constructor.
+        CConcurrentHashMap(const CConcurrentHashMap &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CConcurrentHashMap &operator=(const CConcurrentHashMap &) = delete;
+
+    public:
+        /// @brief Returns the number of shards.
+        /// @return The shard count.
+        static constexpr size_t shardCount() { return ShardCount; }
+
+        /// @brief Returns the shard a key belongs to.
+        /// @param i_tKey The key.
+        /// @return The shard index.
+        size_t shardOf(const K &i_tKey) const {
+            // Fibonacci hashing, the shard is taken from the high bits so it is independent of the bucket
+            // the std::unordered_map of the shard takes from the low bits
+            const uint64_t nHash = static_cast<uint64_t>(this->m_oHash(i_tKey)) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(nHash >> 32) & (ShardCount - 1);
+        }
+
+        /// @brief Returns the number of entries. The shards are counted one after another.
+        /// @return The number of entries.
+        size_t size() const {
+            size_t nSize = 0;
+            for (const CShard &oShard: this->m_aoShards) {
+                SharedLockGuard(oShard.m_oMutex);
+                nSize += oShard.m_aoMap.size();
+            }
+
+            return nSize;
+        }
+
+        /// @brief Checks if the map is empty.
+        /// @return True if the map is empty, false otherwise.
+        bool isEmpty() const {
+            return this->size() == 0;
+        }
+
+        /// @brief Checks if the map contains a key.
+        /// @param i_tKey The key.
+        /// @return True if the key exists, false otherwise.
+        bool contains(const K &i_tKey) const {
+            const CShard &oShard = this->shard(i_tKey);
+            SharedLockGuard(oShard.m_oMutex);
+            return oShard.m_aoMap.find(i_tKey) != oShard.m_aoMap.end();
+        }
+
+    public:
+        /// @brief Looks up the value of a key.
+        /// @param i_tKey The key.
+        /// @param i_tOutValue Receives a copy of the value on success.
+        /// @return True if the key exists, false otherwise.
+        bool tryGet(const K &i_tKey, V &i_tOutValue) const {
+            const CShard &oShard = this->shard(i_tKey);
+            SharedLockGuard(oShard.m_oMutex);
+
+            const auto it = oShard.m_aoMap.find(i_tKey);
+            if (it == oShard.m_aoMap.end()) {
+                return false;
+            }
+
+            i_tOutValue = it->second;
+            return true;
+        }
+
+        /// @brief Returns a copy of the value of a key.
+        /// @param i_tKey The key.
+        /// @return The value.
+        /// @throws NoEntryFoundException if the key does not exist.
+        V find(const K &i_tKey) const {
+            const CShard &oShard = this->shard(i_tKey);
+            SharedLockGuard(oShard.m_oMutex);
+
+            const auto it = oShard.m_aoMap.find(i_tKey);
+            if (it == oShard.m_aoMap.end()) {
+                throw NoEntryFoundException;
+            }
+
+            return it->second;
+        }
+
+        /// @brief Returns the value of a key, inserting the value created by a function if the key does not exist.
+        /// The function is called under the shard lock and only if the key is missing.
+        /// @param i_tKey The key.
+        /// @param i_fnCreate The function returning the value to insert.
+        /// @return A copy of the existing or inserted value.
+        template<typename F>
+        V findOrInsert(const K &i_tKey, F &&i_fnCreate) {
+            CShard &oShard = this->shard(i_tKey);
+            {
+                SharedLockGuard(oShard.m_oMutex);
+                const auto it = oShard.m_aoMap.find(i_tKey);
+                if (it != oShard.m_aoMap.end()) {
+                    return it->second;
+                }
+            }
+
+            RecursiveLockGuard(oShard.m_oMutex);
+            auto it = oShard.m_aoMap.find(i_tKey);
+            if (it == oShard.m_aoMap.end()) {
+                it = oShard.m_aoMap.emplace(i_tKey, std::forward<F>(i_fnCreate)()).first;
+            }
+
+            return it->second;
+        }
+
+        /// @brief Inserts a value if the key does not exist.
+        /// @param i_tKey The key.
+        /// @param i_tValue The value.
+        /// @return True if the value was inserted, false if the key already existed.
+        bool insert(const K &i_tKey, V i_tValue) {
+            CShard &oShard = this->shard(i_tKey);
+            RecursiveLockGuard(oShard.m_oMutex);
+            return oShard.m_aoMap.try_emplace(i_tKey, std::move(i_tValue)).second;
+        }
+
+        /// @brief Inserts a value or replaces the value of an existing key.
+        /// @param i_tKey The key.
+        /// @param i_tValue The value.
+        /// @return True if the value was inserted, false if an existing value was replaced.
+        bool insertOrAssign(const K &i_tKey, V i_tValue) {
+            CShard &oShard = this->shard(i_tKey);
+            RecursiveLockGuard(oShard.m_oMutex);
+            return oShard.m_aoMap.insert_or_assign(i_tKey, std::move(i_tValue)).second;
+        }
+
+        /// @brief Modifies the value of a key in place under the shard lock.
+        /// @param i_tKey The key.
+        /// @param i_fnUpdate The function receiving a reference to the value.
+        /// @return True if the key exists and the function was called, false otherwise.
+        template<typename F>
+        bool update(const K &i_tKey, F &&i_fnUpdate) {
+            CShard &oShard = this->shard(i_tKey);
+            RecursiveLockGuard(oShard.m_oMutex);
+
+            const auto it = oShard.m_aoMap.find(i_tKey);
+            if (it == oShard.m_aoMap.end()) {
+                return false;
+            }
+
+            std::forward<F>(i_fnUpdate)(it->second);
+            return true;
+        }
+
+    public:
+        /// @brief Removes a key.
+        /// @param i_tKey The key.
+        /// @return True if the key was removed, false if it did not exist.
+        bool erase(const K &i_tKey) {
+            CShard &oShard = this->shard(i_tKey);
+            RecursiveLockGuard(oShard.m_oMutex);
+            return oShard.m_aoMap.erase(i_tKey) != 0;
+        }
+
+        /// @brief Removes all entries matching a predicate, one shard at a time.
+        /// @param i_fnMatch The predicate receiving the key and the value.
+        /// @return The number of removed entries.
+        template<typename F>
+        size_t eraseIf(F &&i_fnMatch) {
+            size_t nCount = 0;
+            for (CShard &oShard: this->m_aoShards) {
+                RecursiveLockGuard(oShard.m_oMutex);
+                nCount += std::erase_if(oShard.m_aoMap, [&i_fnMatch](const auto &i_oEntry) {
+                    return i_fnMatch(i_oEntry.first, i_oEntry.second);
+                });
+            }
+
+            return nCount;
+        }
+
+        /// @brief Removes all entries.
+        void clear() {
+            for (CShard &oShard: this->m_aoShards) {
+                Map aoMap;
+                {
+                    RecursiveLockGuard(oShard.m_oMutex);
+                    aoMap.swap(oShard.m_aoMap);
+                }
+            }
+        }
+
+        /// @brief Reserves buckets for the given total number of entries, spread over the shards.
+        /// @param i_nCount The expected number of entries.
+        void reserve(const size_t i_nCount) {
+            const size_t nPerShard = (i_nCount + ShardCount - 1) / ShardCount;
+            for (CShard &oShard: this->m_aoShards) {
+                RecursiveLockGuard(oShard.m_oMutex);
+                oShard.m_aoMap.reserve(nPerShard);
+            }
+        }
+
+    public:
+        /// @brief Calls a function for every entry. Each shard is visited under its shared lock,
+        /// so the entries of one shard are a consistent snapshot.
+        /// @param i_fnVisit The function receiving the key and the value.
+        template<typename F>
+        void forEach(F &&i_fnVisit) const {
+            for (const CShard &oShard: this->m_aoShards) {
+                SharedLockGuard(oShard.m_oMutex);
+                for (const auto &[tKey, tValue]: oShard.m_aoMap) {
+                    i_fnVisit(tKey, tValue);
+                }
+            }
+        }
+
+        /// @brief Calls a function with the map of every shard under its shared lock.
+        /// @param i_fnVisit The function receiving the shard index and a const reference to the shard map.
+        template<typename F>
+        void forEachShard(F &&i_fnVisit) const {
+            for (size_t i = 0; i < ShardCount; i++) {
+                SharedLockGuard(this->m_aoShards[i].m_oMutex);
+                i_fnVisit(i, static_cast<const Map &>(this->m_aoShards[i].m_aoMap));
+            }
+        }
+
+    private:
+        /// @brief Returns the shard of a key.
+        /// @param i_tKey The key.
+        /// @return The shard.
+        CShard &shard(const K &i_tKey) {
+            return this->m_aoShards[this->shardOf(i_tKey)];
+        }
+
+        /// @brief Returns the shard of a key.
+        /// @param i_tKey The key.
+        /// @return The shard.
+        const CShard &shard(const K &i_tKey) const {
+            return this->m_aoShards[this->shardOf(i_tKey)];
+        }
+
+    private:
+        /// @var std::array<CShard, ShardCount> m_aoShards
+        /// @brief The shards.
+        std::array<CShard, ShardCount> m_aoShards;
+
+        /// @var Hash m_oHash
+        /// @brief The hash function.
+        Hash m_oHash;
+    };
+}
@@ -0,0 +1,131 @@
+#include "CpuTopology.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include "Core/Exceptions.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+Devel::Threading::CCpuTopology::CCpuTopology()
+        : CCpuTopology("/sys/devices/system/node") {
+}
+
+Devel::Threading::CCpuTopology::CCpuTopology(const std::string &i_stNodePath) {
+    // Node ids may have gaps, the nodes are indexed in ascending id order
+    std::map<size_t, std::vector<size_t>> aanNodes;
+
+    std::error_code oError;
+    for (const auto &oEntry: std::filesystem::directory_iterator(i_stNodePath, oError)) {
+        const std::string stName = oEntry.path().filename().string();
+        if (stName.size() <= 4 || stName.compare(0, 4, "node") != 0 ||
+            !std::all_of(stName.begin() + 4, stName.end(), [](const char c) { return std::isdigit(c); })) {
+            continue;
+        }
+
+        std::ifstream oFile(oEntry.path() / "cpulist");
+        std::string stList;
+        if (std::getline(oFile, stList)) {
+            std::vector<size_t> anCpus = CCpuTopology::parseCpuList(stList);
+            if (!anCpus.empty()) {
+                aanNodes[std::stoul(stName.substr(4))] = std::move(anCpus);
+            }
+        }
+    }
+
+    for (auto &[nId, anCpus]: aanNodes) {
+        for (const size_t nCpu: anCpus) {
+            if (nCpu >= this->m_anCpuNode.size()) {
+                this->m_anCpuNode.resize(nCpu + 1, 0);
+            }
+            this->m_anCpuNode[nCpu] = this->m_aanNodeCpus.size();
+        }
+
+        this->m_nCpuCount += anCpus.size();
+        this->m_aanNodeCpus.push_back(std::move(anCpus));
+    }
+
+    if (this->m_aanNodeCpus.empty()) {
+        this->setDefaultNode();
+    }
+}
+
+std::vector<size_t> Devel::Threading::CCpuTopology::parseCpuList(const std::string &i_stList) {
+    std::vector<size_t> anCpus;
+    size_t nPos = 0;
+
+    while (nPos < i_stList.size()) {
+        size_t nEnd = i_stList.find(',', nPos);
+        if (nEnd == std::string::npos) {
+            nEnd = i_stList.size();
+        }
+
+        const std::string stRange = i_stList.substr(nPos, nEnd - nPos);
+        nPos = nEnd + 1;
+        if (stRange.empty() || !std::isdigit(stRange.front())) {
+            continue;
+        }
+
+        const size_t nDash = stRange.find('-');
+        const size_t nFirst = std::stoul(stRange);
+        const size_t nLast = (nDash == std::string::npos ? nFirst : std::stoul(stRange.substr(nDash + 1)));
+        for (size_t nCpu = nFirst; nCpu <= nLast; nCpu++) {
+            anCpus.push_back(nCpu);
+        }
+    }
+
+    std::sort(anCpus.begin(), anCpus.end());
+    anCpus.erase(std::unique(anCpus.begin(), anCpus.end()), anCpus.end());
+    return anCpus;
+}
+
+size_t Devel::Threading::CCpuTopology::currentCpu() {
+#ifdef __linux__
+    const int nCpu = sched_getcpu();
+    return nCpu < 0 ? 0 : static_cast<size_t>(nCpu);
+#else
+    return 0;
+#endif
+}
+
+const std::vector<size_t> &Devel::Threading::CCpuTopology::cpusOfNode(const size_t i_nNode) const {
+    if (i_nNode >= this->m_aanNodeCpus.size()) {
+        throw IndexOutOfRangeException;
+    }
+
+    return this->m_aanNodeCpus[i_nNode];
+}
+
+size_t Devel::Threading::CCpuTopology::nodeOfCpu(const size_t i_nCpu) const {
+    return i_nCpu < this->m_anCpuNode.size() ? this->m_anCpuNode[i_nCpu] : 0;
+}
+
+std::vector<size_t> Devel::Threading::CCpuTopology::cpus() const {
+    std::vector<size_t> anCpus;
+    anCpus.reserve(this->m_nCpuCount);
+
+    for (const std::vector<size_t> &anNodeCpus: this->m_aanNodeCpus) {
+        anCpus.insert(anCpus.end(), anNodeCpus.begin(), anNodeCpus.end());
+    }
+
+    return anCpus;
+}
+
+void Devel::Threading::CCpuTopology::setDefaultNode() {
+    const size_t nCpuCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    std::vector<size_t> anCpus(nCpuCount);
+    for (size_t i = 0; i < nCpuCount; i++) {
+        anCpus[i] = i;
+    }
+
+    this->m_anCpuNode.assign(nCpuCount, 0);
+    this->m_aanNodeCpus.assign(1, std::move(anCpus));
+    this->m_nCpuCount = nCpuCount;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Core/Singleton/Singleton.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CCpuTopology
+    /// @brief The NUMA topology of the machine, the CPUs of every NUMA node.
+    ///
+    /// On Linux the topology is read from /sys/devices/system/node. On other systems, or if the directory is
+    /// missing, the machine is treated as a single node owning all CPUs reported by std::thread.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     const Devel::Threading::CCpuTopology *pTopology = Devel::Threading::CCpuTopology::instance();
+    ///
+    ///     for (size_t i = 0; i < pTopology->nodeCount(); i++) {
+    ///         std::cout << "node " << i << ": " << pTopology->cpusOfNode(i).size() << " cpus" << std::endl;
+    ///     }
+    /// @endcode
+    class CCpuTopology : public CSingleton<CCpuTopology> {
+        friend class CSingleton<CCpuTopology>;
+
+    public:
+        /// @brief Reads the topology from a sysfs node directory, e.g. a copy of /sys/devices/system/node.
+        /// @param i_stNodePath The directory containing the node<N>/cpulist files.
+        explicit CCpuTopology(const std::string &i_stNodePath);
+
+    private:
+        /// @brief Reads the topology of the machine.
+        CCpuTopology();
+
+    public:
+        /// @brief Parses a kernel CPU list like "0-3,8,10-11".
+        /// @param i_stList The CPU list.
+        /// @return The CPU numbers in ascending order.
+        static std::vector<size_t> parseCpuList(const std::string &i_stList);
+
+        /// @brief Returns the CPU the calling thread is currently running on.
+        /// @return The CPU number, 0 if it can not be determined.
+        static size_t currentCpu();
+
+    public:
+        /// @brief Returns the number of NUMA nodes.
+        /// @return The node count, at least 1.
+        size_t nodeCount() const { return this->m_aanNodeCpus.size(); }
+
+        /// @brief Returns the number of CPUs of all nodes.
+        /// @return The CPU count, at least 1.
+        size_t cpuCount() const { return this->m_nCpuCount; }
+
+        /// @brief Returns the CPUs of a node.
+        /// @param i_nNode The node index.
+        /// @return The CPU numbers of the node.
+        /// @throws IndexOutOfRangeException if the node does not exist.
+        const std::vector<size_t> &cpusOfNode(size_t i_nNode) const;
+
+        /// @brief Returns the node a CPU belongs to.
+        /// @param i_nCpu The CPU number.
+        /// @return The node index, 0 for unknown CPUs.
+        size_t nodeOfCpu(size_t i_nCpu) const;
+
+        /// @brief Returns the node the calling thread is currently running on.
+        /// @return The node index.
+        size_t currentNode() const {
+            return this->nodeOfCpu(CCpuTopology::currentCpu());
+        }
+
+        /// @brief Returns the CPUs of all nodes, ordered by node.
+        /// @return The CPU numbers.
+        std::vector<size_t> cpus() const;
+
+    private:
+        /// @brief Replaces an empty topology by a single node owning all CPUs.
+        void setDefaultNode();
+
+    private:
+        /// @var std::vector<std::vector<size_t>> m_aanNodeCpus
+        /// @brief The CPUs of every node, indexed by node.
+        std::vector<std::vector<size_t>> m_aanNodeCpus;
+
+        /// @var std::vector<size_t> m_anCpuNode
+        /// @brief The node of every CPU, indexed by CPU number.
+        std::vector<size_t> m_anCpuNode;
+
+        /// @var size_t m_nCpuCount
+        /// @brief The number of CPUs of all nodes.
+        size_t m_nCpuCount = 0;
+    };
+}
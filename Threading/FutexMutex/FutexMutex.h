@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Threading/LockProfiler/ProfiledLock.h"
+#include "Threading/ThreadUtils.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CFutexMutex
+    /// @brief A plain, non-recursive mutex which parks waiting threads in the kernel.
+    ///
+    /// The mutex is a single 32-bit word with the states unlocked, locked and locked with waiters
+    /// (Ulrich Drepper, "Futexes Are Tricky"). An uncontended lock() and unlock() is a single atomic operation,
+    /// the kernel is only entered if a thread actually has to wait. A contended lock() spins a short while before
+    /// it parks. On Linux the futex system call is used directly, on other platforms C++20 atomic wait/notify.
+    ///
+    /// Unlike CMutex the mutex is not recursive, a thread must not lock it again while it already holds it.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CFutexMutex mutex;
+    ///     {
+    ///         RecursiveLockGuard(mutex);
+    ///         // Critical section
+    ///     }
+    ///
+    ///     // As lock policy of a container
+    ///     Devel::Threading::CSafeQueue<int, Devel::Threading::CFutexMutex> queue;
+    /// @endcode
+    class CFutexMutex : public CProfiledLock {
+    private:
+        /// @enum EState
+        /// @brief The states of the lock word.
+        enum EState : uint32_t {
+            EUnlocked = 0,      ///< The mutex is free.
+            ELocked = 1,        ///< The mutex is held, no thread waits.
+            EContended = 2,     ///< The mutex is held and threads may be parked on it.
+        };
+
+    public:
+        /// @var size_t SpinCount
+        /// @brief The number of attempts a contended lock() spins before the thread parks.
+        static constexpr size_t SpinCount = 100;
+
+    public:
+        /// @brief Default constructor for CFutexMutex.
+        CFutexMutex() = default;
+
+        /// @brief Deleted copy constructor.
+        CFutexMutex(const CFutexMutex &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CFutexMutex &operator=(const CFutexMutex &) = delete;
+
+    public:
+        /// @brief Locks the mutex. If the mutex is currently locked by another
+        /// thread, this call will block the calling thread until the mutex is unlocked.
+        void lock() const {
+            uint32_t nState = EUnlocked;
+            if (this->m_nState.compare_exchange_strong(nState, ELocked, std::memory_order_acquire,
+                                                       std::memory_order_relaxed)) {
+                return;
+            }
+
+            for (size_t i = 0; i < CFutexMutex::SpinCount && nState != EContended; i++) {
+                Utils::cpuRelax();
+
+                nState = EUnlocked;
+                if (this->m_nState.compare_exchange_weak(nState, ELocked, std::memory_order_acquire,
+                                                         std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+
+            // From now on the lock word announces waiters, so unlock() knows it has to wake one
+            while (this->m_nState.exchange(EContended, std::memory_order_acquire) != EUnlocked) {
+                this->wait();
+            }
+        }
+
+        /// @brief Unlocks the mutex and wakes one waiting thread if there is any.
+        void unlock() const {
+            if (this->m_nState.exchange(EUnlocked, std::memory_order_release) == EContended) {
+                this->wakeOne();
+            }
+        }
+
+        /// @brief Attempts to lock the mutex without blocking.
+        /// @return True if the mutex was successfully locked, false otherwise.
+        bool tryLock() const {
+            uint32_t nState = EUnlocked;
+            return this->m_nState.compare_exchange_strong(nState, ELocked, std::memory_order_acquire,
+                                                          std::memory_order_relaxed);
+        }
+
+    private:
+        /// @brief Parks the calling thread as long as the lock word is EContended.
+        void wait() const {
+#ifdef __linux__
+            syscall(SYS_futex, reinterpret_cast<uint32_t *>(&this->m_nState), FUTEX_WAIT_PRIVATE, EContended,
+                    nullptr, nullptr, 0);
+#else
+            this->m_nState.wait(EContended, std::memory_order_relaxed);
+#endif
+        }
+
+        /// @brief Wakes one thread parked on the lock word.
+        void wakeOne() const {
+#ifdef __linux__
+            syscall(SYS_futex, reinterpret_cast<uint32_t *>(&this->m_nState), FUTEX_WAKE_PRIVATE, 1,
+                    nullptr, nullptr, 0);
+#else
+            this->m_nState.notify_one();
+#endif
+        }
+
+    private:
+        /// @var std::atomic<uint32_t> m_nState
+        /// @brief The lock word, one of EState.
+        mutable std::atomic<uint32_t> m_nState = EUnlocked;
+
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "The futex word must be 32 bits");
+    };
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CInplaceTask<Capacity>
+    /// @brief A move-only `void()` callable wrapper which stores the callable in an inline buffer.
+    ///
+    /// Unlike std::function the task never allocates memory. The callable must fit into the inline buffer,
+    /// which is checked at compile time, and it must be nothrow move constructible. Larger state can be captured
+    /// through a pointer, e.g. a std::unique_ptr or std::shared_ptr.
+    ///
+    /// @tparam Capacity The size of the inline buffer in bytes.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     std::unique_ptr<int> pValue = std::make_unique<int>(42);
+    ///
+    ///     // Move-only captures are supported
+    ///     Devel::Threading::CInplaceTask<> task([pValue = std::move(pValue)]() {
+    ///         std::cout << *pValue << std::endl;
+    ///     });
+    ///
+    ///     task();
+    /// @endcode
+    template<size_t Capacity = 64>
+    class CInplaceTask {
+    private:
+        /// @enum EOperation
+        /// @brief An enumeration of the operations performed by the type-erased manager function.
+        enum EOperation {
+            EInvoke,            ///< Invoke the callable.
+            EMove,              ///< Move construct the callable into another buffer and destroy the source.
+            EDestroy,           ///< Destroy the callable.
+        };
+
+        /// @typedef FnManager
+        /// @brief The type-erased manager function of a stored callable.
+        typedef void (*FnManager)(EOperation, void *, void *);
+
+        /// @brief The manager function for a callable of type F.
+        /// @param i_eOperation The operation to perform.
+        /// @param i_pSelf The buffer holding the callable.
+        /// @param i_pOther The destination buffer for EMove.
+        template<typename F>
+        static void manage(const EOperation i_eOperation, void *i_pSelf, void *i_pOther) {
+            F *pFunction = std::launder(reinterpret_cast<F *>(i_pSelf));
+
+            switch (i_eOperation) {
+                case EInvoke:
+                    (*pFunction)();
+                    break;
+                case EMove:
+                    new(i_pOther) F(std::move(*pFunction));
+                    pFunction->~F();
+                    break;
+                case EDestroy:
+                    pFunction->~F();
+                    break;
+            }
+        }
+
+    public:
+        /// @brief Constructs an empty task.
+        CInplaceTask() noexcept
+                : m_fnManager(nullptr) {
+        }
+
+        /// @brief Constructs an empty task.
+        CInplaceTask(std::nullptr_t) noexcept
+                : CInplaceTask() {
+        }
+
+        /// @brief Constructs a task holding the given callable.
+        /// @param i_fnFunction The callable, it must fit into the inline buffer.
+        template<typename F, typename std::enable_if_t<!std::is_same_v<std::decay_t<F>, CInplaceTask> &&
+                                                       std::is_invocable_v<std::decay_t<F> &>> * = nullptr>
+        CInplaceTask(F &&i_fnFunction)
+                : m_fnManager(&CInplaceTask::manage<std::decay_t<F>>) {
+            typedef std::decay_t<F> TFunction;
+            static_assert(sizeof(TFunction) <= Capacity,
+                          "The callable does not fit into the inline buffer of CInplaceTask, capture less or capture a pointer");
+            static_assert(alignof(TFunction) <= alignof(std::max_align_t),
+                          "The callable is over-aligned for CInplaceTask");
+            static_assert(std::is_nothrow_move_constructible_v<TFunction>,
+                          "The callable of a CInplaceTask must be nothrow move constructible");
+
+            new(this->m_aBuffer) TFunction(std::forward<F>(i_fnFunction));
+        }
+
+        /// @brief Move constructor.
+        /// @param i_oOther The task to move.
+        CInplaceTask(CInplaceTask &&i_oOther) noexcept
+                : m_fnManager(i_oOther.m_fnManager) {
+            if (this->m_fnManager) {
+                this->m_fnManager(EMove, i_oOther.m_aBuffer, this->m_aBuffer);
+                i_oOther.m_fnManager = nullptr;
+            }
+        }
+
+        /// @brief Deleted copy constructor.
+        CInplaceTask(const CInplaceTask &) = delete;
+
+        /// @brief Destructor, destroys the callable.
+        ~CInplaceTask() {
+            this->reset();
+        }
+
+    public:
+        /// @brief Move assignment operator.
+        /// @param i_oOther The task to move.
+        /// @return A reference to this task.
+        CInplaceTask &operator=(CInplaceTask &&i_oOther) noexcept {
+            if (this != &i_oOther) {
+                this->reset();
+
+                if (i_oOther.m_fnManager) {
+                    i_oOther.m_fnManager(EMove, i_oOther.m_aBuffer, this->m_aBuffer);
+                    this->m_fnManager = std::exchange(i_oOther.m_fnManager, nullptr);
+                }
+            }
+
+            return *this;
+        }
+
+        /// @brief Deleted copy assignment operator.
+        CInplaceTask &operator=(const CInplaceTask &) = delete;
+
+        /// @brief Destroys the callable, the task is empty afterwards.
+        /// @return A reference to this task.
+        CInplaceTask &operator=(std::nullptr_t) noexcept {
+            this->reset();
+            return *this;
+        }
+
+        /// @brief Invokes the callable.
+        /// @throws std::bad_function_call if the task is empty.
+        void operator()() {
+            if (!this->m_fnManager) {
+                throw std::bad_function_call();
+            }
+
+            this->m_fnManager(EInvoke, this->m_aBuffer, nullptr);
+        }
+
+        /// @brief Checks if the task holds a callable.
+        /// @return True if the task is not empty.
+        explicit operator bool() const noexcept {
+            return this->m_fnManager != nullptr;
+        }
+
+    public:
+        /// @brief Destroys the callable, the task is empty afterwards.
+        void reset() noexcept {
+            if (this->m_fnManager) {
+                std::exchange(this->m_fnManager, nullptr)(EDestroy, this->m_aBuffer, nullptr);
+            }
+        }
+
+    private:
+        /// @var FnManager m_fnManager
+        /// @brief The manager function of the stored callable, nullptr if the task is empty.
+        FnManager m_fnManager;
+
+        /// @var unsigned char m_aBuffer[Capacity]
+        /// @brief The inline buffer holding the callable.
+        alignas(std::max_align_t) unsigned char m_aBuffer[Capacity];
+    };
+}
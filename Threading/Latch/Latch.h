@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CLatch
+    /// @brief A single-use counter that threads can block on until it has been counted down to zero.
+    ///
+    /// Waiting threads sleep on the counter through std::atomic::wait() and are only woken by the count down
+    /// which reaches zero, no thread polls the counter. Counting down is a single atomic decrement.
+    /// Once the latch is open it stays open, counting down below zero is not allowed.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CThreadPool pool(4);
+    ///     pool.execute();
+    ///
+    ///     Devel::Threading::CLatch latch(items.size());
+    ///     for (Item &item: items) {
+    ///         pool.addTask([&item, &latch]() {
+    ///             process(item);
+    ///             latch.countDown();
+    ///         });
+    ///     }
+    ///
+    ///     // Blocks until every item was processed
+    ///     latch.wait();
+    /// @endcode
+    class CLatch {
+    public:
+        /// @brief Constructs a latch.
+        /// @param i_nCount The number of count downs until the latch opens, 0 for an open latch.
+        explicit CLatch(const size_t i_nCount)
+                : m_nCount(i_nCount) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CLatch(const CLatch &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CLatch &operator=(const CLatch &) = delete;
+
+    public:
+        /// @brief Decrements the counter and wakes all waiting threads when it reaches zero.
+        /// @param i_nCount The value to subtract, at most the current count.
+        void countDown(const size_t i_nCount = 1) {
+            if (i_nCount != 0 && this->m_nCount.fetch_sub(i_nCount, std::memory_order_acq_rel) == i_nCount) {
+                this->m_nCount.notify_all();
+            }
+        }
+
+        /// @brief Blocks until the counter has reached zero.
+        void wait() const {
+            size_t nCount;
+            while ((nCount = this->m_nCount.load(std::memory_order_acquire)) != 0) {
+                this->m_nCount.wait(nCount, std::memory_order_acquire);
+            }
+        }
+
+        /// @brief Decrements the counter and blocks until it has reached zero.
+        /// @param i_nCount The value to subtract, at most the current count.
+        void arriveAndWait(const size_t i_nCount = 1) {
+            this->countDown(i_nCount);
+            this->wait();
+        }
+
+        /// @brief Checks if the counter has reached zero without blocking.
+        /// @return True if the latch is open.
+        bool tryWait() const {
+            return this->m_nCount.load(std::memory_order_acquire) == 0;
+        }
+
+    public:
+        /// @brief Returns the current value of the counter.
+        /// @return The number of count downs left.
+        size_t count() const { return this->m_nCount.load(std::memory_order_relaxed); }
+
+    private:
+        /// @var std::atomic<size_t> m_nCount
+        /// @brief The number of count downs left.
+        std::atomic<size_t> m_nCount;
+    };
+}
@@ -2,19 +2,46 @@
 
 #include "Core/Global.h"
 #include "Threading/Mutex/Mutex.h"
+#include "Threading/SharedMutex/SharedMutex.h"
+
+#ifdef DEVEL_LOCK_PROFILING
+#include <type_traits>
+
+#include "Threading/LockProfiler/ProfiledLock.h"
+#endif
+
 /// @namespace Devel::Threading
 /// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
 namespace Devel::Threading {
     /// @def RecursiveLockGuard(x)
     /// @brief Defines a lock guard for a recursive mutex.
     /// When this macro is used, it creates a lock guard object for the recursive mutex.
+    /// With DEVEL_LOCK_PROFILING defined, the acquisition is recorded for the mutex and the call site, see CLockProfiler.
     /// @param x The recursive mutex instance to lock.
+#ifdef DEVEL_LOCK_PROFILING
+#define RecursiveLockGuard(x)    CLockGuard CatUniqueVar(locker, __COUNTER__)(x, DEVEL_LOCK_SITE());
+#else
 #define RecursiveLockGuard(x)    CLockGuard CatUniqueVar(locker, __COUNTER__)(x);
+#endif
 
-    /// @class Devel::Threading::CLockGuard
-    /// @brief A lock guard class for a recursive mutex.
+    /// @def SharedLockGuard(x)
+    /// @brief Defines a shared lock guard for a reader/writer mutex.
+    /// When this macro is used, it creates a shared lock guard object for the mutex.
+    /// With DEVEL_LOCK_PROFILING defined, the acquisition is recorded for the mutex and the call site, see CLockProfiler.
+    /// @param x The mutex instance to lock shared.
+#ifdef DEVEL_LOCK_PROFILING
+#define SharedLockGuard(x)    CSharedLockGuard CatUniqueVar(locker, __COUNTER__)(x, DEVEL_LOCK_SITE());
+#else
+#define SharedLockGuard(x)    CSharedLockGuard CatUniqueVar(locker, __COUNTER__)(x);
+#endif
+
+    /// @class Devel::Threading::CLockGuard<TMutex>
+    /// @brief A lock guard class for a mutex.
+    ///
+    /// This class provides a convenient way to acquire and release the exclusive lock on a mutex.
+    /// The mutex type is deduced from the constructor argument, it must provide lock() and unlock().
     ///
-    /// This class provides a convenient way to acquire and release a lock on a recursive mutex.
+    /// @tparam TMutex The type of the guarded mutex.
     ///
     /// Example usage:
     /// @code{.cpp}
@@ -25,23 +52,185 @@ namespace Devel::Threading {
     ///         // The lock will be automatically released when the lock guard goes out of scope
     ///     }
     /// @endcode
+    template<typename TMutex = CMutex>
     class CLockGuard {
     public:
         /// @brief Constructs a CLockGuard and acquires the lock on the specified mutex.
-        /// @param i_oMutex The recursive mutex to lock.
-        CLockGuard(const CMutex &i_oMutex)
+        /// @param i_oMutex The mutex to lock.
+        CLockGuard(const TMutex &i_oMutex)
                 : m_oMutex(i_oMutex) {
             this->m_oMutex.lock();
         }
 
+#ifdef DEVEL_LOCK_PROFILING
+        /// @brief Constructs a CLockGuard, acquires the lock and records the acquisition for a call site.
+        /// @param i_oMutex The mutex to lock.
+        /// @param i_oSite The call site of the guard.
+        CLockGuard(const TMutex &i_oMutex, const CLockSite &i_oSite)
+                : m_oMutex(i_oMutex) {
+            if constexpr (std::is_base_of_v<CProfiledLock, TMutex>) {
+                this->m_pStats = &this->m_oMutex.lockStats();
+            }
+
+            if (!this->m_pStats) {
+                this->m_oMutex.lock();
+            } else if (this->m_oMutex.tryLock()) {
+                this->m_pSlot = this->m_pStats->recordAcquire(i_oSite, false, 0);
+                this->m_nAcquiredAt = CLockSite::now();
+            } else {
+                const uint64_t nStart = CLockSite::now();
+                this->m_oMutex.lock();
+                this->m_nAcquiredAt = CLockSite::now();
+                this->m_pSlot = this->m_pStats->recordAcquire(i_oSite, true, this->m_nAcquiredAt - nStart);
+            }
+        }
+#endif
+
+        /// @brief Deleted copy constructor.
+        CLockGuard(const CLockGuard &) = delete;
+
         /// @brief Destroys the CLockGuard and releases the lock on the mutex.
         ~CLockGuard() {
+#ifdef DEVEL_LOCK_PROFILING
+            if (this->m_pStats) {
+                this->m_pStats->recordRelease(this->m_pSlot, CLockSite::now() - this->m_nAcquiredAt);
+            }
+#endif
             this->m_oMutex.unlock();
         }
 
     private:
-        /// @var CMutex &m_oMutex
-        /// @brief The recursive mutex to guard.
-        const CMutex &m_oMutex;
+        /// @var TMutex &m_oMutex
+        /// @brief The mutex to guard.
+        const TMutex &m_oMutex;
+
+#ifdef DEVEL_LOCK_PROFILING
+        /// @var CLockStats *m_pStats
+        /// @brief The statistics of the mutex, nullptr if the guard or the mutex type is not profiled.
+        CLockStats *m_pStats = nullptr;
+
+        /// @var CLockSiteCounters *m_pSlot
+        /// @brief The counters of the call site, nullptr if the mutex has no slot left for it.
+        CLockSiteCounters *m_pSlot = nullptr;
+
+        /// @var uint64_t m_nAcquiredAt
+        /// @brief The time the lock was acquired in nanoseconds.
+        uint64_t m_nAcquiredAt = 0;
+#endif
+    };
+
+    /// @class Devel::Threading::CSharedLockGuard<TMutex>
+    /// @brief A lock guard class acquiring the shared lock of a reader/writer mutex.
+    ///
+    /// If the mutex type has no shared mode (lockShared() and unlockShared()), e.g. CMutex,
+    /// the guard falls back to the exclusive lock. Read-only code can therefore use the guard
+    /// regardless of the lock type it is instantiated with.
+    ///
+    /// @tparam TMutex The type of the guarded mutex.
+    ///
+    /// Example usage:
+    /// @code{.cpp}
+    ///     CSharedMutex mutex;
+    ///     {
+    ///         SharedLockGuard(mutex); // Other readers may enter concurrently
+    ///         // Read-only section
+    ///     }
+    /// @endcode
+    template<typename TMutex = CMutex>
+    class CSharedLockGuard {
+    public:
+        /// @brief Constructs a CSharedLockGuard and acquires the shared lock on the specified mutex.
+        /// @param i_oMutex The mutex to lock.
+        CSharedLockGuard(const TMutex &i_oMutex)
+                : m_oMutex(i_oMutex) {
+            this->lock();
+        }
+
+#ifdef DEVEL_LOCK_PROFILING
+        /// @brief Constructs a CSharedLockGuard, acquires the shared lock and records the acquisition for a call site.
+        /// @param i_oMutex The mutex to lock.
+        /// @param i_oSite The call site of the guard.
+        CSharedLockGuard(const TMutex &i_oMutex, const CLockSite &i_oSite)
+                : m_oMutex(i_oMutex) {
+            if constexpr (std::is_base_of_v<CProfiledLock, TMutex>) {
+                this->m_pStats = &this->m_oMutex.lockStats();
+            }
+
+            if (!this->m_pStats) {
+                this->lock();
+            } else if (this->tryLock()) {
+                this->m_pSlot = this->m_pStats->recordAcquire(i_oSite, false, 0);
+                this->m_nAcquiredAt = CLockSite::now();
+            } else {
+                const uint64_t nStart = CLockSite::now();
+                this->lock();
+                this->m_nAcquiredAt = CLockSite::now();
+                this->m_pSlot = this->m_pStats->recordAcquire(i_oSite, true, this->m_nAcquiredAt - nStart);
+            }
+        }
+#endif
+
+        /// @brief Deleted copy constructor.
+        CSharedLockGuard(const CSharedLockGuard &) = delete;
+
+        /// @brief Destroys the CSharedLockGuard and releases the shared lock on the mutex.
+        ~CSharedLockGuard() {
+#ifdef DEVEL_LOCK_PROFILING
+            if (this->m_pStats) {
+                this->m_pStats->recordRelease(this->m_pSlot, CLockSite::now() - this->m_nAcquiredAt);
+            }
+#endif
+            if constexpr (CSharedLockGuard::HasSharedMode) {
+                this->m_oMutex.unlockShared();
+            } else {
+                this->m_oMutex.unlock();
+            }
+        }
+
+    private:
+        /// @brief Acquires the shared lock, or the exclusive lock if the mutex has no shared mode.
+        void lock() {
+            if constexpr (CSharedLockGuard::HasSharedMode) {
+                this->m_oMutex.lockShared();
+            } else {
+                this->m_oMutex.lock();
+            }
+        }
+
+        /// @brief Attempts to acquire the shared lock, or the exclusive lock if the mutex has no shared mode.
+        /// @return True if the lock was acquired.
+        bool tryLock() {
+            if constexpr (CSharedLockGuard::HasSharedMode) {
+                return this->m_oMutex.tryLockShared();
+            } else {
+                return this->m_oMutex.tryLock();
+            }
+        }
+
+    private:
+        /// @var bool HasSharedMode
+        /// @brief True if the mutex type supports a shared lock.
+        static constexpr bool HasSharedMode = requires(const TMutex &i_oMutex) {
+            i_oMutex.lockShared();
+            i_oMutex.unlockShared();
+        };
+
+        /// @var TMutex &m_oMutex
+        /// @brief The mutex to guard.
+        const TMutex &m_oMutex;
+
+#ifdef DEVEL_LOCK_PROFILING
+        /// @var CLockStats *m_pStats
+        /// @brief The statistics of the mutex, nullptr if the guard or the mutex type is not profiled.
+        CLockStats *m_pStats = nullptr;
+
+        /// @var CLockSiteCounters *m_pSlot
+        /// @brief The counters of the call site, nullptr if the mutex has no slot left for it.
+        CLockSiteCounters *m_pSlot = nullptr;
+
+        /// @var uint64_t m_nAcquiredAt
+        /// @brief The time the lock was acquired in nanoseconds.
+        uint64_t m_nAcquiredAt = 0;
+#endif
     };
-}
\ No newline at end of file
+}
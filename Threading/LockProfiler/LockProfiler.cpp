@@ -0,0 +1,249 @@
+#include "LockProfiler.h"
+
+#include <algorithm>
+#include <iomanip>
+
+void Devel::Threading::CLockStats::reset() {
+    this->m_nAcquisitions.store(0, std::memory_order_relaxed);
+    this->m_nContended.store(0, std::memory_order_relaxed);
+    this->m_nWaitNs.store(0, std::memory_order_relaxed);
+    this->m_nHoldNs.store(0, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < LockHistogramBuckets; i++) {
+        this->m_anWaitHistogram[i].store(0, std::memory_order_relaxed);
+        this->m_anHoldHistogram[i].store(0, std::memory_order_relaxed);
+    }
+
+    for (CLockSiteCounters &oSlot: this->m_aoSites) {
+        oSlot.m_nAcquisitions.store(0, std::memory_order_relaxed);
+        oSlot.m_nContended.store(0, std::memory_order_relaxed);
+        oSlot.m_nWaitNs.store(0, std::memory_order_relaxed);
+        oSlot.m_nHoldNs.store(0, std::memory_order_relaxed);
+    }
+}
+
+Devel::Threading::CLockProfiler::~CLockProfiler() {
+    // Static locks may outlive the profiler, their statistics stay allocated until they are retired
+    CLockProfiler::s_fIsDestroyed.store(true, std::memory_order_release);
+}
+
+Devel::Threading::CLockStats *Devel::Threading::CLockProfiler::createStats() {
+    std::lock_guard<std::mutex> oLock(this->m_oMutex);
+    CLockStats *pStats = new CLockStats(this->m_nNextId++);
+    this->m_apStats.push_back(pStats);
+
+    return pStats;
+}
+
+void Devel::Threading::CLockProfiler::rename(CLockStats *i_pStats, std::string i_stName) {
+    std::lock_guard<std::mutex> oLock(this->m_oMutex);
+    i_pStats->m_stName = std::move(i_stName);
+}
+
+void Devel::Threading::CLockProfiler::retire(CLockStats *i_pStats) {
+    if (CLockProfiler::s_fIsDestroyed.load(std::memory_order_acquire)) {
+        delete i_pStats;
+        return;
+    }
+
+    CLockProfiler *pProfiler = CLockProfiler::instance();
+    {
+        std::lock_guard<std::mutex> oLock(pProfiler->m_oMutex);
+        if (i_pStats->m_nAcquisitions.load(std::memory_order_relaxed) != 0) {
+            const std::string stName = CLockProfiler::nameOf(*i_pStats, true);
+            CLockReport &oRetired = pProfiler->m_aoRetired[stName];
+            oRetired.m_stName = stName;
+            CLockProfiler::merge(CLockProfiler::snapshot(*i_pStats), oRetired);
+        }
+    }
+
+    pProfiler->discard(i_pStats);
+}
+
+void Devel::Threading::CLockProfiler::discard(CLockStats *i_pStats) {
+    {
+        std::lock_guard<std::mutex> oLock(this->m_oMutex);
+        this->m_apStats.erase(std::remove(this->m_apStats.begin(), this->m_apStats.end(), i_pStats),
+                              this->m_apStats.end());
+    }
+
+    delete i_pStats;
+}
+
+std::vector<Devel::Threading::CLockReport> Devel::Threading::CLockProfiler::report(const size_t i_nTopCount) const {
+    std::map<std::string, CLockReport> aoReports;
+
+    {
+        std::lock_guard<std::mutex> oLock(this->m_oMutex);
+        for (const CLockStats *pStats: this->m_apStats) {
+            if (pStats->m_nAcquisitions.load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+
+            const std::string stName = CLockProfiler::nameOf(*pStats, false);
+            CLockReport &oReport = aoReports[stName];
+            oReport.m_stName = stName;
+            CLockProfiler::merge(CLockProfiler::snapshot(*pStats), oReport);
+        }
+
+        for (const auto &[stName, oRetired]: this->m_aoRetired) {
+            CLockReport &oReport = aoReports[stName];
+            oReport.m_stName = stName;
+            CLockProfiler::merge(oRetired, oReport);
+        }
+    }
+
+    const auto fnIsHotter = [](const auto &i_oLeft, const auto &i_oRight) {
+        if (i_oLeft.m_nContended != i_oRight.m_nContended) {
+            return i_oLeft.m_nContended > i_oRight.m_nContended;
+        }
+        if (i_oLeft.m_nWaitNs != i_oRight.m_nWaitNs) {
+            return i_oLeft.m_nWaitNs > i_oRight.m_nWaitNs;
+        }
+        return i_oLeft.m_nAcquisitions > i_oRight.m_nAcquisitions;
+    };
+
+    std::vector<CLockReport> aoSorted;
+    aoSorted.reserve(aoReports.size());
+    for (auto &[stName, oReport]: aoReports) {
+        std::sort(oReport.m_aoSites.begin(), oReport.m_aoSites.end(), fnIsHotter);
+        aoSorted.push_back(std::move(oReport));
+    }
+
+    std::sort(aoSorted.begin(), aoSorted.end(), fnIsHotter);
+
+    if (i_nTopCount != 0 && aoSorted.size() > i_nTopCount) {
+        aoSorted.resize(i_nTopCount);
+    }
+
+    return aoSorted;
+}
+
+void Devel::Threading::CLockProfiler::dump(std::ostream &i_oStream, const size_t i_nTopCount) const {
+    const std::vector<CLockReport> aoReports = this->report(i_nTopCount);
+
+    if (!CLockProfiler::isEnabled()) {
+        i_oStream << "Lock profiling is disabled, compile with DEVEL_LOCK_PROFILING" << std::endl;
+        return;
+    }
+
+    const auto fnWriteLine = [&i_oStream](const std::string &i_stLabel, const auto &i_oCounters) {
+        const uint64_t nWaitAverage = i_oCounters.m_nContended ? i_oCounters.m_nWaitNs / i_oCounters.m_nContended : 0;
+        const uint64_t nHoldAverage =
+                i_oCounters.m_nAcquisitions ? i_oCounters.m_nHoldNs / i_oCounters.m_nAcquisitions : 0;
+
+        i_oStream << std::left << std::setw(56) << i_stLabel << std::right
+                  << std::setw(14) << i_oCounters.m_nAcquisitions << std::setw(12) << i_oCounters.m_nContended
+                  << std::setw(14) << nWaitAverage << std::setw(14) << nHoldAverage << std::endl;
+    };
+
+    i_oStream << std::left << std::setw(56) << "Lock / call site" << std::right
+              << std::setw(14) << "Acquisitions" << std::setw(12) << "Contended"
+              << std::setw(14) << "Wait avg ns" << std::setw(14) << "Hold avg ns" << std::endl;
+
+    for (const CLockReport &oReport: aoReports) {
+        fnWriteLine(oReport.m_stName, oReport);
+        for (const CLockSiteReport &oSite: oReport.m_aoSites) {
+            fnWriteLine("  " + oSite.m_stSite, oSite);
+        }
+    }
+}
+
+void Devel::Threading::CLockProfiler::reset() {
+    std::lock_guard<std::mutex> oLock(this->m_oMutex);
+    for (CLockStats *pStats: this->m_apStats) {
+        pStats->reset();
+    }
+    this->m_aoRetired.clear();
+}
+
+Devel::Threading::CLockReport Devel::Threading::CLockProfiler::snapshot(const CLockStats &i_oStats) {
+    CLockReport oReport;
+    oReport.m_nAcquisitions = i_oStats.m_nAcquisitions.load(std::memory_order_relaxed);
+    oReport.m_nContended = i_oStats.m_nContended.load(std::memory_order_relaxed);
+    oReport.m_nWaitNs = i_oStats.m_nWaitNs.load(std::memory_order_relaxed);
+    oReport.m_nHoldNs = i_oStats.m_nHoldNs.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < LockHistogramBuckets; i++) {
+        oReport.m_anWaitHistogram[i] = i_oStats.m_anWaitHistogram[i].load(std::memory_order_relaxed);
+        oReport.m_anHoldHistogram[i] = i_oStats.m_anHoldHistogram[i].load(std::memory_order_relaxed);
+    }
+
+    // The acquisitions of call sites without a slot are the remainder of the totals
+    CLockSiteReport oOther;
+    oOther.m_stSite = "(other call sites)";
+    oOther.m_nAcquisitions = oReport.m_nAcquisitions;
+    oOther.m_nContended = oReport.m_nContended;
+    oOther.m_nWaitNs = oReport.m_nWaitNs;
+    oOther.m_nHoldNs = oReport.m_nHoldNs;
+
+    for (const CLockSiteCounters &oSlot: i_oStats.m_aoSites) {
+        const CLockSite *pSite = oSlot.m_pSite.load(std::memory_order_acquire);
+        if (!pSite) {
+            break;
+        }
+
+        CLockSiteReport oSite;
+        oSite.m_stSite = pSite->toString();
+        oSite.m_nAcquisitions = oSlot.m_nAcquisitions.load(std::memory_order_relaxed);
+        oSite.m_nContended = oSlot.m_nContended.load(std::memory_order_relaxed);
+        oSite.m_nWaitNs = oSlot.m_nWaitNs.load(std::memory_order_relaxed);
+        oSite.m_nHoldNs = oSlot.m_nHoldNs.load(std::memory_order_relaxed);
+
+        // The counters are read one by one while the lock is in use, clamp the remainder at zero
+        oOther.m_nAcquisitions -= std::min(oOther.m_nAcquisitions, oSite.m_nAcquisitions);
+        oOther.m_nContended -= std::min(oOther.m_nContended, oSite.m_nContended);
+        oOther.m_nWaitNs -= std::min(oOther.m_nWaitNs, oSite.m_nWaitNs);
+        oOther.m_nHoldNs -= std::min(oOther.m_nHoldNs, oSite.m_nHoldNs);
+        oReport.m_aoSites.push_back(std::move(oSite));
+    }
+
+    if (oOther.m_nAcquisitions != 0 && oReport.m_aoSites.size() == LockSiteSlots) {
+        oReport.m_aoSites.push_back(std::move(oOther));
+    }
+
+    return oReport;
+}
+
+void Devel::Threading::CLockProfiler::merge(const CLockReport &i_oSource, CLockReport &i_oTarget) {
+    i_oTarget.m_nAcquisitions += i_oSource.m_nAcquisitions;
+    i_oTarget.m_nContended += i_oSource.m_nContended;
+    i_oTarget.m_nWaitNs += i_oSource.m_nWaitNs;
+    i_oTarget.m_nHoldNs += i_oSource.m_nHoldNs;
+
+    for (size_t i = 0; i < LockHistogramBuckets; i++) {
+        i_oTarget.m_anWaitHistogram[i] += i_oSource.m_anWaitHistogram[i];
+        i_oTarget.m_anHoldHistogram[i] += i_oSource.m_anHoldHistogram[i];
+    }
+
+    for (const CLockSiteReport &oSource: i_oSource.m_aoSites) {
+        auto it = std::find_if(i_oTarget.m_aoSites.begin(), i_oTarget.m_aoSites.end(),
+                               [&oSource](const CLockSiteReport &i_oSite) {
+                                   return i_oSite.m_stSite == oSource.m_stSite;
+                               });
+        if (it == i_oTarget.m_aoSites.end()) {
+            i_oTarget.m_aoSites.push_back(oSource);
+            continue;
+        }
+
+        it->m_nAcquisitions += oSource.m_nAcquisitions;
+        it->m_nContended += oSource.m_nContended;
+        it->m_nWaitNs += oSource.m_nWaitNs;
+        it->m_nHoldNs += oSource.m_nHoldNs;
+    }
+}
+
+std::string Devel::Threading::CLockProfiler::nameOf(const CLockStats &i_oStats, const bool i_fIsRetired) {
+    if (!i_oStats.m_stName.empty()) {
+        return i_oStats.m_stName;
+    }
+
+    // Unnamed locks are called after the first call site, destroyed ones are merged by it
+    const CLockSite *pSite = i_oStats.m_aoSites.front().m_pSite.load(std::memory_order_acquire);
+    const std::string stSite = pSite ? pSite->toString() : std::string("(unknown call site)");
+    if (i_fIsRetired) {
+        return stSite + " (destroyed)";
+    }
+
+    return stSite + " #" + std::to_string(i_oStats.m_nId);
+}
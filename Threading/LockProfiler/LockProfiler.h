@@ -0,0 +1,407 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Core/Singleton/Singleton.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @var size_t LockHistogramBuckets
+    /// @brief The number of buckets of the wait and hold time histograms.
+    /// Bucket i counts durations in [2^i, 2^(i+1)) nanoseconds, the last bucket is open-ended.
+    inline constexpr size_t LockHistogramBuckets = 32;
+
+    /// @var size_t LockSiteSlots
+    /// @brief The number of call sites a lock breaks its statistics down by.
+    /// Acquisitions from further call sites only count towards the totals of the lock.
+    inline constexpr size_t LockSiteSlots = 8;
+
+    /// @typedef LockHistogram
+    /// @brief A snapshot of a wait or hold time histogram.
+    typedef std::array<uint64_t, LockHistogramBuckets> LockHistogram;
+
+    /// @class Devel::Threading::CLockSite
+    /// @brief The source location of a lock guard.
+    ///
+    /// With DEVEL_LOCK_PROFILING defined, every RecursiveLockGuard and SharedLockGuard expansion owns a static
+    /// CLockSite, see DEVEL_LOCK_SITE(). The statistics are kept by the lock, see CLockStats.
+    class CLockSite {
+    public:
+        /// @brief Constructs a call site.
+        /// @param i_szFile The source file of the call site.
+        /// @param i_nLine The source line of the call site.
+        constexpr CLockSite(const char *i_szFile, const uint32_t i_nLine)
+                : m_szFile(i_szFile), m_nLine(i_nLine) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CLockSite(const CLockSite &) = delete;
+
+    public:
+        /// @brief Returns the call site as "file:line".
+        /// @return The call site.
+        std::string toString() const {
+            return std::string(this->m_szFile) + ':' + std::to_string(this->m_nLine);
+        }
+
+    public:
+        /// @brief Returns the current time for the duration measurements.
+        /// @return The current time in nanoseconds.
+        static uint64_t now() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /// @brief Returns the histogram bucket of a duration.
+        /// @param i_nNs The duration in nanoseconds.
+        /// @return The bucket index.
+        static size_t bucket(const uint64_t i_nNs) {
+            const size_t nBucket = i_nNs ? static_cast<size_t>(std::bit_width(i_nNs)) - 1 : 0;
+            return nBucket < LockHistogramBuckets ? nBucket : LockHistogramBuckets - 1;
+        }
+
+    private:
+        /// @var const char *m_szFile
+        /// @brief The source file of the call site.
+        const char *m_szFile;
+
+        /// @var uint32_t m_nLine
+        /// @brief The source line of the call site.
+        uint32_t m_nLine;
+    };
+
+    /// @class Devel::Threading::CLockSiteCounters
+    /// @brief The counters of one lock at one call site. All counters are relaxed atomics.
+    class CLockSiteCounters {
+    public:
+        /// @var std::atomic<const CLockSite *> m_pSite
+        /// @brief The call site owning the slot, nullptr while the slot is free.
+        std::atomic<const CLockSite *> m_pSite = nullptr;
+
+        /// @var std::atomic<uint64_t> m_nAcquisitions
+        /// @brief The number of acquisitions.
+        std::atomic<uint64_t> m_nAcquisitions = 0;
+
+        /// @var std::atomic<uint64_t> m_nContended
+        /// @brief The number of acquisitions which had to wait.
+        std::atomic<uint64_t> m_nContended = 0;
+
+        /// @var std::atomic<uint64_t> m_nWaitNs
+        /// @brief The total wait time in nanoseconds.
+        std::atomic<uint64_t> m_nWaitNs = 0;
+
+        /// @var std::atomic<uint64_t> m_nHoldNs
+        /// @brief The total hold time in nanoseconds.
+        std::atomic<uint64_t> m_nHoldNs = 0;
+    };
+
+    /// @class Devel::Threading::CLockStats
+    /// @brief The statistics of a single lock, broken down by call site.
+    ///
+    /// A lock allocates its statistics on the first profiled acquisition and registers them with the
+    /// CLockProfiler, see CProfiledLock. All counters are relaxed atomics.
+    class CLockStats {
+        friend class CLockProfiler;
+
+    public:
+        /// @brief Constructs the statistics of a lock.
+        /// @param i_nId The sequence number of the lock, used to tell unnamed locks apart.
+        explicit CLockStats(const uint64_t i_nId)
+                : m_nId(i_nId) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CLockStats(const CLockStats &) = delete;
+
+    public:
+        /// @brief Records an acquisition.
+        /// @param i_oSite The call site of the lock guard.
+        /// @param i_fContended True if the lock was held by another thread.
+        /// @param i_nWaitNs The time spent waiting for the lock in nanoseconds.
+        /// @return The counters of the call site, nullptr if all slots are taken by other call sites.
+        CLockSiteCounters *recordAcquire(const CLockSite &i_oSite, const bool i_fContended, const uint64_t i_nWaitNs) {
+            this->m_nAcquisitions.fetch_add(1, std::memory_order_relaxed);
+            if (i_fContended) {
+                this->m_nContended.fetch_add(1, std::memory_order_relaxed);
+                this->m_nWaitNs.fetch_add(i_nWaitNs, std::memory_order_relaxed);
+                this->m_anWaitHistogram[CLockSite::bucket(i_nWaitNs)].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            CLockSiteCounters *pSlot = this->slot(i_oSite);
+            if (pSlot) {
+                pSlot->m_nAcquisitions.fetch_add(1, std::memory_order_relaxed);
+                if (i_fContended) {
+                    pSlot->m_nContended.fetch_add(1, std::memory_order_relaxed);
+                    pSlot->m_nWaitNs.fetch_add(i_nWaitNs, std::memory_order_relaxed);
+                }
+            }
+
+            return pSlot;
+        }
+
+        /// @brief Records the release of a lock.
+        /// @param i_pSlot The counters returned by recordAcquire(), may be nullptr.
+        /// @param i_nHoldNs The time the lock was held in nanoseconds.
+        void recordRelease(CLockSiteCounters *i_pSlot, const uint64_t i_nHoldNs) {
+            this->m_nHoldNs.fetch_add(i_nHoldNs, std::memory_order_relaxed);
+            this->m_anHoldHistogram[CLockSite::bucket(i_nHoldNs)].fetch_add(1, std::memory_order_relaxed);
+
+            if (i_pSlot) {
+                i_pSlot->m_nHoldNs.fetch_add(i_nHoldNs, std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Resets all counters, the call site slots stay assigned.
+        void reset();
+
+    private:
+        /// @brief Returns the counters of a call site, claiming a free slot for a new call site.
+        /// @param i_oSite The call site.
+        /// @return The counters, nullptr if all slots are taken by other call sites.
+        CLockSiteCounters *slot(const CLockSite &i_oSite) {
+            for (CLockSiteCounters &oSlot: this->m_aoSites) {
+                const CLockSite *pSite = oSlot.m_pSite.load(std::memory_order_acquire);
+                if (pSite == nullptr &&
+                    oSlot.m_pSite.compare_exchange_strong(pSite, &i_oSite, std::memory_order_acq_rel)) {
+                    return &oSlot;
+                }
+                if (pSite == &i_oSite) {
+                    return &oSlot;
+                }
+            }
+
+            return nullptr;
+        }
+
+    private:
+        /// @var uint64_t m_nId
+        /// @brief The sequence number of the lock.
+        uint64_t m_nId;
+
+        /// @var std::string m_stName
+        /// @brief The name of the lock, empty if it was not named. Protected by the mutex of the profiler.
+        std::string m_stName;
+
+        /// @var std::atomic<uint64_t> m_nAcquisitions
+        /// @brief The number of acquisitions.
+        std::atomic<uint64_t> m_nAcquisitions = 0;
+
+        /// @var std::atomic<uint64_t> m_nContended
+        /// @brief The number of acquisitions which had to wait.
+        std::atomic<uint64_t> m_nContended = 0;
+
+        /// @var std::atomic<uint64_t> m_nWaitNs
+        /// @brief The total wait time in nanoseconds.
+        std::atomic<uint64_t> m_nWaitNs = 0;
+
+        /// @var std::atomic<uint64_t> m_nHoldNs
+        /// @brief The total hold time in nanoseconds.
+        std::atomic<uint64_t> m_nHoldNs = 0;
+
+        /// @var std::array<std::atomic<uint64_t>, LockHistogramBuckets> m_anWaitHistogram
+        /// @brief The histogram of the wait times of contended acquisitions.
+        std::array<std::atomic<uint64_t>, LockHistogramBuckets> m_anWaitHistogram{};
+
+        /// @var std::array<std::atomic<uint64_t>, LockHistogramBuckets> m_anHoldHistogram
+        /// @brief The histogram of the hold times.
+        std::array<std::atomic<uint64_t>, LockHistogramBuckets> m_anHoldHistogram{};
+
+        /// @var std::array<CLockSiteCounters, LockSiteSlots> m_aoSites
+        /// @brief The counters of the first call sites which acquired the lock.
+        std::array<CLockSiteCounters, LockSiteSlots> m_aoSites;
+    };
+
+    /// @class Devel::Threading::CLockSiteReport
+    /// @brief A snapshot of the statistics of one lock at one call site.
+    class CLockSiteReport {
+    public:
+        /// @var std::string m_stSite
+        /// @brief The call site as "file:line", "(other call sites)" for the call sites without a slot.
+        std::string m_stSite;
+
+        /// @var uint64_t m_nAcquisitions
+        /// @brief The number of acquisitions.
+        uint64_t m_nAcquisitions = 0;
+
+        /// @var uint64_t m_nContended
+        /// @brief The number of acquisitions which had to wait.
+        uint64_t m_nContended = 0;
+
+        /// @var uint64_t m_nWaitNs
+        /// @brief The total wait time in nanoseconds.
+        uint64_t m_nWaitNs = 0;
+
+        /// @var uint64_t m_nHoldNs
+        /// @brief The total hold time in nanoseconds.
+        uint64_t m_nHoldNs = 0;
+    };
+
+    /// @class Devel::Threading::CLockReport
+    /// @brief A snapshot of the statistics of one lock, returned by CLockProfiler::report().
+    class CLockReport {
+    public:
+        /// @var std::string m_stName
+        /// @brief The name of the lock. Unnamed locks are called after their first call site and sequence number.
+        std::string m_stName;
+
+        /// @var uint64_t m_nAcquisitions
+        /// @brief The number of acquisitions.
+        uint64_t m_nAcquisitions = 0;
+
+        /// @var uint64_t m_nContended
+        /// @brief The number of acquisitions which had to wait.
+        uint64_t m_nContended = 0;
+
+        /// @var uint64_t m_nWaitNs
+        /// @brief The total wait time in nanoseconds.
+        uint64_t m_nWaitNs = 0;
+
+        /// @var uint64_t m_nHoldNs
+        /// @brief The total hold time in nanoseconds.
+        uint64_t m_nHoldNs = 0;
+
+        /// @var LockHistogram m_anWaitHistogram
+        /// @brief The histogram of the wait times, see LockHistogramBuckets.
+        LockHistogram m_anWaitHistogram{};
+
+        /// @var LockHistogram m_anHoldHistogram
+        /// @brief The histogram of the hold times, see LockHistogramBuckets.
+        LockHistogram m_anHoldHistogram{};
+
+        /// @var std::vector<CLockSiteReport> m_aoSites
+        /// @brief The statistics by call site, sorted like the reports.
+        std::vector<CLockSiteReport> m_aoSites;
+    };
+
+    /// @class Devel::Threading::CLockProfiler
+    /// @brief The registry of the statistics of all profiled locks.
+    ///
+    /// Lock profiling is opt-in. When the library and the application are compiled with DEVEL_LOCK_PROFILING
+    /// (CMake option DEVEL_LOCK_PROFILING), the lock guard macros record for every lock the number of
+    /// acquisitions, the number of contended acquisitions, and wait and hold time histograms, broken down by
+    /// the call sites of the guards. Without the define the lock guards contain no instrumentation at all and
+    /// the report is empty.
+    ///
+    /// Locks are reported by name, see CProfiledLock::setName(). Locks sharing a name, e.g. the queues of
+    /// several workers, are merged. The statistics of destroyed locks are kept under their name.
+    /// Only locks deriving from CProfiledLock and taken through CLockGuard and CSharedLockGuard are recorded,
+    /// direct lock() calls and CNullLock are not.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     // Compiled with -DDEVEL_LOCK_PROFILING
+    ///     Devel::Threading::CSafeQueue<Job> jobs;
+    ///     jobs.mutex().setName("jobs");
+    ///     runWorkload();
+    ///
+    ///     // Print the ten locks with the most contended acquisitions and their hottest call sites
+    ///     Devel::Threading::CLockProfiler::instance()->dump(std::cout, 10);
+    /// @endcode
+    class CLockProfiler : public CSingleton<CLockProfiler> {
+        friend class CSingleton<CLockProfiler>;
+
+    public:
+        /// @brief Checks if lock profiling is compiled in.
+        /// @return True if DEVEL_LOCK_PROFILING is defined.
+        static constexpr bool isEnabled() {
+#ifdef DEVEL_LOCK_PROFILING
+            return true;
+#else
+            return false;
+#endif
+        }
+
+    public:
+        /// @brief Allocates and registers the statistics of a lock. Called by CProfiledLock.
+        /// @return The statistics, owned by the profiler until retire() or discard().
+        CLockStats *createStats();
+
+        /// @brief Sets the name of a lock.
+        /// @param i_pStats The statistics of the lock.
+        /// @param i_stName The name.
+        void rename(CLockStats *i_pStats, std::string i_stName);
+
+        /// @brief Keeps the counters of a destroyed lock under its name and frees its statistics.
+        /// @param i_pStats The statistics of the lock.
+        static void retire(CLockStats *i_pStats);
+
+        /// @brief Frees statistics which were never used.
+        /// @param i_pStats The statistics.
+        void discard(CLockStats *i_pStats);
+
+        /// @brief Returns the locks with the most contended acquisitions.
+        /// @param i_nTopCount The maximum number of locks, 0 for all.
+        /// @return The statistics sorted by contended acquisitions, then by total wait time.
+        std::vector<CLockReport> report(size_t i_nTopCount = 0) const;
+
+        /// @brief Writes a human readable report of the most contended locks and their call sites.
+        /// @param i_oStream The stream to write to.
+        /// @param i_nTopCount The maximum number of locks, 0 for all.
+        void dump(std::ostream &i_oStream, size_t i_nTopCount = 10) const;
+
+        /// @brief Resets the counters of all locks and drops the statistics of destroyed locks.
+        void reset();
+
+    private:
+        /// @brief Constructs the empty registry.
+        CLockProfiler() = default;
+
+        /// @brief Destructor, static locks destroyed later free their statistics without retiring them.
+        ~CLockProfiler() override;
+
+        /// @brief Takes a snapshot of the counters of a lock.
+        /// @param i_oStats The statistics of the lock.
+        /// @return The report of the lock, without a name.
+        static CLockReport snapshot(const CLockStats &i_oStats);
+
+        /// @brief Adds a report to another one, call sites are merged by name.
+        /// @param i_oSource The report to add.
+        /// @param i_oTarget The report to add to.
+        static void merge(const CLockReport &i_oSource, CLockReport &i_oTarget);
+
+        /// @brief Returns the report name of a lock, the caller holds m_oMutex.
+        /// @param i_oStats The statistics of the lock.
+        /// @param i_fIsRetired True if the lock was destroyed, unnamed destroyed locks are merged by call site.
+        /// @return The name.
+        static std::string nameOf(const CLockStats &i_oStats, bool i_fIsRetired);
+
+    private:
+        /// @var std::mutex m_oMutex
+        /// @brief Protects the registry. A plain std::mutex, so the profiler never profiles itself.
+        mutable std::mutex m_oMutex;
+
+        /// @var std::vector<CLockStats *> m_apStats
+        /// @brief The statistics of all living profiled locks.
+        std::vector<CLockStats *> m_apStats;
+
+        /// @var std::map<std::string, CLockReport> m_aoRetired
+        /// @brief The counters of destroyed locks by name.
+        std::map<std::string, CLockReport> m_aoRetired;
+
+        /// @var uint64_t m_nNextId
+        /// @brief The sequence number of the next lock.
+        uint64_t m_nNextId = 1;
+
+        /// @var std::atomic<bool> s_fIsDestroyed
+        /// @brief Set when the profiler is destroyed at exit.
+        static inline std::atomic<bool> s_fIsDestroyed = false;
+    };
+}
+
+/// @def DEVEL_LOCK_SITE()
+/// @brief Expands to a reference to the static CLockSite of the current source location.
+#define DEVEL_LOCK_SITE() ([]() -> const ::Devel::Threading::CLockSite & { \
+    static constexpr ::Devel::Threading::CLockSite s_oSite(__FILE__, __LINE__); \
+    return s_oSite;                                                          \
+}())
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#ifdef DEVEL_LOCK_PROFILING
+#include "Threading/LockProfiler/LockProfiler.h"
+#endif
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+#ifdef DEVEL_LOCK_PROFILING
+    /// @class Devel::Threading::CProfiledLock
+    /// @brief The base class giving a lock its own identity in the CLockProfiler.
+    ///
+    /// The statistics of the lock are allocated on the first profiled acquisition. A copied lock is a new lock
+    /// with its own statistics. Without DEVEL_LOCK_PROFILING the class is empty.
+    class CProfiledLock {
+    public:
+        /// @brief Default constructor.
+        CProfiledLock() = default;
+
+        /// @brief Copy constructor, the copy gets its own statistics.
+        CProfiledLock(const CProfiledLock &) {
+        }
+
+        /// @brief Copy assignment operator, the statistics stay with the lock.
+        /// @return Reference to this lock.
+        CProfiledLock &operator=(const CProfiledLock &) {
+            return *this;
+        }
+
+        /// @brief Destructor, keeps the statistics in the profiler under the name of the lock.
+        ~CProfiledLock() {
+            CLockStats *pStats = this->m_pStats.load(std::memory_order_acquire);
+            if (pStats) {
+                CLockProfiler::retire(pStats);
+            }
+        }
+
+    public:
+        /// @brief Sets the name the lock is reported under. Locks sharing a name are merged in the report.
+        /// @param i_stName The name.
+        void setName(std::string i_stName) const {
+            CLockProfiler::instance()->rename(&this->lockStats(), std::move(i_stName));
+        }
+
+        /// @brief Returns the statistics of the lock, allocating them on first use.
+        /// @return The statistics.
+        CLockStats &lockStats() const {
+            CLockStats *pStats = this->m_pStats.load(std::memory_order_acquire);
+            if (pStats) {
+                return *pStats;
+            }
+
+            CLockStats *pCreated = CLockProfiler::instance()->createStats();
+            if (this->m_pStats.compare_exchange_strong(pStats, pCreated, std::memory_order_acq_rel)) {
+                return *pCreated;
+            }
+
+            CLockProfiler::instance()->discard(pCreated);
+            return *pStats;
+        }
+
+    private:
+        /// @var std::atomic<CLockStats *> m_pStats
+        /// @brief The statistics of the lock, nullptr until the first profiled acquisition.
+        mutable std::atomic<CLockStats *> m_pStats = nullptr;
+    };
+#else
+    /// @class Devel::Threading::CProfiledLock
+    /// @brief The base class giving a lock its own identity in the CLockProfiler.
+    ///
+    /// Without DEVEL_LOCK_PROFILING the class is empty and naming a lock does nothing.
+    class CProfiledLock {
+    public:
+        /// @brief Does nothing, lock profiling is disabled.
+        void setName(const std::string &) const {
+        }
+    };
+#endif
+}
@@ -2,6 +2,8 @@
 
 #include <mutex>
 
+#include "Threading/LockProfiler/ProfiledLock.h"
+
 /// @namespace Devel::Threading
 /// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
 namespace Devel::Threading {
@@ -44,7 +46,7 @@ namespace Devel::Threading {
     ///         return 0;
     ///     }
     /// @endcode
-    class CMutex {
+    class CMutex : public CProfiledLock {
     public:
         /// @brief Default constructor for CMutex.
         CMutex() = default;
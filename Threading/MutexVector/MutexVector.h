@@ -1,9 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
 #include <vector>
 
 #include "Threading/Mutex/Mutex.h"
+#include "Threading/LockGuard/LockGuard.h"
 #include "Core/Exceptions.h"
 
 /// @def MutexVectorLockGuard(x)
@@ -12,6 +17,13 @@
 /// @param x The MutexVector instance to lock.
 #define MutexVectorLockGuard(x) RecursiveLockGuard(x.mutex())
 
+/// @def MutexVectorSharedLockGuard(x)
+/// @brief Defines a shared lock guard for a MutexVector. Readers do not block each other if the MutexVector
+/// uses a reader/writer lock, otherwise the exclusive lock is taken.
+///
+/// @param x The MutexVector instance to lock shared.
+#define MutexVectorSharedLockGuard(x) SharedLockGuard(x.mutex())
+
 /// @def MutexVectorLock(x)
 /// @brief Defines a lock for a MutexVector. When this macro is used, it locks the MutexVector's mutex.
 ///
@@ -26,12 +38,20 @@
 /// @namespace Devel::Threading
 /// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
 namespace Devel::Threading {
-    /// @class Devel::Threading::CMutexVector<T>
+    /// @class Devel::Threading::CMutexVector<T, TLock>
     /// @brief A class for thread-safe handling of vectors.
     ///
     /// This class encapsulates a std::vector<T>, providing an interface
     /// for thread-safe operations on the vector.
     ///
+    /// The lock type is a policy. The default CMutex serializes every access. With CSharedMutex the const
+    /// operations (find, findAll, findIndex, contains, ...) take the shared lock and run concurrently,
+    /// which pays off for read-mostly vectors. CSharedMutex is not recursive, so the vector never locks
+    /// itself again while it holds its lock.
+    ///
+    /// @tparam T The type of elements stored in the vector.
+    /// @tparam TLock The lock type, CMutex or CSharedMutex.
+    ///
     /// <b>Example</b>
     ///
     /// This class must be used when you want to manipulate a vector in a multi-threaded context.
@@ -60,10 +80,14 @@ namespace Devel::Threading {
     ///
     ///         return 0;
     ///     }
+    ///
+    ///     // A read-mostly lookup table
+    ///     Devel::Threading::CMutexVector<int, Devel::Threading::CSharedMutex> lookupTable;
     /// @endcode
-    template<typename T>
+    template<typename T, typename TLock = CMutex>
     class CMutexVector {
 #define InClassLock() RecursiveLockGuard(this->m_oMutex)
+#define InClassSharedLock() SharedLockGuard(this->m_oMutex)
     public:
         /// @brief Default constructor for CMutexVector.
         CMutexVector() = default;
@@ -79,12 +103,12 @@ namespace Devel::Threading {
         }
 
         /// @brief Copy constructor that takes a const reference to another CMutexVector.
-        CMutexVector(const CMutexVector<T> &i_oVector) {
+        CMutexVector(const CMutexVector &i_oVector) {
             this->operator=(i_oVector);
         }
 
         //// @brief Move constructor that takes an rvalue reference to another CMutexVector.
-        CMutexVector(CMutexVector<T> &&i_oVector)
+        CMutexVector(CMutexVector &&i_oVector)
         noexcept {
             this->operator=(std::move(i_oVector));
         }
@@ -99,20 +123,7 @@ namespace Devel::Threading {
         /// @param i_fnMatch The matching condition.
         /// @return True if any elements were removed, false otherwise.
         bool removeAll(FnMatch i_fnMatch) {
-            bool fWasSuccessful = false;
-
-            InClassLock();
-            for (size_t i = 0, nSize = this->size(); i < nSize;) {
-                if (i_fnMatch(this->m_atVector[i])) {
-                    nSize--;
-                    this->removeAt(i);
-                    fWasSuccessful = true;
-                } else {
-                    i++;
-                }
-            }
-
-            return fWasSuccessful;
+            return this->removeIf(i_fnMatch) != 0;
         }
 
         /// @brief Removes the first element from the vector that matches the given condition.
@@ -122,7 +133,7 @@ namespace Devel::Threading {
             InClassLock();
             for (size_t i = 0, nSize = this->size(); i < nSize; i++) {
                 if (i_fnMatch(this->m_atVector[i])) {
-                    this->removeAt(i);
+                    this->eraseAt(i);
                     return true;
                 }
             }
@@ -142,7 +153,7 @@ namespace Devel::Threading {
         /// @return The first matching element.
         /// @throws NoEntryFoundException if no matching element is found.
         T find(FnMatch i_fnMatch) const {
-            InClassLock();
+            InClassSharedLock();
             for (size_t i = 0, nSize = this->size(); i < nSize; i++) {
                 if (i_fnMatch(this->m_atVector[i])) {
                     return this->m_atVector[i];
@@ -161,12 +172,13 @@ namespace Devel::Threading {
         }
 
         /// @brief Finds all elements in the vector that match the given condition.
+        /// Parallel::findAll() searches large vectors on a thread pool.
         /// @param i_fnMatch The matching condition.
         /// @return A vector containing all matching elements.
         std::vector<T> findAll(FnMatch i_fnMatch) const {
             std::vector<T> atData;
 
-            InClassLock();
+            InClassSharedLock();
             for (size_t i = 0, nSize = this->size(); i < nSize; i++) {
                 if (i_fnMatch(this->m_atVector[i])) {
                     atData.push_back(this->m_atVector[i]);
@@ -188,7 +200,7 @@ namespace Devel::Threading {
         /// @return The index of the first matching element.
         /// @return (~0) if no matching element is found.
         size_t findIndex(FnMatch i_fnMatch) const {
-            InClassLock();
+            InClassSharedLock();
             for (size_t i = 0, nSize = this->size(); i < nSize; i++) {
                 if (i_fnMatch(this->m_atVector[i])) {
                     return i;
@@ -212,7 +224,7 @@ namespace Devel::Threading {
         std::vector<size_t> findIndexAll(FnMatch i_fnMatch) const {
             std::vector<size_t> anIndexes;
 
-            InClassLock();
+            InClassSharedLock();
             for (size_t i = 0, nSize = this->size(); i < nSize; i++) {
                 if (i_fnMatch(this->m_atVector[i])) {
                     anIndexes.push_back(i);
@@ -233,12 +245,12 @@ namespace Devel::Threading {
         /// @param i_fnMatch The matching condition.
         /// @return The first matching element.
         /// @throws NoEntryFoundException if no matching element is found.
-        T take(FnMatch i_fnMatch) const {
+        T take(FnMatch i_fnMatch) {
             InClassLock();
             for (size_t i = 0, nSize = this->size(); i < nSize; i++) {
                 if (i_fnMatch(this->m_atVector[i])) {
                     T tData = this->m_atVector[i];
-                    this->removeAt(i);
+                    this->eraseAt(i);
                     return tData;
                 }
             }
@@ -249,27 +261,97 @@ namespace Devel::Threading {
         /// @brief Takes all elements from the vector that match the given condition and removes them from the vector.
         /// @param i_fnMatch The matching condition.
         /// @return A vector containing all matching elements.
-        std::vector<T> takeAll(FnMatch i_fnMatch) const {
+        std::vector<T> takeAll(FnMatch i_fnMatch) {
             std::vector<T> atData;
 
             InClassLock();
-            for (size_t i = 0, nSize = this->size(); i < nSize;) {
-                if (i_fnMatch(this->m_atVector[i])) {
-                    atData.push_back(this->m_atVector[i]);
-                    this->removeAt(i);
-                    nSize--;
+            // Single pass: matches are moved out, the remaining elements are compacted in place
+            auto itWrite = this->m_atVector.begin();
+            for (auto it = this->m_atVector.begin(); it != this->m_atVector.end(); ++it) {
+                if (i_fnMatch(*it)) {
+                    atData.push_back(std::move(*it));
                 } else {
-                    i++;
+                    if (itWrite != it) {
+                        *itWrite = std::move(*it);
+                    }
+                    ++itWrite;
                 }
             }
+            this->m_atVector.erase(itWrite, this->m_atVector.end());
 
             return atData;
         }
 
+    public:
+        /// @brief Removes all elements that match the given predicate in a single erase-remove pass.
+        /// Unlike removeAll(FnMatch) the predicate is not type-erased and can be inlined.
+        /// @param i_fnMatch The predicate, called with a const reference to each element.
+        /// @return The number of removed elements.
+        template<typename F>
+        size_t removeIf(F &&i_fnMatch) {
+            InClassLock();
+            return std::erase_if(this->m_atVector, [&i_fnMatch](const T &i_tValue) -> bool {
+                return i_fnMatch(i_tValue);
+            });
+        }
+
+        /// @brief Finds the first element that matches the given predicate.
+        /// @param i_fnMatch The predicate, called with a const reference to each element.
+        /// @return A copy of the first matching element.
+        /// @throws NoEntryFoundException if no matching element is found.
+        template<typename F>
+        T findIf(F &&i_fnMatch) const {
+            InClassSharedLock();
+            const auto it = std::find_if(this->m_atVector.begin(), this->m_atVector.end(),
+                                         [&i_fnMatch](const T &i_tValue) -> bool { return i_fnMatch(i_tValue); });
+            if (it == this->m_atVector.end()) {
+                throw NoEntryFoundException;
+            }
+
+            return *it;
+        }
+
+        /// @brief Counts the elements that match the given predicate.
+        /// @param i_fnMatch The predicate, called with a const reference to each element.
+        /// @return The number of matching elements.
+        template<typename F>
+        size_t countIf(F &&i_fnMatch) const {
+            InClassSharedLock();
+            return static_cast<size_t>(std::count_if(this->m_atVector.begin(), this->m_atVector.end(),
+                                                     [&i_fnMatch](const T &i_tValue) -> bool {
+                                                         return i_fnMatch(i_tValue);
+                                                     }));
+        }
+
+        /// @brief Calls a function for every element while holding the (shared) lock once.
+        /// @param i_fnVisit The function, called with a const reference to each element.
+        template<typename F>
+        void forEach(F &&i_fnVisit) const {
+            InClassSharedLock();
+            for (const T &tValue: this->m_atVector) {
+                i_fnVisit(tValue);
+            }
+        }
+
+        /// @brief Modifies every element while holding the lock once.
+        /// The function either takes a T & and modifies it, or returns the new value of the element.
+        /// @param i_fnTransform The transformation.
+        template<typename F>
+        void transformInPlace(F &&i_fnTransform) {
+            InClassLock();
+            for (T &tValue: this->m_atVector) {
+                if constexpr (std::is_void_v<std::invoke_result_t<F &, T &>>) {
+                    i_fnTransform(tValue);
+                } else {
+                    tValue = i_fnTransform(tValue);
+                }
+            }
+        }
+
     public:
         /// @brief Returns a reference to the underlying mutex of the CMutexVector.
         /// @return A reference to the mutex.
-        const CMutex &mutex() const {
+        const TLock &mutex() const {
             return this->m_oMutex;
         }
 
@@ -337,6 +419,7 @@ namespace Devel::Threading {
         /// @brief Converts the CMutexVector to a standard vector.
         /// @return A std::vector<T> containing the elements of the CMutexVector.
         std::vector<T> toStdVector() const {
+            InClassSharedLock();
             return this->m_atVector;
         }
 
@@ -344,7 +427,7 @@ namespace Devel::Threading {
         /// @param i_oValue The value to check for.
         /// @return True if the vector contains the value, false otherwise.
         bool contains(const T &i_oValue) const {
-            InClassLock();
+            InClassSharedLock();
             for (const T &tValue: this->m_atVector) {
                 if (tValue == i_oValue) {
                     return true;
@@ -386,30 +469,62 @@ namespace Devel::Threading {
         /// @brief Appends a vector of elements to the end of the vector.
         /// @param i_atValue The vector of elements to append.
         void push_back(const std::vector<T> &i_atValue) {
-            for (const T &oItem: i_atValue) {
-                this->push_back(oItem);
-            }
+            InClassLock();
+            this->m_atVector.insert(this->m_atVector.end(), i_atValue.begin(), i_atValue.end());
         }
 
         /// @brief Moves a vector of elements to the end of the vector.
         /// @param i_atValue The vector of elements to move.
         void push_back(std::vector<T> &&i_atValue) {
-            for (const T &oItem: i_atValue) {
-                this->push_back(std::move(oItem));
+            InClassLock();
+            if (this->m_atVector.empty()) {
+                this->m_atVector = std::move(i_atValue);
+            } else {
+                this->m_atVector.insert(this->m_atVector.end(), std::make_move_iterator(i_atValue.begin()),
+                                        std::make_move_iterator(i_atValue.end()));
+            }
+        }
+
+        /// @brief Appends all elements of a range, the lock is taken and the memory reserved once.
+        /// The elements are moved if the range is passed as an rvalue, otherwise they are copied.
+        /// @param i_atValue The range of elements to append.
+        template<typename R>
+        requires (std::ranges::input_range<R> &&
+                  std::is_constructible_v<T, std::ranges::range_reference_t<R>> &&
+                  !std::is_convertible_v<R, const T &> &&
+                  !std::is_same_v<std::remove_cvref_t<R>, std::vector<T>> &&
+                  !std::is_base_of_v<CMutexVector, std::remove_cvref_t<R>>)
+        void push_back(R &&i_atValue) {
+            InClassLock();
+            if constexpr (std::ranges::sized_range<R>) {
+                this->m_atVector.reserve(this->m_atVector.size() + std::ranges::size(i_atValue));
+            }
+
+            for (auto &&tValue: i_atValue) {
+                if constexpr (std::is_lvalue_reference_v<R>) {
+                    this->m_atVector.emplace_back(tValue);
+                } else {
+                    this->m_atVector.emplace_back(std::move(tValue));
+                }
             }
         }
 
         /// @brief Appends another CMutexVector to the end of the vector.
         /// @param i_atValue The CMutexVector to append.
-        void push_back(const CMutexVector<T> &i_atValue) {
-            MutexVectorLockGuard(i_atValue);
-            return this->push_back(i_atValue.rawVector());
+        void push_back(const CMutexVector &i_atValue) {
+            // Copy first, so the two locks are never held at the same time
+            return this->push_back(i_atValue.toStdVector());
         }
 
         /// @brief Moves another CMutexVector to the end of the vector.
         /// @param i_atValue The CMutexVector to move.
-        void push_back(CMutexVector<T> &&i_atValue) {
-            return this->push_back(std::move(i_atValue.rawVector()));
+        void push_back(CMutexVector &&i_atValue) {
+            std::vector<T> atVector;
+            {
+                MutexVectorLockGuard(i_atValue);
+                atVector.swap(i_atValue.m_atVector);
+            }
+            return this->push_back(std::move(atVector));
         }
 
     public:
@@ -418,13 +533,7 @@ namespace Devel::Threading {
         /// @return True if the element was removed, false otherwise.
         bool removeAt(const size_t i_nIndex) {
             InClassLock();
-            if (i_nIndex > this->size()) {
-                return false;
-            }
-
-            this->m_atVector.erase(this->begin() + i_nIndex);
-
-            return true;
+            return this->eraseAt(i_nIndex);
         }
 
         /// @brief Removes the first occurrence of the specified value from the vector.
@@ -434,7 +543,7 @@ namespace Devel::Threading {
             InClassLock();
             for (size_t i = 0, nSize = this->size(); i < nSize; i++) {
                 if (this->m_atVector[i] == i_oValue) {
-                    this->removeAt(i);
+                    this->eraseAt(i);
                     return true;
                 }
             }
@@ -469,21 +578,27 @@ namespace Devel::Threading {
         /// @brief Assignment operator that copies another CMutexVector to the CMutexVector.
         /// @param i_tOther The CMutexVector to copy.
         /// @return A reference to the CMutexVector after assignment.
-        virtual CMutexVector &operator=(const CMutexVector<T> &i_tOther) {
-            InClassLock();
-            MutexVectorLockGuard(i_tOther);
-            this->operator=(i_tOther.rawVector());
+        virtual CMutexVector &operator=(const CMutexVector &i_tOther) {
+            if (this != &i_tOther) {
+                // Copy first, so the two locks are never held at the same time
+                this->operator=(i_tOther.toStdVector());
+            }
             return *this;
         }
 
         /// @brief Assignment operator that moves another CMutexVector to the CMutexVector.
         /// @param i_tOther The CMutexVector to move.
         /// @return A reference to the CMutexVector after assignment.
-        virtual CMutexVector &operator=(CMutexVector<T> &&i_tOther)
+        virtual CMutexVector &operator=(CMutexVector &&i_tOther)
         noexcept {
-            InClassLock();
-            MutexVectorLockGuard(i_tOther);
-            this->operator=(std::move(i_tOther.rawVector()));
+            if (this != &i_tOther) {
+                std::vector<T> atVector;
+                {
+                    MutexVectorLockGuard(i_tOther);
+                    atVector.swap(i_tOther.m_atVector);
+                }
+                this->operator=(std::move(atVector));
+            }
             return *this;
         }
 
@@ -510,9 +625,22 @@ namespace Devel::Threading {
         }
 
     private:
-        /// @var CMutex m_oMutex
-        /// @brief The recursive mutex used for thread-safe operations.
-        CMutex m_oMutex;
+        /// @brief Removes the element at the specified index. The caller must hold the exclusive lock.
+        /// @param i_nIndex The index of the element to remove.
+        /// @return True if the element was removed, false if the index is out of range.
+        bool eraseAt(const size_t i_nIndex) {
+            if (i_nIndex >= this->m_atVector.size()) {
+                return false;
+            }
+
+            this->m_atVector.erase(this->m_atVector.begin() + i_nIndex);
+            return true;
+        }
+
+    private:
+        /// @var TLock m_oMutex
+        /// @brief The lock used for thread-safe operations.
+        TLock m_oMutex;
 
         /// @var std::vector<T> m_atVector
         /// @brief The underlying vector that the class encapsulates.
@@ -0,0 +1,30 @@
+#pragma once
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CNullLock
+    /// @brief A lock policy which does nothing.
+    ///
+    /// Containers instantiated with CNullLock skip all synchronization. Use it for objects which are only
+    /// accessed by a single thread, or for single-threaded builds.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     // A vector owned by one thread, no locking overhead
+    ///     Devel::Threading::CMutexVector<int, Devel::Threading::CNullLock> vector;
+    /// @endcode
+    class CNullLock {
+    public:
+        /// @brief Does nothing.
+        constexpr void lock() const noexcept {}
+
+        /// @brief Does nothing.
+        constexpr void unlock() const noexcept {}
+
+        /// @brief Does nothing.
+        /// @return Always true.
+        constexpr bool tryLock() const noexcept { return true; }
+    };
+}
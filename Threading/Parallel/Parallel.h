@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Threading/MutexVector/MutexVector.h"
+#include "Threading/ThreadPool/ThreadPool.h"
+
+/// @namespace Devel::Threading::Parallel
+/// @brief The namespace encapsulating parallel algorithms running on a CThreadPool.
+///
+/// All algorithms split their input into chunks which are claimed dynamically by the calling thread and
+/// by helper tasks running on the pool, so faster threads simply process more chunks. The calling thread
+/// always takes part in the work and the algorithms return once every chunk has finished, so they can also
+/// be called from inside a pool task without risking a deadlock. The first exception thrown by a chunk is
+/// rethrown on the calling thread.
+///
+/// <b>Example</b>
+///
+/// @code{.cpp}
+///     Devel::Threading::CThreadPool pool(4);
+///     pool.execute();
+///
+///     std::vector<int> values(1000000, 1);
+///
+///     // Double every element
+///     Devel::Threading::Parallel::parallelFor(pool, 0, values.size(), 0, [&](size_t i) { values[i] *= 2; });
+///
+///     // Sum up all elements
+///     int sum = Devel::Threading::Parallel::parallelReduce(pool, 0, values.size(), 0, 0,
+///                                                          [&](size_t i) { return values[i]; },
+///                                                          std::plus<int>());
+///
+///     // Sort the elements
+///     Devel::Threading::Parallel::parallelSort(pool, values.begin(), values.end());
+/// @endcode
+namespace Devel::Threading::Parallel {
+    /// @class Devel::Threading::Parallel::CParallelJob
+    /// @brief The state shared between the calling thread and the helper tasks of a parallel algorithm.
+    class CParallelJob {
+    public:
+        /// @brief Constructs a job with the given number of chunks.
+        /// @param i_nChunkCount The number of chunks.
+        explicit CParallelJob(const size_t i_nChunkCount)
+                : m_nChunkCount(i_nChunkCount), m_nNextChunk(0), m_nDoneChunks(0) {
+        }
+
+    public:
+        /// @brief Claims and runs chunks until none are left.
+        /// @param i_fnChunk The function processing one chunk, taking the chunk index.
+        template<typename F>
+        void run(F &i_fnChunk) {
+            size_t nChunk;
+            while ((nChunk = this->m_nNextChunk.fetch_add(1, std::memory_order_relaxed)) < this->m_nChunkCount) {
+                try {
+                    i_fnChunk(nChunk);
+                } catch (...) {
+                    std::lock_guard<std::mutex> oLock(this->m_oExceptionMutex);
+                    if (!this->m_pException) {
+                        this->m_pException = std::current_exception();
+                    }
+                }
+
+                if (this->m_nDoneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == this->m_nChunkCount) {
+                    this->m_nDoneChunks.notify_all();
+                }
+            }
+        }
+
+        /// @brief Blocks until all chunks have finished and rethrows the first exception of a chunk.
+        void wait() {
+            size_t nDone;
+            while ((nDone = this->m_nDoneChunks.load(std::memory_order_acquire)) != this->m_nChunkCount) {
+                this->m_nDoneChunks.wait(nDone, std::memory_order_acquire);
+            }
+
+            if (this->m_pException) {
+                std::rethrow_exception(this->m_pException);
+            }
+        }
+
+    private:
+        /// @var size_t m_nChunkCount
+        /// @brief The number of chunks of the job.
+        size_t m_nChunkCount;
+
+        /// @var std::atomic<size_t> m_nNextChunk
+        /// @brief The index of the next unclaimed chunk.
+        std::atomic<size_t> m_nNextChunk;
+
+        /// @var std::atomic<size_t> m_nDoneChunks
+        /// @brief The number of finished chunks.
+        std::atomic<size_t> m_nDoneChunks;
+
+        /// @var std::mutex m_oExceptionMutex
+        /// @brief The mutex protecting m_pException.
+        std::mutex m_oExceptionMutex;
+
+        /// @var std::exception_ptr m_pException
+        /// @brief The first exception thrown by a chunk.
+        std::exception_ptr m_pException;
+    };
+
+    /// @brief Returns the grain size used when 0 is passed to an algorithm.
+    /// The range is split into about eight chunks per thread to balance uneven work.
+    /// @param i_oPool The thread pool.
+    /// @param i_nCount The number of elements.
+    /// @return The grain size.
+    inline size_t automaticGrain(const CThreadPool &i_oPool, const size_t i_nCount) {
+        const size_t nThreads = (i_oPool.isExecuted() ? i_oPool.workerCount() : 0) + 1;
+        return std::max<size_t>(1, i_nCount / (nThreads * 8));
+    }
+
+    /// @brief Runs a function for every chunk index in [0, i_nChunkCount) on the pool and the calling thread.
+    /// @param i_oPool The thread pool.
+    /// @param i_nChunkCount The number of chunks.
+    /// @param i_fnChunk The function processing one chunk, taking the chunk index.
+    template<typename F>
+    void parallelChunks(CThreadPool &i_oPool, const size_t i_nChunkCount, F &&i_fnChunk) {
+        if (i_nChunkCount == 0) {
+            return;
+        }
+
+        if (i_nChunkCount == 1 || !i_oPool.isExecuted()) {
+            for (size_t i = 0; i < i_nChunkCount; i++) {
+                i_fnChunk(i);
+            }
+            return;
+        }
+
+        // Helpers starting after the last chunk was claimed find no work and never touch the function
+        auto pJob = std::make_shared<CParallelJob>(i_nChunkCount);
+        auto *pFunction = &i_fnChunk;
+        const size_t nHelpers = std::min(i_oPool.workerCount(), i_nChunkCount - 1);
+
+        for (size_t i = 0; i < nHelpers; i++) {
+            i_oPool.addTask([pJob, pFunction]() { pJob->run(*pFunction); });
+        }
+
+        pJob->run(i_fnChunk);
+        pJob->wait();
+    }
+
+    /// @brief Runs a function for every sub-range of [i_nBegin, i_nEnd) on the pool and the calling thread.
+    /// @param i_oPool The thread pool.
+    /// @param i_nBegin The first index.
+    /// @param i_nEnd The index past the last index.
+    /// @param i_nGrain The number of indexes per chunk, 0 to choose automatically.
+    /// @param i_fnRange The function processing a sub-range, taking its first and past-the-end index.
+    template<typename F>
+    void parallelForRange(CThreadPool &i_oPool, const size_t i_nBegin, const size_t i_nEnd, size_t i_nGrain,
+                          F &&i_fnRange) {
+        if (i_nEnd <= i_nBegin) {
+            return;
+        }
+
+        const size_t nCount = i_nEnd - i_nBegin;
+        if (i_nGrain == 0) {
+            i_nGrain = automaticGrain(i_oPool, nCount);
+        }
+
+        parallelChunks(i_oPool, (nCount + i_nGrain - 1) / i_nGrain, [&](const size_t i_nChunk) {
+            const size_t nChunkBegin = i_nBegin + i_nChunk * i_nGrain;
+            i_fnRange(nChunkBegin, std::min(nChunkBegin + i_nGrain, i_nEnd));
+        });
+    }
+
+    /// @brief Runs a function for every index in [i_nBegin, i_nEnd) on the pool and the calling thread.
+    /// @param i_oPool The thread pool.
+    /// @param i_nBegin The first index.
+    /// @param i_nEnd The index past the last index.
+    /// @param i_nGrain The number of indexes per chunk, 0 to choose automatically.
+    /// @param i_fnIndex The function processing one index.
+    template<typename F>
+    void parallelFor(CThreadPool &i_oPool, const size_t i_nBegin, const size_t i_nEnd, const size_t i_nGrain,
+                     F &&i_fnIndex) {
+        parallelForRange(i_oPool, i_nBegin, i_nEnd, i_nGrain, [&](const size_t i_nFirst, const size_t i_nLast) {
+            for (size_t i = i_nFirst; i < i_nLast; i++) {
+                i_fnIndex(i);
+            }
+        });
+    }
+
+    /// @brief Maps every index in [i_nBegin, i_nEnd) to a value and combines all values.
+    ///
+    /// Every chunk is reduced on its own starting with the identity, the chunk results are then combined
+    /// in index order, so the result is deterministic for associative reduce functions.
+    ///
+    /// @param i_oPool The thread pool.
+    /// @param i_nBegin The first index.
+    /// @param i_nEnd The index past the last index.
+    /// @param i_nGrain The number of indexes per chunk, 0 to choose automatically.
+    /// @param i_tIdentity The identity value of the reduce function.
+    /// @param i_fnMap The function mapping an index to a value.
+    /// @param i_fnReduce The associative function combining two values.
+    /// @return The combined value.
+    template<typename T, typename FMap, typename FReduce>
+    T parallelReduce(CThreadPool &i_oPool, const size_t i_nBegin, const size_t i_nEnd, size_t i_nGrain,
+                     const T &i_tIdentity, FMap &&i_fnMap, FReduce &&i_fnReduce) {
+        if (i_nEnd <= i_nBegin) {
+            return i_tIdentity;
+        }
+
+        const size_t nCount = i_nEnd - i_nBegin;
+        if (i_nGrain == 0) {
+            i_nGrain = automaticGrain(i_oPool, nCount);
+        }
+
+        std::vector<T> atResults((nCount + i_nGrain - 1) / i_nGrain, i_tIdentity);
+        parallelChunks(i_oPool, atResults.size(), [&](const size_t i_nChunk) {
+            const size_t nChunkBegin = i_nBegin + i_nChunk * i_nGrain;
+            const size_t nChunkEnd = std::min(nChunkBegin + i_nGrain, i_nEnd);
+
+            T tValue = i_tIdentity;
+            for (size_t i = nChunkBegin; i < nChunkEnd; i++) {
+                tValue = i_fnReduce(std::move(tValue), i_fnMap(i));
+            }
+            atResults[i_nChunk] = std::move(tValue);
+        });
+
+        T tResult = i_tIdentity;
+        for (T &tValue: atResults) {
+            tResult = i_fnReduce(std::move(tResult), std::move(tValue));
+        }
+
+        return tResult;
+    }
+
+    /// @brief Applies a function to every element of [i_itFirst, i_itLast) and writes the results to i_itOut.
+    /// @param i_oPool The thread pool.
+    /// @param i_itFirst The first input element.
+    /// @param i_itLast The input element past the last one.
+    /// @param i_itOut The first output element, the output range must be large enough.
+    /// @param i_nGrain The number of elements per chunk, 0 to choose automatically.
+    /// @param i_fnTransform The function transforming one element.
+    template<typename InputIt, typename OutputIt, typename F>
+    void parallelTransform(CThreadPool &i_oPool, InputIt i_itFirst, InputIt i_itLast, OutputIt i_itOut,
+                           const size_t i_nGrain, F &&i_fnTransform) {
+        const auto nCount = static_cast<size_t>(std::distance(i_itFirst, i_itLast));
+
+        parallelForRange(i_oPool, 0, nCount, i_nGrain, [&](const size_t i_nFirst, const size_t i_nLast) {
+            std::transform(i_itFirst + i_nFirst, i_itFirst + i_nLast, i_itOut + i_nFirst, i_fnTransform);
+        });
+    }
+
+    /// @brief Sorts [i_itFirst, i_itLast) with a parallel merge sort.
+    ///
+    /// The range is split into a power of two number of runs which are sorted in parallel,
+    /// neighbouring runs are then merged pairwise in parallel rounds. The sort is not stable.
+    ///
+    /// @param i_oPool The thread pool.
+    /// @param i_itFirst The first element.
+    /// @param i_itLast The element past the last one.
+    /// @param i_fnCompare The comparison function.
+    template<typename RandomIt, typename Compare = std::less<>>
+    void parallelSort(CThreadPool &i_oPool, RandomIt i_itFirst, RandomIt i_itLast, Compare i_fnCompare = Compare()) {
+        const auto nCount = static_cast<size_t>(std::distance(i_itFirst, i_itLast));
+        const size_t nThreads = (i_oPool.isExecuted() ? i_oPool.workerCount() : 0) + 1;
+
+        size_t nRuns = 1;
+        while (nRuns < nThreads * 2 && nCount / (nRuns * 2) >= 2048) {
+            nRuns *= 2;
+        }
+
+        if (nRuns == 1) {
+            return std::sort(i_itFirst, i_itLast, i_fnCompare);
+        }
+
+        const auto fnBoundary = [&](const size_t i_nRun) {
+            return i_itFirst + static_cast<std::ptrdiff_t>(nCount * i_nRun / nRuns);
+        };
+
+        parallelChunks(i_oPool, nRuns, [&](const size_t i_nRun) {
+            std::sort(fnBoundary(i_nRun), fnBoundary(i_nRun + 1), i_fnCompare);
+        });
+
+        for (size_t nWidth = 1; nWidth < nRuns; nWidth *= 2) {
+            parallelChunks(i_oPool, nRuns / (nWidth * 2), [&](const size_t i_nPair) {
+                const size_t nRun = i_nPair * nWidth * 2;
+                std::inplace_merge(fnBoundary(nRun), fnBoundary(nRun + nWidth), fnBoundary(nRun + nWidth * 2),
+                                   i_fnCompare);
+            });
+        }
+    }
+
+    /// @brief Finds all elements of a CMutexVector that match the given condition, on the pool and the calling thread.
+    /// The shared lock of the vector is held during the whole search. The matching elements keep their order.
+    /// @param i_oPool The thread pool.
+    /// @param i_oVector The vector to search.
+    /// @param i_fnMatch The matching condition, it is called concurrently.
+    /// @param i_nGrain The number of elements per chunk, 0 to choose automatically.
+    /// @return A vector containing all matching elements.
+    template<typename T, typename TLock, typename F>
+    std::vector<T> findAll(CThreadPool &i_oPool, const CMutexVector<T, TLock> &i_oVector, F &&i_fnMatch,
+                           const size_t i_nGrain = 0) {
+        MutexVectorSharedLockGuard(i_oVector);
+        const std::vector<T> &atVector = i_oVector.rawVector();
+        const size_t nSize = atVector.size();
+        const size_t nGrain = (i_nGrain == 0 ? automaticGrain(i_oPool, nSize) : i_nGrain);
+        std::vector<std::vector<T>> aatChunks((nSize + nGrain - 1) / nGrain);
+
+        parallelChunks(i_oPool, aatChunks.size(), [&](const size_t i_nChunk) {
+            for (size_t i = i_nChunk * nGrain, nEnd = std::min(i + nGrain, nSize); i < nEnd; i++) {
+                if (i_fnMatch(atVector[i])) {
+                    aatChunks[i_nChunk].push_back(atVector[i]);
+                }
+            }
+        });
+
+        std::vector<T> atData;
+        for (std::vector<T> &atChunk: aatChunks) {
+            atData.insert(atData.end(), std::make_move_iterator(atChunk.begin()),
+                          std::make_move_iterator(atChunk.end()));
+        }
+
+        return atData;
+    }
+
+    /// @brief Checks if the given data is present in the vector, on the pool and the calling thread.
+    /// Chunks behind an already found match are skipped, the reported index is always the first match.
+    /// This only pays off for vectors with millions of elements or expensive comparisons.
+    /// @param i_oPool The thread pool.
+    /// @param i_atVector The vector to search.
+    /// @param i_tData The data to search for.
+    /// @param i_pOutIndex Receives the index of the first match if not nullptr.
+    /// @return True if the data is found in the vector.
+    template<typename T>
+    bool isDataInVector(CThreadPool &i_oPool, const std::vector<T> &i_atVector, const T &i_tData,
+                        size_t *i_pOutIndex = nullptr) {
+        std::atomic<size_t> nFoundIndex = i_atVector.size();
+
+        parallelForRange(i_oPool, 0, i_atVector.size(), 0, [&](const size_t i_nFirst, const size_t i_nLast) {
+            for (size_t i = i_nFirst; i < i_nLast && i < nFoundIndex.load(std::memory_order_relaxed); i++) {
+                if (i_atVector[i] == i_tData) {
+                    size_t nCurrent = nFoundIndex.load(std::memory_order_relaxed);
+                    while (i < nCurrent && !nFoundIndex.compare_exchange_weak(nCurrent, i));
+                    return;
+                }
+            }
+        });
+
+        if (nFoundIndex < i_atVector.size()) {
+            if (i_pOutIndex) {
+                *i_pOutIndex = nFoundIndex;
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,122 @@
+#include "Pipeline.h"
+
+void Devel::Threading::CPipelineNode::close() {
+    {
+        RecursiveLockGuard(this->m_oMutex);
+        if (this->m_fIsUpstreamDone) {
+            return;
+        }
+        this->m_fIsUpstreamDone = true;
+    }
+
+    if (!this->m_pPrevious) {
+        this->notifyUpstream();
+    }
+    this->schedule();
+}
+
+size_t Devel::Threading::CPipelineNode::reserve(const size_t i_nCount) {
+    RecursiveLockGuard(this->m_oMutex);
+    const size_t nCount = std::min(i_nCount, this->freeSlots());
+    if (nCount == 0) {
+        this->m_fIsUpstreamWaiting = true;
+    }
+    this->m_nReserved += nCount;
+
+    return nCount;
+}
+
+Devel::Threading::CPipelineStageMetrics Devel::Threading::CPipelineNode::metrics() {
+    CPipelineStageMetrics oMetrics;
+    oMetrics.m_stName = this->m_oOptions.name();
+    oMetrics.m_nParallelism = this->m_oOptions.parallelism();
+
+    RecursiveLockGuard(this->m_oMutex);
+    oMetrics.m_nProcessed = this->m_nProcessed;
+    oMetrics.m_nEmitted = this->m_nEmitted;
+    oMetrics.m_nBatches = this->m_nBatches;
+    oMetrics.m_nBusyNs = this->m_nBusyNs;
+    oMetrics.m_nQueueDepth = this->m_nQueued;
+    oMetrics.m_nActiveTasks = this->m_nActive;
+
+    return oMetrics;
+}
+
+void Devel::Threading::CPipelineNode::finishStage() {
+    if (this->m_pNext) {
+        this->m_pNext->close();
+    } else {
+        this->m_pPipeline->finish();
+    }
+}
+
+bool Devel::Threading::CPipelineNode::isPoolWorker() const {
+    const CThreadPoolWorker *pWorker = CThreadPool::currentWorker();
+    return pWorker && pWorker->pool() == this->m_pPipeline->m_pPool;
+}
+
+void Devel::Threading::CPipelineBase::wait() {
+    while (true) {
+        uint32_t nSignal;
+        {
+            RecursiveLockGuard(this->m_oMutex);
+            if (this->m_fIsFinished && this->m_nRunningTasks == 0) {
+                if (this->m_pException) {
+                    std::rethrow_exception(std::exchange(this->m_pException, nullptr));
+                }
+                return;
+            }
+            nSignal = this->m_nFinishSignal.load(std::memory_order_relaxed);
+        }
+
+        this->m_nFinishSignal.wait(nSignal, std::memory_order_acquire);
+    }
+}
+
+std::vector<Devel::Threading::CPipelineStageMetrics> Devel::Threading::CPipelineBase::metrics() const {
+    const uint64_t nElapsedNs = this->elapsedNs();
+
+    std::vector<CPipelineStageMetrics> aoMetrics;
+    aoMetrics.reserve(this->m_apNodes.size());
+    for (const std::unique_ptr<CPipelineNode> &pNode: this->m_apNodes) {
+        aoMetrics.push_back(pNode->metrics());
+        aoMetrics.back().m_nElapsedNs = nElapsedNs;
+    }
+
+    return aoMetrics;
+}
+
+void Devel::Threading::CPipelineBase::fail(std::exception_ptr i_pException) {
+    {
+        RecursiveLockGuard(this->m_oMutex);
+        if (!this->m_pException) {
+            this->m_pException = std::move(i_pException);
+        }
+        this->m_fHasFailed.store(true, std::memory_order_release);
+    }
+
+    // Pushers blocked on a full first stage return false from now on
+    this->m_apNodes.front()->notifyUpstream();
+}
+
+void Devel::Threading::CPipelineBase::finish() {
+    RecursiveLockGuard(this->m_oMutex);
+    this->m_fIsFinished = true;
+    this->m_nFinishNs = CPipelineBase::now();
+    this->m_nFinishSignal.fetch_add(1, std::memory_order_release);
+    this->m_nFinishSignal.notify_all();
+}
+
+void Devel::Threading::CPipelineBase::releaseTask() {
+    // Notified with the lock held, a thread returning from wait() may destroy the pipeline right after
+    RecursiveLockGuard(this->m_oMutex);
+    if (--this->m_nRunningTasks == 0 && this->m_fIsFinished) {
+        this->m_nFinishSignal.fetch_add(1, std::memory_order_release);
+        this->m_nFinishSignal.notify_all();
+    }
+}
+
+uint64_t Devel::Threading::CPipelineBase::elapsedNs() const {
+    RecursiveLockGuard(this->m_oMutex);
+    return (this->m_nFinishNs ? this->m_nFinishNs : CPipelineBase::now()) - this->m_nStartNs;
+}
@@ -0,0 +1,929 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Threading/LockGuard/LockGuard.h"
+#include "Threading/Mutex/Mutex.h"
+#include "Threading/ThreadPool/ThreadPool.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    class CPipelineBase;
+
+    /// @class Devel::Threading::CPipelineStageOptions
+    /// @brief The settings of a stage of a CPipeline.
+    class CPipelineStageOptions {
+    public:
+        /// @enum EOrder
+        /// @brief An enumeration of the orders a stage emits its items in.
+        enum EOrder {
+            EOrdered,           ///< Items leave the stage in the order they entered it.
+            EUnordered,         ///< Items leave the stage as soon as their batch is done.
+        };
+
+    public:
+        /// @brief Constructs the default options: one task, 1024 queued items, batches of 16 items, ordered.
+        CPipelineStageOptions()
+                : m_nParallelism(1), m_nCapacity(1024), m_nBatchSize(16), m_eOrder(EOrdered) {
+        }
+
+    public:
+        /// @brief Sets the name of the stage reported in the metrics.
+        /// @param i_stName The name.
+        /// @return A reference to the options.
+        CPipelineStageOptions &setName(std::string i_stName) {
+            this->m_stName = std::move(i_stName);
+            return *this;
+        }
+
+        /// @brief Sets the number of batches of the stage which may run at the same time.
+        /// @param i_nParallelism The number of pool tasks, at least 1.
+        /// @return A reference to the options.
+        CPipelineStageOptions &setParallelism(const size_t i_nParallelism) {
+            this->m_nParallelism = std::max<size_t>(i_nParallelism, 1);
+            return *this;
+        }
+
+        /// @brief Sets the number of items the input channel of the stage holds before it applies backpressure.
+        /// @param i_nCapacity The capacity, at least 1.
+        /// @return A reference to the options.
+        CPipelineStageOptions &setCapacity(const size_t i_nCapacity) {
+            this->m_nCapacity = std::max<size_t>(i_nCapacity, 1);
+            return *this;
+        }
+
+        /// @brief Sets the maximum number of items a pool task of the stage takes from its channel at once.
+        /// @param i_nBatchSize The batch size, at least 1.
+        /// @return A reference to the options.
+        CPipelineStageOptions &setBatchSize(const size_t i_nBatchSize) {
+            this->m_nBatchSize = std::max<size_t>(i_nBatchSize, 1);
+            return *this;
+        }
+
+        /// @brief Sets the order the stage emits its items in.
+        /// @param i_eOrder The order.
+        /// @return A reference to the options.
+        CPipelineStageOptions &setOrder(const EOrder i_eOrder) {
+            this->m_eOrder = i_eOrder;
+            return *this;
+        }
+
+    public:
+        /// @brief Returns the name of the stage.
+        /// @return The name.
+        const std::string &name() const { return this->m_stName; }
+
+        /// @brief Returns the number of batches of the stage which may run at the same time.
+        /// @return The parallelism.
+        size_t parallelism() const { return this->m_nParallelism; }
+
+        /// @brief Returns the capacity of the input channel.
+        /// @return The capacity.
+        size_t capacity() const { return this->m_nCapacity; }
+
+        /// @brief Returns the maximum batch size.
+        /// @return The batch size.
+        size_t batchSize() const { return this->m_nBatchSize; }
+
+        /// @brief Returns the order the stage emits its items in.
+        /// @return The order.
+        EOrder order() const { return this->m_eOrder; }
+
+    private:
+        /// @var std::string m_stName
+        /// @brief The name of the stage.
+        std::string m_stName;
+
+        /// @var size_t m_nParallelism
+        /// @brief The number of batches which may run at the same time.
+        size_t m_nParallelism;
+
+        /// @var size_t m_nCapacity
+        /// @brief The capacity of the input channel.
+        size_t m_nCapacity;
+
+        /// @var size_t m_nBatchSize
+        /// @brief The maximum batch size.
+        size_t m_nBatchSize;
+
+        /// @var EOrder m_eOrder
+        /// @brief The order the stage emits its items in.
+        EOrder m_eOrder;
+    };
+
+    /// @class Devel::Threading::CPipelineStageMetrics
+    /// @brief A snapshot of the counters of a stage, returned by CPipeline::metrics().
+    class CPipelineStageMetrics {
+    public:
+        /// @brief Returns the number of items the stage processed per second since the pipeline was built.
+        /// @return The throughput in items per second.
+        double throughput() const {
+            return this->m_nElapsedNs ? static_cast<double>(this->m_nProcessed) * 1e9 /
+                                        static_cast<double>(this->m_nElapsedNs) : 0.0;
+        }
+
+        /// @brief Returns the fraction of the elapsed time the tasks of the stage were busy.
+        /// A stage close to 1 is the bottleneck of the pipeline.
+        /// @return The utilization between 0 and 1.
+        double utilization() const {
+            const double dCapacity = static_cast<double>(this->m_nElapsedNs) * static_cast<double>(this->m_nParallelism);
+            return dCapacity > 0 ? std::min(static_cast<double>(this->m_nBusyNs) / dCapacity, 1.0) : 0.0;
+        }
+
+    public:
+        /// @var std::string m_stName
+        /// @brief The name of the stage.
+        std::string m_stName;
+
+        /// @var size_t m_nParallelism
+        /// @brief The number of batches which may run at the same time.
+        size_t m_nParallelism = 0;
+
+        /// @var uint64_t m_nProcessed
+        /// @brief The number of items taken from the input channel and processed.
+        uint64_t m_nProcessed = 0;
+
+        /// @var uint64_t m_nEmitted
+        /// @brief The number of items passed on to the next stage.
+        uint64_t m_nEmitted = 0;
+
+        /// @var uint64_t m_nBatches
+        /// @brief The number of processed batches.
+        uint64_t m_nBatches = 0;
+
+        /// @var uint64_t m_nBusyNs
+        /// @brief The summed run time of the batches in nanoseconds.
+        uint64_t m_nBusyNs = 0;
+
+        /// @var uint64_t m_nElapsedNs
+        /// @brief The time since the pipeline was built, until it finished, in nanoseconds.
+        uint64_t m_nElapsedNs = 0;
+
+        /// @var size_t m_nQueueDepth
+        /// @brief The number of items waiting in the input channel.
+        size_t m_nQueueDepth = 0;
+
+        /// @var size_t m_nActiveTasks
+        /// @brief The number of batches being processed right now.
+        size_t m_nActiveTasks = 0;
+    };
+
+    /// @class Devel::Threading::CPipelineNode
+    /// @brief The untyped part of a pipeline stage: its bounded input channel accounting, scheduling state and counters.
+    ///
+    /// A channel counts its queued items and the slots reserved by batches of the previous stage which are still
+    /// being processed. A stage only takes a batch after it reserved room for the results in the next channel,
+    /// so pool tasks never block on a full channel and the memory of the pipeline is bounded by the capacities.
+    /// Locks are only ever nested from a stage to its next stage, and schedule() is never called with a lock held.
+    class CPipelineNode {
+        friend class CPipelineBase;
+
+        template<typename TIn, typename TCurrent>
+        friend class CPipelineBuilder;
+
+    public:
+        /// @brief Constructs a node.
+        /// @param i_pPipeline The pipeline owning the node.
+        /// @param i_oOptions The options of the stage.
+        CPipelineNode(CPipelineBase *i_pPipeline, CPipelineStageOptions i_oOptions)
+                : m_pPipeline(i_pPipeline), m_oOptions(std::move(i_oOptions)), m_pPrevious(nullptr), m_pNext(nullptr),
+                  m_nQueued(0), m_nReserved(0), m_nActive(0), m_nNextTicket(0), m_nCommitTicket(0),
+                  m_nProcessed(0), m_nEmitted(0), m_nBatches(0), m_nBusyNs(0),
+                  m_fIsUpstreamDone(false), m_fIsUpstreamWaiting(false), m_fIsFinished(false) {
+        }
+
+        /// @brief Virtual destructor.
+        virtual ~CPipelineNode() = default;
+
+        /// @brief Deleted copy constructor.
+        CPipelineNode(const CPipelineNode &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CPipelineNode &operator=(const CPipelineNode &) = delete;
+
+    public:
+        /// @brief Starts pool tasks for the queued items as far as parallelism and downstream room allow,
+        /// and finishes the stage once its input is exhausted.
+        virtual void schedule() = 0;
+
+        /// @brief Marks the input of the stage as complete, the stage finishes after its queued items.
+        void close();
+
+        /// @brief Reserves room in the input channel for a batch of the previous stage.
+        /// If there is no room, the previous stage is scheduled again as soon as room is freed.
+        /// @param i_nCount The number of items wanted.
+        /// @return The number of reserved slots, at most i_nCount.
+        size_t reserve(size_t i_nCount);
+
+        /// @brief Returns a snapshot of the counters of the stage.
+        /// @return The snapshot.
+        CPipelineStageMetrics metrics();
+
+    protected:
+        /// @brief Returns the number of free slots of the input channel, must be called with the lock held.
+        /// @return The number of slots.
+        size_t freeSlots() const {
+            const size_t nUsed = this->m_nQueued + this->m_nReserved;
+            return nUsed < this->m_oOptions.capacity() ? this->m_oOptions.capacity() - nUsed : 0;
+        }
+
+        /// @brief Wakes the previous stage, or the threads blocked in CPipeline::push() for the first stage.
+        /// Must be called without a lock held.
+        virtual void notifyUpstream() = 0;
+
+        /// @brief Passes the end of the input on to the next stage, or completes the pipeline after the last stage.
+        void finishStage();
+
+        /// @brief Checks if the calling thread is a worker of the pool running the pipeline.
+        /// @return True if the thread must not block on a full channel, the stages may need it to make room.
+        bool isPoolWorker() const;
+
+        /// @brief Records a processed batch, must be called with the lock held.
+        /// @param i_nProcessed The number of items taken from the channel.
+        /// @param i_nEmitted The number of items passed on.
+        /// @param i_nBusyNs The run time of the batch in nanoseconds.
+        void recordBatch(const size_t i_nProcessed, const size_t i_nEmitted, const uint64_t i_nBusyNs) {
+            this->m_nProcessed += i_nProcessed;
+            this->m_nEmitted += i_nEmitted;
+            this->m_nBatches++;
+            this->m_nBusyNs += i_nBusyNs;
+        }
+
+    protected:
+        /// @var CPipelineBase *m_pPipeline
+        /// @brief The pipeline owning the node.
+        CPipelineBase *m_pPipeline;
+
+        /// @var CPipelineStageOptions m_oOptions
+        /// @brief The options of the stage.
+        CPipelineStageOptions m_oOptions;
+
+        /// @var CPipelineNode *m_pPrevious
+        /// @brief The previous stage, nullptr for the first stage.
+        CPipelineNode *m_pPrevious;
+
+        /// @var CPipelineNode *m_pNext
+        /// @brief The next stage, nullptr for the sink.
+        CPipelineNode *m_pNext;
+
+        /// @var CMutex m_oMutex
+        /// @brief Protects the channel, the scheduling state and the counters.
+        CMutex m_oMutex;
+
+        /// @var size_t m_nQueued
+        /// @brief The number of items waiting in the channel.
+        size_t m_nQueued;
+
+        /// @var size_t m_nReserved
+        /// @brief The number of slots reserved by batches of the previous stage.
+        size_t m_nReserved;
+
+        /// @var size_t m_nActive
+        /// @brief The number of batches being processed.
+        size_t m_nActive;
+
+        /// @var uint64_t m_nNextTicket
+        /// @brief The ticket of the next batch taken from the channel.
+        uint64_t m_nNextTicket;
+
+        /// @var uint64_t m_nCommitTicket
+        /// @brief The ticket of the next batch an ordered stage passes on.
+        uint64_t m_nCommitTicket;
+
+        /// @var uint64_t m_nProcessed
+        /// @brief The number of processed items.
+        uint64_t m_nProcessed;
+
+        /// @var uint64_t m_nEmitted
+        /// @brief The number of items passed on.
+        uint64_t m_nEmitted;
+
+        /// @var uint64_t m_nBatches
+        /// @brief The number of processed batches.
+        uint64_t m_nBatches;
+
+        /// @var uint64_t m_nBusyNs
+        /// @brief The summed run time of the batches in nanoseconds.
+        uint64_t m_nBusyNs;
+
+        /// @var bool m_fIsUpstreamDone
+        /// @brief Whether no more items will arrive.
+        bool m_fIsUpstreamDone;
+
+        /// @var bool m_fIsUpstreamWaiting
+        /// @brief Whether the previous stage or a pusher found the channel full.
+        bool m_fIsUpstreamWaiting;
+
+        /// @var bool m_fIsFinished
+        /// @brief Whether the stage has processed all of its input.
+        bool m_fIsFinished;
+    };
+
+    /// @class Devel::Threading::CPipelineInput<T>
+    /// @brief The typed input channel of a pipeline stage.
+    /// @tparam T The item type of the channel.
+    template<typename T>
+    class CPipelineInput : public CPipelineNode {
+    public:
+        using CPipelineNode::CPipelineNode;
+
+    public:
+        /// @brief Adds an item from outside of the pipeline, blocking while the channel is full.
+        /// A worker of the pool running the pipeline never blocks, it gets false for a full channel like tryPush().
+        /// @param i_tItem The item, left untouched if it was not added.
+        /// @return False if the input was closed, the pipeline failed, or the channel is full on a worker of the pool.
+        bool push(T &&i_tItem);
+
+        /// @brief Adds an item from outside of the pipeline if the channel has room.
+        /// @param i_tItem The item, left untouched if it was not added.
+        /// @return False if the channel is full, the input was closed or the pipeline failed.
+        bool tryPush(T &&i_tItem);
+
+        /// @brief Adds the results of a batch of the previous stage and releases its reservation.
+        /// Only the lock of this stage is taken, the caller schedules this stage afterwards.
+        /// @param i_atItems The results, at most as many as were reserved.
+        /// @param i_nReserved The number of slots the batch had reserved.
+        void commit(std::vector<T> &&i_atItems, const size_t i_nReserved) {
+            RecursiveLockGuard(this->m_oMutex);
+            for (T &tItem: i_atItems) {
+                this->m_atItems.push_back(std::move(tItem));
+            }
+            this->m_nQueued += i_atItems.size();
+            this->m_nReserved -= i_nReserved;
+        }
+
+    protected:
+        /// @brief Wakes the previous stage, or the threads blocked in push() for the first stage.
+        void notifyUpstream() override {
+            if (this->m_pPrevious) {
+                this->m_pPrevious->schedule();
+            } else {
+                // Changed under the lock, a pusher reads the signal there before it waits on it
+                {
+                    RecursiveLockGuard(this->m_oMutex);
+                    this->m_nRoomSignal.fetch_add(1, std::memory_order_relaxed);
+                }
+                this->m_nRoomSignal.notify_all();
+            }
+        }
+
+    protected:
+        /// @var std::deque<T> m_atItems
+        /// @brief The queued items.
+        std::deque<T> m_atItems;
+
+        /// @var std::atomic<uint32_t> m_nRoomSignal
+        /// @brief Incremented when the first stage may have room for pushed items, the threads in push() wait on it.
+        std::atomic<uint32_t> m_nRoomSignal = 0;
+    };
+
+    /// @class Devel::Threading::CPipelineResult<T>
+    /// @brief Maps the result type of a stage function to the item type of the next channel.
+    /// A function returning std::optional<T> filters, empty results are dropped.
+    /// @tparam T The result type of the stage function.
+    template<typename T>
+    class CPipelineResult {
+    public:
+        /// @typedef Type
+        /// @brief The item type of the next channel.
+        typedef T Type;
+
+        /// @var static constexpr bool IsFilter
+        /// @brief Whether the stage function filters.
+        static constexpr bool IsFilter = false;
+    };
+
+    /// @class Devel::Threading::CPipelineResult<std::optional<T>>
+    /// @brief The result mapping of a filtering stage function.
+    /// @tparam T The item type of the next channel.
+    template<typename T>
+    class CPipelineResult<std::optional<T>> {
+    public:
+        /// @typedef Type
+        /// @brief The item type of the next channel.
+        typedef T Type;
+
+        /// @var static constexpr bool IsFilter
+        /// @brief Whether the stage function filters.
+        static constexpr bool IsFilter = true;
+    };
+
+    /// @class Devel::Threading::CPipelineBase
+    /// @brief The untyped part of a CPipeline: the pool, the stages and the completion state.
+    class CPipelineBase {
+        friend class CPipelineNode;
+
+        template<typename TIn, typename TCurrent>
+        friend class CPipelineBuilder;
+
+        template<typename TIn, typename TOut, typename F>
+        friend class CPipelineStage;
+
+    public:
+        /// @brief Constructs a pipeline without stages.
+        /// @param i_pPool The thread pool running the stages.
+        explicit CPipelineBase(CThreadPool *i_pPool)
+                : m_pPool(i_pPool), m_nStartNs(CPipelineBase::now()), m_nFinishNs(0), m_nFinishSignal(0), m_nRunningTasks(0),
+                  m_fHasFailed(false), m_fIsFinished(false) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CPipelineBase(const CPipelineBase &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CPipelineBase &operator=(const CPipelineBase &) = delete;
+
+    public:
+        /// @brief Marks the input as complete, the pipeline finishes after the queued items.
+        void close() {
+            this->m_apNodes.front()->close();
+        }
+
+        /// @brief Blocks until every item has left the last stage.
+        /// The input has to be closed before, or by another thread.
+        /// The first exception thrown by a stage is rethrown, items after the failure are dropped.
+        void wait();
+
+        /// @brief Collects a snapshot of the counters of every stage, in pipeline order.
+        /// @return The snapshots.
+        std::vector<CPipelineStageMetrics> metrics() const;
+
+    public:
+        /// @brief Checks if every item has left the last stage.
+        /// @return True if the pipeline has finished.
+        bool isFinished() const {
+            RecursiveLockGuard(this->m_oMutex);
+            return this->m_fIsFinished;
+        }
+
+        /// @brief Checks if a stage has thrown.
+        /// @return True if the pipeline failed.
+        bool hasFailed() const { return this->m_fHasFailed.load(std::memory_order_acquire); }
+
+    protected:
+        /// @brief Records the exception of a stage, the pipeline drops the remaining items.
+        /// @param i_pException The exception.
+        void fail(std::exception_ptr i_pException);
+
+        /// @brief Marks the pipeline as finished and wakes the threads in wait().
+        void finish();
+
+        /// @brief Counts a pool task of a stage, wait() returns only after every task has returned.
+        void retainTask() {
+            RecursiveLockGuard(this->m_oMutex);
+            this->m_nRunningTasks++;
+        }
+
+        /// @brief Releases a pool task of a stage, it must not touch the pipeline afterwards.
+        void releaseTask();
+
+        /// @brief Returns the elapsed time of the pipeline.
+        /// @return The time since the pipeline was built, until it finished, in nanoseconds.
+        uint64_t elapsedNs() const;
+
+        /// @brief Returns the current time for the stage counters.
+        /// @return The time in nanoseconds.
+        static uint64_t now() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+    protected:
+        /// @var CThreadPool *m_pPool
+        /// @brief The thread pool running the stages.
+        CThreadPool *m_pPool;
+
+        /// @var std::vector<std::unique_ptr<CPipelineNode>> m_apNodes
+        /// @brief The stages in pipeline order.
+        std::vector<std::unique_ptr<CPipelineNode>> m_apNodes;
+
+        /// @var uint64_t m_nStartNs
+        /// @brief The time the pipeline was built.
+        uint64_t m_nStartNs;
+
+        /// @var uint64_t m_nFinishNs
+        /// @brief The time the pipeline finished, 0 while it runs.
+        uint64_t m_nFinishNs;
+
+        /// @var CMutex m_oMutex
+        /// @brief Protects the completion state.
+        CMutex m_oMutex;
+
+        /// @var std::atomic<uint32_t> m_nFinishSignal
+        /// @brief Incremented with m_oMutex held when the pipeline may have finished, the threads in wait() wait on it.
+        std::atomic<uint32_t> m_nFinishSignal;
+
+        /// @var size_t m_nRunningTasks
+        /// @brief The number of pool tasks of the stages which have not returned yet.
+        size_t m_nRunningTasks;
+
+        /// @var std::exception_ptr m_pException
+        /// @brief The first exception thrown by a stage.
+        std::exception_ptr m_pException;
+
+        /// @var std::atomic<bool> m_fHasFailed
+        /// @brief Whether a stage has thrown.
+        std::atomic<bool> m_fHasFailed;
+
+        /// @var bool m_fIsFinished
+        /// @brief Whether every item has left the last stage.
+        bool m_fIsFinished;
+    };
+
+    /// @class Devel::Threading::CPipelineStage<TIn, TOut, F>
+    /// @brief A stage of a pipeline running its function on batches of its input channel.
+    /// @tparam TIn The item type of the input channel.
+    /// @tparam TOut The item type of the next channel, void for the sink.
+    /// @tparam F The stage function.
+    template<typename TIn, typename TOut, typename F>
+    class CPipelineStage : public CPipelineInput<TIn> {
+    public:
+        /// @brief Constructs a stage.
+        /// @param i_pPipeline The pipeline owning the stage.
+        /// @param i_oOptions The options of the stage.
+        /// @param i_fnStage The stage function, called concurrently if the parallelism is above 1.
+        CPipelineStage(CPipelineBase *i_pPipeline, CPipelineStageOptions i_oOptions, F i_fnStage)
+                : CPipelineInput<TIn>(i_pPipeline, std::move(i_oOptions)), m_fnStage(std::move(i_fnStage)) {
+        }
+
+    public:
+        /// @brief Starts pool tasks for the queued items as far as parallelism and downstream room allow.
+        void schedule() override;
+
+    private:
+        /// @brief Processes a batch on a worker of the pool and passes the results on.
+        /// @param i_atBatch The items.
+        /// @param i_nTicket The ticket of the batch, defining its position in an ordered stage.
+        /// @param i_nReserved The number of slots reserved in the next channel.
+        void run(std::vector<TIn> &i_atBatch, uint64_t i_nTicket, size_t i_nReserved);
+
+        /// @brief Returns the next stage.
+        /// @return The typed input channel of the next stage.
+        CPipelineInput<TOut> *next() const {
+            return static_cast<CPipelineInput<TOut> *>(this->m_pNext);
+        }
+
+    private:
+        /// @typedef TPending
+        /// @brief The results of a batch of an ordered stage waiting for the batches before it, with its reservation.
+        typedef std::pair<std::vector<std::conditional_t<std::is_void_v<TOut>, char, TOut>>, size_t> TPending;
+
+        /// @var F m_fnStage
+        /// @brief The stage function.
+        F m_fnStage;
+
+        /// @var std::map<uint64_t, TPending> m_aoPending
+        /// @brief The finished batches of an ordered stage by ticket, protected by m_oMutex.
+        std::map<uint64_t, TPending> m_aoPending;
+    };
+
+    /// @class Devel::Threading::CPipeline<TIn>
+    /// @brief A multi-stage pipeline with bounded channels between the stages, running on a CThreadPool.
+    ///
+    /// Items pushed into the pipeline flow through the stages in batches. Every stage has a bounded input channel,
+    /// a parallelism and a batch size. A stage only takes a batch from its channel after it reserved room for the
+    /// results in the channel of the next stage. A slow stage therefore stalls the stages before it, and finally
+    /// push() blocks. The memory of the pipeline stays bounded and no worker of the pool ever blocks. Ordered
+    /// stages pass their results on in input order even with a parallelism above 1, unordered stages pass every
+    /// batch on as soon as it is done.
+    ///
+    /// Every stage counts its processed items, batches and busy time, see metrics().
+    /// push() never blocks a worker of the pool running the pipeline, it returns false for a full channel there.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CThreadPool pool(8);
+    ///     pool.execute();
+    ///
+    ///     auto pipeline = Devel::Threading::CPipelineBuilder<std::string>(pool)
+    ///             .stage([](std::string line) { return decode(line); },
+    ///                    Devel::Threading::CPipelineStageOptions().setName("decode").setParallelism(4))
+    ///             .stage([](Record record) -> std::optional<Record> {
+    ///                 return record.isValid() ? std::optional<Record>(transform(record)) : std::nullopt;
+    ///             }, Devel::Threading::CPipelineStageOptions().setName("transform").setParallelism(4))
+    ///             .sink([&file](Record record) { file.write(record); },
+    ///                   Devel::Threading::CPipelineStageOptions().setName("write").setBatchSize(64));
+    ///
+    ///     while (reader.readLine(line)) {
+    ///         pipeline->push(std::move(line));   // blocks while the pipeline is full
+    ///     }
+    ///     pipeline->close();
+    ///     pipeline->wait();
+    /// @endcode
+    ///
+    /// @tparam TIn The item type pushed into the pipeline.
+    template<typename TIn>
+    class CPipeline : public CPipelineBase {
+    public:
+        using CPipelineBase::CPipelineBase;
+
+        /// @brief Destructor, closes the input and waits for the queued items.
+        ~CPipeline() {
+            if (!this->m_apNodes.empty()) {
+                this->close();
+                try {
+                    this->wait();
+                } catch (...) {}
+            }
+        }
+
+    public:
+        /// @brief Adds an item, blocking while the channel of the first stage is full.
+        /// Called from a worker of the pool it returns false instead of blocking, the stages may need that worker.
+        /// @param i_tItem The item.
+        /// @return False if the input was closed, the pipeline failed, or the channel is full on a worker of the pool.
+        /// The item is dropped then.
+        bool push(TIn i_tItem) {
+            return this->input()->push(std::move(i_tItem));
+        }
+
+        /// @brief Adds an item if the channel of the first stage has room.
+        /// @param i_tItem The item, left untouched if it was not added.
+        /// @return False if the channel is full, the input was closed or the pipeline failed.
+        bool tryPush(TIn &&i_tItem) {
+            return this->input()->tryPush(std::move(i_tItem));
+        }
+
+    private:
+        /// @brief Returns the first stage.
+        /// @return The typed input channel of the first stage.
+        CPipelineInput<TIn> *input() const {
+            return static_cast<CPipelineInput<TIn> *>(this->m_apNodes.front().get());
+        }
+    };
+
+    /// @class Devel::Threading::CPipelineBuilder<TIn, TCurrent>
+    /// @brief Declares the stages of a CPipeline, the item type changes with every stage.
+    ///
+    /// A stage function takes an item and returns the item of the next stage, or a std::optional of it to filter.
+    /// The last stage is added with sink(), which builds the pipeline. A builder can build several pipelines.
+    ///
+    /// @tparam TIn The item type pushed into the pipeline.
+    /// @tparam TCurrent The item type the next stage receives.
+    template<typename TIn, typename TCurrent = TIn>
+    class CPipelineBuilder {
+        template<typename TOtherIn, typename TOtherCurrent>
+        friend class CPipelineBuilder;
+
+    public:
+        /// @typedef StageFactory
+        /// @brief Creates a stage of a pipeline.
+        typedef std::function<std::unique_ptr<CPipelineNode>(CPipelineBase *)> StageFactory;
+
+    public:
+        /// @brief Constructs a builder without stages.
+        /// @param i_oPool The thread pool running the stages.
+        explicit CPipelineBuilder(CThreadPool &i_oPool)
+                : m_pPool(&i_oPool) {
+        }
+
+    public:
+        /// @brief Adds a stage.
+        /// @param i_fnStage The stage function, taking a TCurrent. It returns the item of the next stage, or a
+        /// std::optional of it to drop items. It is called concurrently if the parallelism is above 1.
+        /// @param i_oOptions The options of the stage.
+        /// @return The builder for the next stage.
+        template<typename F>
+        auto stage(F &&i_fnStage, CPipelineStageOptions i_oOptions = CPipelineStageOptions()) const {
+            typedef std::invoke_result_t<std::decay_t<F> &, TCurrent> TResult;
+            typedef typename CPipelineResult<TResult>::Type TNext;
+            static_assert(!std::is_void_v<TResult>, "The last stage is added with sink()");
+
+            CPipelineBuilder<TIn, TNext> oNext(*this->m_pPool);
+            oNext.m_afnStages = this->m_afnStages;
+            oNext.m_afnStages.push_back([fnStage = std::decay_t<F>(std::forward<F>(i_fnStage)),
+                                                oOptions = std::move(i_oOptions)](CPipelineBase *i_pPipeline) {
+                return std::unique_ptr<CPipelineNode>(
+                        new CPipelineStage<TCurrent, TNext, std::decay_t<F>>(i_pPipeline, oOptions, fnStage));
+            });
+            return oNext;
+        }
+
+        /// @brief Adds the last stage and builds the pipeline.
+        /// @param i_fnSink The sink function, taking a TCurrent. It is called concurrently if the parallelism is above 1.
+        /// @param i_oOptions The options of the sink.
+        /// @return The pipeline, ready for push().
+        template<typename F>
+        std::unique_ptr<CPipeline<TIn>> sink(F &&i_fnSink, CPipelineStageOptions i_oOptions = CPipelineStageOptions()) const {
+            auto pPipeline = std::make_unique<CPipeline<TIn>>(this->m_pPool);
+
+            for (const StageFactory &fnStage: this->m_afnStages) {
+                pPipeline->m_apNodes.push_back(fnStage(pPipeline.get()));
+            }
+            pPipeline->m_apNodes.push_back(std::make_unique<CPipelineStage<TCurrent, void, std::decay_t<F>>>(
+                    pPipeline.get(), std::move(i_oOptions), std::decay_t<F>(std::forward<F>(i_fnSink))));
+
+            for (size_t i = 0; i < pPipeline->m_apNodes.size(); i++) {
+                CPipelineNode *pNode = pPipeline->m_apNodes[i].get();
+                pNode->m_pPrevious = i > 0 ? pPipeline->m_apNodes[i - 1].get() : nullptr;
+                pNode->m_pNext = i + 1 < pPipeline->m_apNodes.size() ? pPipeline->m_apNodes[i + 1].get() : nullptr;
+                if (pNode->m_oOptions.name().empty()) {
+                    pNode->m_oOptions.setName("stage-" + std::to_string(i));
+                }
+            }
+
+            return pPipeline;
+        }
+
+    private:
+        /// @var CThreadPool *m_pPool
+        /// @brief The thread pool running the stages.
+        CThreadPool *m_pPool;
+
+        /// @var std::vector<StageFactory> m_afnStages
+        /// @brief The factories of the stages added so far.
+        std::vector<StageFactory> m_afnStages;
+    };
+
+    template<typename T>
+    bool CPipelineInput<T>::push(T &&i_tItem) {
+        while (true) {
+            uint32_t nSignal;
+            {
+                RecursiveLockGuard(this->m_oMutex);
+                if (this->m_fIsUpstreamDone || this->m_pPipeline->hasFailed()) {
+                    return false;
+                }
+
+                if (this->freeSlots() != 0) {
+                    this->m_atItems.push_back(std::move(i_tItem));
+                    this->m_nQueued++;
+                    break;
+                }
+
+                // The batches making room may be queued behind a worker of the pool, it must not wait for them
+                if (this->isPoolWorker()) {
+                    return false;
+                }
+
+                this->m_fIsUpstreamWaiting = true;
+                nSignal = this->m_nRoomSignal.load(std::memory_order_relaxed);
+            }
+
+            // The lock is not held while waiting, so the profiler only counts the time spent in the channel
+            this->m_nRoomSignal.wait(nSignal, std::memory_order_acquire);
+        }
+
+        this->schedule();
+        return true;
+    }
+
+    template<typename T>
+    bool CPipelineInput<T>::tryPush(T &&i_tItem) {
+        {
+            RecursiveLockGuard(this->m_oMutex);
+            if (this->freeSlots() == 0 || this->m_fIsUpstreamDone || this->m_pPipeline->hasFailed()) {
+                return false;
+            }
+
+            this->m_atItems.push_back(std::move(i_tItem));
+            this->m_nQueued++;
+        }
+
+        this->schedule();
+        return true;
+    }
+
+    template<typename TIn, typename TOut, typename F>
+    void CPipelineStage<TIn, TOut, F>::schedule() {
+        std::vector<std::vector<TIn>> aatBatches;
+        std::vector<std::pair<uint64_t, size_t>> aoTickets;
+        bool fHasFreedRoom = false;
+        bool fHasFinished = false;
+
+        {
+            RecursiveLockGuard(this->m_oMutex);
+            while (this->m_nActive < this->m_oOptions.parallelism() && this->m_nQueued != 0) {
+                size_t nCount = std::min(this->m_oOptions.batchSize(), this->m_nQueued);
+                if constexpr (!std::is_void_v<TOut>) {
+                    // Lock order is always this stage, then the next stage
+                    nCount = this->next()->reserve(nCount);
+                    if (nCount == 0) {
+                        break;
+                    }
+                }
+
+                std::vector<TIn> atBatch;
+                atBatch.reserve(nCount);
+                for (size_t i = 0; i < nCount; i++) {
+                    atBatch.push_back(std::move(this->m_atItems.front()));
+                    this->m_atItems.pop_front();
+                }
+                this->m_nQueued -= nCount;
+                this->m_nActive++;
+
+                aatBatches.push_back(std::move(atBatch));
+                aoTickets.emplace_back(this->m_nNextTicket++, std::is_void_v<TOut> ? 0 : nCount);
+            }
+
+            if (!aatBatches.empty() && this->m_fIsUpstreamWaiting) {
+                this->m_fIsUpstreamWaiting = false;
+                fHasFreedRoom = true;
+            }
+
+            if (!this->m_fIsFinished && this->m_fIsUpstreamDone && this->m_nQueued == 0 && this->m_nActive == 0) {
+                this->m_fIsFinished = true;
+                fHasFinished = true;
+            }
+        }
+
+        // A full bounded pool queue runs tasks inline, so they are only added after the lock is released
+        for (size_t i = 0; i < aatBatches.size(); i++) {
+            this->m_pPipeline->retainTask();
+            this->m_pPipeline->m_pPool->addTask([this, atBatch = std::move(aatBatches[i]), oTicket = aoTickets[i]]() mutable {
+                this->run(atBatch, oTicket.first, oTicket.second);
+                this->m_pPipeline->releaseTask();
+            });
+        }
+
+        if (fHasFreedRoom) {
+            this->notifyUpstream();
+        }
+        if (fHasFinished) {
+            this->finishStage();
+        }
+    }
+
+    template<typename TIn, typename TOut, typename F>
+    void CPipelineStage<TIn, TOut, F>::run(std::vector<TIn> &i_atBatch, const uint64_t i_nTicket,
+                                           const size_t i_nReserved) {
+        typedef std::conditional_t<std::is_void_v<TOut>, char, TOut> TResult;
+        std::vector<TResult> atResults;
+        const uint64_t nStartNs = CPipelineBase::now();
+
+        // After a failure the remaining items are drained without running the stage functions
+        if (!this->m_pPipeline->hasFailed()) {
+            try {
+                if constexpr (std::is_void_v<TOut>) {
+                    for (TIn &tItem: i_atBatch) {
+                        std::invoke(this->m_fnStage, std::move(tItem));
+                    }
+                } else {
+                    atResults.reserve(i_atBatch.size());
+                    for (TIn &tItem: i_atBatch) {
+                        if constexpr (CPipelineResult<std::invoke_result_t<F &, TIn>>::IsFilter) {
+                            auto oResult = std::invoke(this->m_fnStage, std::move(tItem));
+                            if (oResult) {
+                                atResults.push_back(std::move(*oResult));
+                            }
+                        } else {
+                            atResults.push_back(std::invoke(this->m_fnStage, std::move(tItem)));
+                        }
+                    }
+                }
+            } catch (...) {
+                atResults.clear();
+                this->m_pPipeline->fail(std::current_exception());
+            }
+        }
+
+        const uint64_t nBusyNs = CPipelineBase::now() - nStartNs;
+        const size_t nEmitted = std::is_void_v<TOut> ? 0 : atResults.size();
+
+        if constexpr (!std::is_void_v<TOut>) {
+            if (this->m_oOptions.order() == CPipelineStageOptions::EUnordered) {
+                // Committed before the batch counts as done, so the next stage can not finish early
+                this->next()->commit(std::move(atResults), i_nReserved);
+            }
+        }
+
+        {
+            RecursiveLockGuard(this->m_oMutex);
+            if constexpr (!std::is_void_v<TOut>) {
+                if (this->m_oOptions.order() == CPipelineStageOptions::EOrdered) {
+                    // Batches are passed on by ticket, a batch finishing early waits for the ones before it
+                    this->m_aoPending.emplace(i_nTicket, TPending(std::move(atResults), i_nReserved));
+                    auto itPending = this->m_aoPending.begin();
+                    while (itPending != this->m_aoPending.end() && itPending->first == this->m_nCommitTicket) {
+                        this->next()->commit(std::move(itPending->second.first), itPending->second.second);
+                        this->m_nCommitTicket++;
+                        itPending = this->m_aoPending.erase(itPending);
+                    }
+                }
+            }
+
+            this->recordBatch(i_atBatch.size(), nEmitted, nBusyNs);
+            this->m_nActive--;
+        }
+
+        if constexpr (!std::is_void_v<TOut>) {
+            this->m_pNext->schedule();
+        }
+        this->schedule();
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CPoolAllocator<T>
+    /// @brief A thread-safe free-list allocator for objects of type T.
+    ///
+    /// Released blocks are kept in a small thread-local cache and reused by the next allocation on the same thread,
+    /// so the typical allocate/release cycle never reaches the global heap. When a thread cache overflows,
+    /// blocks are moved to a shared free list which is protected by a mutex.
+    ///
+    /// @tparam T The type of the objects the memory is allocated for.
+    ///
+    /// <b>Example</b>
+    ///
+    /// The allocator is usually used through class specific new and delete operators:
+    /// @code{.cpp}
+    ///     class CNode {
+    ///     public:
+    ///         static void *operator new(size_t) { return Devel::Threading::CPoolAllocator<CNode>::allocate(); }
+    ///         static void operator delete(void *i_pBlock) { Devel::Threading::CPoolAllocator<CNode>::deallocate(i_pBlock); }
+    ///     };
+    /// @endcode
+    template<typename T>
+    class CPoolAllocator {
+    private:
+        /// @var static constexpr size_t LocalCacheSize
+        /// @brief The maximum number of blocks kept in a thread-local cache.
+        static constexpr size_t LocalCacheSize = 64;
+
+        /// @var static constexpr size_t GlobalCacheSize
+        /// @brief The maximum number of blocks kept in the shared free list.
+        static constexpr size_t GlobalCacheSize = 4096;
+
+        /// @class CFreeList
+        /// @brief A list of free blocks which releases its blocks when it is destroyed.
+        class CFreeList {
+        public:
+            /// @brief Destructor, releases all blocks to the heap.
+            ~CFreeList() {
+                for (void *pBlock: this->m_apBlocks) {
+                    ::operator delete(pBlock, std::align_val_t(alignof(T)));
+                }
+            }
+
+        public:
+            /// @var std::vector<void *> m_apBlocks
+            /// @brief The free blocks.
+            std::vector<void *> m_apBlocks;
+        };
+
+    public:
+        /// @brief Allocates uninitialized memory for one object of type T.
+        /// @return The allocated memory.
+        static void *allocate() {
+            CFreeList &oLocal = CPoolAllocator::localList();
+            if (!oLocal.m_apBlocks.empty()) {
+                void *pBlock = oLocal.m_apBlocks.back();
+                oLocal.m_apBlocks.pop_back();
+                return pBlock;
+            }
+
+            {
+                std::lock_guard<std::mutex> oLock(CPoolAllocator::globalMutex());
+                CFreeList &oGlobal = CPoolAllocator::globalList();
+                if (!oGlobal.m_apBlocks.empty()) {
+                    void *pBlock = oGlobal.m_apBlocks.back();
+                    oGlobal.m_apBlocks.pop_back();
+                    return pBlock;
+                }
+            }
+
+            return ::operator new(sizeof(T), std::align_val_t(alignof(T)));
+        }
+
+        /// @brief Releases memory previously returned by allocate().
+        /// @param i_pBlock The memory to release.
+        static void deallocate(void *i_pBlock) {
+            if (!i_pBlock) {
+                return;
+            }
+
+            CFreeList &oLocal = CPoolAllocator::localList();
+            if (oLocal.m_apBlocks.size() < LocalCacheSize) {
+                oLocal.m_apBlocks.push_back(i_pBlock);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> oLock(CPoolAllocator::globalMutex());
+                CFreeList &oGlobal = CPoolAllocator::globalList();
+                if (oGlobal.m_apBlocks.size() < GlobalCacheSize) {
+                    oGlobal.m_apBlocks.push_back(i_pBlock);
+                    return;
+                }
+            }
+
+            ::operator delete(i_pBlock, std::align_val_t(alignof(T)));
+        }
+
+    private:
+        /// @brief Returns the free list of the calling thread.
+        /// @return The thread-local free list.
+        static CFreeList &localList() {
+            static thread_local CFreeList s_oLocal;
+            return s_oLocal;
+        }
+
+        /// @brief Returns the free list shared by all threads.
+        /// @return The shared free list.
+        static CFreeList &globalList() {
+            static CFreeList s_oGlobal;
+            return s_oGlobal;
+        }
+
+        /// @brief Returns the mutex protecting the shared free list.
+        /// @return The mutex.
+        static std::mutex &globalMutex() {
+            static std::mutex s_oMutex;
+            return s_oMutex;
+        }
+    };
+}
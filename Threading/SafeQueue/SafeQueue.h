@@ -1,6 +1,9 @@
 #pragma once
 
+#include <iterator>
 #include <queue>
+#include <type_traits>
+#include <utility>
 
 #include "Threading/LockGuard/LockGuard.h"
 #include "Core/Typedef.h"
@@ -28,13 +31,18 @@
 /// @namespace Devel::Threading
 /// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
 namespace Devel::Threading {
-    /// @class Devel::Threading::CSafeQueue<T>
+    /// @class Devel::Threading::CSafeQueue<T, TLock>
     /// @brief A thread-safe implementation of a queue.
     ///
     /// This class provides a thread-safe queue implementation using std::queue internally.
     /// It allows multiple threads to enqueue and dequeue elements from the queue concurrently.
     ///
+    /// The lock type is a policy. The default is the recursive CMutex, short critical sections like
+    /// enqueue() and dequeue() do better with the non-recursive CFutexMutex or CSpinLock.
+    /// CNullLock removes the synchronization for single-threaded use.
+    ///
     /// @tparam T The type of elements stored in the queue.
+    /// @tparam TLock The lock type, e.g. CMutex, CFutexMutex, CSpinLock or CNullLock.
     ///
     /// <b>Example</b>
     ///
@@ -100,24 +108,26 @@ namespace Devel::Threading {
     /// return 0;
     /// }
     /// @endcode
-    template<class T>
+    template<class T, class TLock = CMutex>
     class CSafeQueue {
     public:
         /// @brief Returns a const reference to the mutex associated with the safe queue.
         /// @return The mutex object.
-        const CMutex &mutex() const {
+        const TLock &mutex() const {
             return this->m_oMutex;
         }
 
         /// @brief Returns the number of elements in the safe queue.
         /// @return The number of elements.
         size_t size() const {
+            RecursiveLockGuard(this->m_oMutex);
             return this->m_aQueue.size();
         }
 
         /// @brief Checks if the safe queue is empty.
         /// @return True if the safe queue is empty, false otherwise.
         bool isEmpty() const {
+            RecursiveLockGuard(this->m_oMutex);
             return this->m_aQueue.empty();
         }
 
@@ -136,38 +146,103 @@ namespace Devel::Threading {
             this->m_aQueue.push(std::move(i_tValue));
         }
 
+        /// @brief Enqueues all elements of a range into the safe queue, the lock is taken once.
+        /// The elements are moved if the range is passed as an rvalue, otherwise they are copied.
+        /// @param i_aRange The range of elements to enqueue.
+        template<typename R>
+        void enqueueBulk(R &&i_aRange) {
+            RecursiveLockGuard(this->m_oMutex);
+
+            for (auto &&tValue: i_aRange) {
+                if constexpr (std::is_lvalue_reference_v<R>) {
+                    this->m_aQueue.push(tValue);
+                } else {
+                    this->m_aQueue.push(std::move(tValue));
+                }
+            }
+        }
+
     public:
         /// @brief Dequeues and returns an element from the safe queue.
         /// @param i_fMove If true, the returned element is moved, otherwise a copy is made.
+        /// Move-only elements are always moved.
         /// @return The dequeued element.
         T dequeue(const bool i_fMove = true) {
             RecursiveLockGuard(this->m_oMutex);
 
-            T tValue = this->front(i_fMove);
-            this->pop();
+            if (this->m_aQueue.empty()) {
+                throw NoEntryFoundException;
+            }
+
+            T tValue = this->takeFront(i_fMove);
+            this->m_aQueue.pop();
 
             return tValue;
         }
 
+        /// @brief Dequeues an element from the safe queue if it is not empty.
+        /// Unlike dequeue() no exception is thrown for an empty queue.
+        /// @param i_tOutValue Receives the dequeued element on success.
+        /// @return True if an element was dequeued, false if the queue was empty.
+        bool tryDequeue(T &i_tOutValue) {
+            RecursiveLockGuard(this->m_oMutex);
+
+            if (this->m_aQueue.empty()) {
+                return false;
+            }
+
+            i_tOutValue = std::move(this->m_aQueue.front());
+            this->m_aQueue.pop();
+
+            return true;
+        }
+
+        /// @brief Dequeues up to i_nMaxCount elements into an output iterator, the lock is taken once.
+        /// @param i_itOut The output iterator receiving the moved elements.
+        /// @param i_nMaxCount The maximum number of elements to dequeue.
+        /// @return The number of dequeued elements.
+        template<typename OutputIt>
+        size_t dequeueBulk(OutputIt i_itOut, const size_t i_nMaxCount) {
+            RecursiveLockGuard(this->m_oMutex);
+
+            size_t nCount = 0;
+            for (; nCount < i_nMaxCount && !this->m_aQueue.empty(); nCount++) {
+                *i_itOut = std::move(this->m_aQueue.front());
+                ++i_itOut;
+                this->m_aQueue.pop();
+            }
+
+            return nCount;
+        }
+
+        /// @brief Swaps the content of the safe queue with another queue, the lock is taken once.
+        /// Passing an empty queue takes all elements out of the safe queue.
+        /// @param i_aQueue The queue to swap with.
+        void swapAll(std::queue<T> &i_aQueue) {
+            RecursiveLockGuard(this->m_oMutex);
+            this->m_aQueue.swap(i_aQueue);
+        }
+
     public:
-        /// @brief Returns a reference to the front element of the safe queue without removing it.
+        /// @brief Returns the front element of the safe queue without removing it.
+        /// Only available for copyable elements, move-only elements are taken with dequeue() or tryDequeue().
         /// @param i_fMove If true, the front element is moved, otherwise a copy is made.
-        /// @return The reference to the front element.
-        T front(const bool i_fMove = false) {
+        /// @return The front element.
+        T front(const bool i_fMove = false) requires std::is_copy_constructible_v<T> {
             RecursiveLockGuard(this->m_oMutex);
 
-            if (this->isEmpty()) {
+            if (this->m_aQueue.empty()) {
                 throw NoEntryFoundException;
             }
 
-            return (i_fMove ? std::move(this->m_aQueue.front()) : this->m_aQueue.front());
+            return this->takeFront(i_fMove);
         }
 
         /// @brief Removes the front element from the safe queue.
         void pop() {
             RecursiveLockGuard(this->m_oMutex);
 
-            if (this->isEmpty()) {
+            if (this->m_aQueue.empty()) {
                 throw NoEntryFoundException;
             }
 
@@ -176,13 +251,22 @@ namespace Devel::Threading {
 
         /// @brief Removes all elements from the safe queue.
         void clear() {
-            RecursiveLockGuard(this->m_oMutex);
+            std::queue<T> aQueue;
+            this->swapAll(aQueue);
+        }
 
-            try {
-                while (true) {
-                    this->pop();
+    private:
+        /// @brief Moves or copies the front element. The caller must hold the lock and ensure the queue is not empty.
+        /// @param i_fMove If true, the element is moved, otherwise a copy is made.
+        /// @return The front element.
+        T takeFront(const bool i_fMove) {
+            if constexpr (std::is_copy_constructible_v<T>) {
+                if (!i_fMove) {
+                    return this->m_aQueue.front();
                 }
-            } catch (const std::range_error &) {}
+            }
+
+            return std::move(this->m_aQueue.front());
         }
 
     private:
@@ -190,8 +274,8 @@ namespace Devel::Threading {
         /// @brief The underlying queuet.
         std::queue<T> m_aQueue;
 
-        /// @var CMutex m_oMutex
-        /// @brief The mutex used to synchronize access to the queue.
-        CMutex m_oMutex;
+        /// @var TLock m_oMutex
+        /// @brief The lock used to synchronize access to the queue.
+        TLock m_oMutex;
     };
 };
\ No newline at end of file
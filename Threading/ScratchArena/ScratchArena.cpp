@@ -0,0 +1,48 @@
+#include "ScratchArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+size_t Devel::Threading::CScratchArena::usedSize() const {
+    size_t nUsed = this->m_nOffset;
+    for (size_t i = 0; i < this->m_nChunk && i < this->m_aoChunks.size(); i++) {
+        nUsed += this->m_aoChunks[i].m_nSize;
+    }
+
+    return nUsed;
+}
+
+size_t Devel::Threading::CScratchArena::capacity() const {
+    size_t nCapacity = 0;
+    for (const CChunk &oChunk: this->m_aoChunks) {
+        nCapacity += oChunk.m_nSize;
+    }
+
+    return nCapacity;
+}
+
+void *Devel::Threading::CScratchArena::do_allocate(const size_t i_nSize, const size_t i_nAlignment) {
+    while (this->m_nChunk < this->m_aoChunks.size()) {
+        CChunk &oChunk = this->m_aoChunks[this->m_nChunk];
+        const uintptr_t nBase = reinterpret_cast<uintptr_t>(oChunk.m_pMemory.get());
+        const size_t nOffset = ((nBase + this->m_nOffset + i_nAlignment - 1) & ~(i_nAlignment - 1)) - nBase;
+
+        if (nOffset + i_nSize <= oChunk.m_nSize) {
+            this->m_nOffset = nOffset + i_nSize;
+            return oChunk.m_pMemory.get() + nOffset;
+        }
+
+        // The rest of the chunk is skipped, it is reused after the next reset()
+        this->m_nChunk++;
+        this->m_nOffset = 0;
+    }
+
+    // Chunks are allocated with the default new alignment, larger alignments are padded inside the chunk
+    const size_t nPadding = i_nAlignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? i_nAlignment : 0;
+    const size_t nChunkSize = std::max(CScratchArena::ChunkSize, i_nSize + nPadding);
+    this->m_aoChunks.push_back(CChunk{std::unique_ptr<unsigned char[]>(new unsigned char[nChunkSize]), nChunkSize});
+    this->m_nChunk = this->m_aoChunks.size() - 1;
+    this->m_nOffset = 0;
+
+    return this->do_allocate(i_nSize, i_nAlignment);
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CScratchArena
+    /// @brief A bump allocator for short-lived temporaries which keeps its memory between uses.
+    ///
+    /// Allocations advance an offset inside the current chunk and deallocations do nothing, all memory is
+    /// reclaimed at once by reset(). Unlike std::pmr::monotonic_buffer_resource the chunks are not returned to
+    /// the heap on reset(), so an arena which is reset after every task reaches a steady state without any
+    /// allocation. The arena is a std::pmr::memory_resource, std::pmr containers and strings can use it directly.
+    ///
+    /// The arena is not thread safe. CThreadPoolWorker::scratchArena() provides one arena per pool worker.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CScratchArena arena;
+    ///
+    ///     for (const Request &request: requests) {
+    ///         std::pmr::string path(&arena);
+    ///         path += request.directory();
+    ///         path += request.file();
+    ///         handle(path);
+    ///
+    ///         arena.reset();
+    ///     }
+    /// @endcode
+    class CScratchArena : public std::pmr::memory_resource {
+    public:
+        /// @var static constexpr size_t ChunkSize
+        /// @brief The size of a chunk, larger requests get a chunk of their own size.
+        static constexpr size_t ChunkSize = 64 * 1024;
+
+    public:
+        /// @brief Constructs an empty arena, the first chunk is allocated on the first request.
+        CScratchArena()
+                : m_nChunk(0), m_nOffset(0) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CScratchArena(const CScratchArena &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CScratchArena &operator=(const CScratchArena &) = delete;
+
+    public:
+        /// @brief Constructs an object inside the arena.
+        /// Destructors are never run, so only trivially destructible types are accepted.
+        /// @param i_aArgs The constructor arguments.
+        /// @return The object, valid until the next reset().
+        template<typename T, typename... Args>
+        T *make(Args &&... i_aArgs) {
+            static_assert(std::is_trivially_destructible_v<T>, "The arena does not run destructors");
+            return new(this->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(i_aArgs)...);
+        }
+
+        /// @brief Releases all allocations at once. The chunks are kept for the next allocations.
+        void reset() {
+            this->m_nChunk = 0;
+            this->m_nOffset = 0;
+        }
+
+        /// @brief Frees all chunks.
+        void release() {
+            this->m_aoChunks.clear();
+            this->reset();
+        }
+
+    public:
+        /// @brief Returns the number of bytes handed out since the last reset, including alignment padding.
+        /// @return The number of bytes.
+        size_t usedSize() const;
+
+        /// @brief Returns the total size of the chunks owned by the arena.
+        /// @return The number of bytes.
+        size_t capacity() const;
+
+    protected:
+        /// @brief Allocates memory from the current chunk, moving on to the next chunk if it does not fit.
+        /// @param i_nSize The number of bytes.
+        /// @param i_nAlignment The alignment.
+        /// @return The memory.
+        void *do_allocate(size_t i_nSize, size_t i_nAlignment) override;
+
+        /// @brief Does nothing, the memory is reclaimed by reset().
+        void do_deallocate(void *, size_t, size_t) override {}
+
+        /// @brief Two arenas are only equal if they are the same object.
+        /// @param i_oOther The other memory resource.
+        /// @return True if the other resource is this arena.
+        bool do_is_equal(const std::pmr::memory_resource &i_oOther) const noexcept override {
+            return this == &i_oOther;
+        }
+
+    private:
+        /// @class CChunk
+        /// @brief A block of memory owned by the arena.
+        class CChunk {
+        public:
+            /// @var std::unique_ptr<unsigned char[]> m_pMemory
+            /// @brief The memory of the chunk.
+            std::unique_ptr<unsigned char[]> m_pMemory;
+
+            /// @var size_t m_nSize
+            /// @brief The size of the chunk in bytes.
+            size_t m_nSize;
+        };
+
+    private:
+        /// @var std::vector<CChunk> m_aoChunks
+        /// @brief The chunks, filled in order.
+        std::vector<CChunk> m_aoChunks;
+
+        /// @var size_t m_nChunk
+        /// @brief The index of the chunk allocations are taken from.
+        size_t m_nChunk;
+
+        /// @var size_t m_nOffset
+        /// @brief The number of bytes used in the current chunk.
+        size_t m_nOffset;
+    };
+}
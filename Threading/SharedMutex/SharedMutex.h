@@ -0,0 +1,80 @@
+#pragma once
+
+#include <shared_mutex>
+
+#include "Threading/LockProfiler/ProfiledLock.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CSharedMutex
+    /// @brief A class for handling reader/writer mutexes.
+    ///
+    /// This class encapsulates a std::shared_mutex. Any number of readers can hold the shared lock at the same time,
+    /// while the exclusive lock is held by a single writer. Unlike CMutex the mutex is not recursive,
+    /// a thread must not lock it again while it already holds it.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CSharedMutex mutex;
+    ///     std::map<int, std::string> table;
+    ///
+    ///     std::string lookup(int key) {
+    ///         SharedLockGuard(mutex); // Readers do not block each other
+    ///         return table.at(key);
+    ///     }
+    ///
+    ///     void insert(int key, std::string value) {
+    ///         RecursiveLockGuard(mutex); // Writers are exclusive
+    ///         table[key] = std::move(value);
+    ///     }
+    /// @endcode
+    class CSharedMutex : public CProfiledLock {
+    public:
+        /// @brief Default constructor for CSharedMutex.
+        CSharedMutex() = default;
+
+        /// @brief Default virtual destructor for CSharedMutex.
+        virtual ~CSharedMutex() = default;
+
+    public:
+        /// @brief Acquires the exclusive lock, blocking until no reader or writer holds the mutex.
+        void lock() const {
+            return this->m_oMutex.lock();
+        }
+
+        /// @brief Releases the exclusive lock.
+        void unlock() const {
+            return this->m_oMutex.unlock();
+        }
+
+        /// @brief Attempts to acquire the exclusive lock without blocking.
+        /// @return True if the mutex was successfully locked, false otherwise.
+        bool tryLock() const {
+            return this->m_oMutex.try_lock();
+        }
+
+    public:
+        /// @brief Acquires the shared lock, blocking while a writer holds the mutex.
+        void lockShared() const {
+            return this->m_oMutex.lock_shared();
+        }
+
+        /// @brief Releases the shared lock.
+        void unlockShared() const {
+            return this->m_oMutex.unlock_shared();
+        }
+
+        /// @brief Attempts to acquire the shared lock without blocking.
+        /// @return True if the shared lock was acquired, false otherwise.
+        bool tryLockShared() const {
+            return this->m_oMutex.try_lock_shared();
+        }
+
+    private:
+        /// @var std::shared_mutex m_oMutex
+        /// @brief The reader/writer mutex instance managed by this class.
+        mutable std::shared_mutex m_oMutex;
+    };
+}
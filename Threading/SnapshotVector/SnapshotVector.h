@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Threading/LockGuard/LockGuard.h"
+#include "Threading/FutexMutex/FutexMutex.h"
+#include "Threading/MutexVector/MutexVector.h"
+#include "Core/Exceptions.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CSnapshotVector<T>
+    /// @brief A copy-on-write vector for read-mostly data, readers never take a lock.
+    ///
+    /// The elements live in an immutable std::vector owned by a std::shared_ptr. Every write copies the current
+    /// version, modifies the copy and publishes it with an atomic pointer swap (read-copy-update).
+    /// snapshot() returns the current version by reference count, it stays valid and unchanged for as long as the
+    /// reader holds it, no matter how many writes happen meanwhile. Old versions are freed by their last reader.
+    ///
+    /// Writers are serialized by a writer-only lock and pay a full copy per write, use update() to batch several
+    /// modifications into one copy. The container suits data which is iterated often and changed rarely,
+    /// for frequently written data use CMutexVector.
+    ///
+    /// @tparam T The type of elements stored in the vector.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CSnapshotVector<CRoute> routes;
+    ///
+    ///     // Reader threads, lock-free iteration of a consistent version
+    ///     for (const CRoute &route: *routes.snapshot()) {
+    ///         dispatch(route);
+    ///     }
+    ///
+    ///     // Writer thread, one copy for several modifications
+    ///     routes.update([](std::vector<CRoute> &aoRoutes) {
+    ///         aoRoutes.push_back(CRoute("a"));
+    ///         aoRoutes.push_back(CRoute("b"));
+    ///     });
+    /// @endcode
+    template<typename T>
+    class CSnapshotVector {
+    public:
+        /// @typedef Snapshot
+        /// @brief An immutable version of the vector.
+        typedef std::shared_ptr<const std::vector<T>> Snapshot;
+
+        /// @typedef FnMatch
+        /// @brief The matching condition of the search functions.
+        typedef std::function<bool(const T &)> FnMatch;
+
+    public:
+        /// @brief Constructs an empty vector.
+        CSnapshotVector()
+                : m_pVersion(std::make_shared<const std::vector<T>>()) {
+        }
+
+        /// @brief Constructs the vector from a std::vector.
+        /// @param i_atVector The initial elements.
+        explicit CSnapshotVector(std::vector<T> i_atVector)
+                : m_pVersion(std::make_shared<const std::vector<T>>(std::move(i_atVector))) {
+        }
+
+        /// @brief Constructs the vector from the current content of a CMutexVector.
+        /// @param i_atVector The CMutexVector to copy.
+        template<typename TLock>
+        explicit CSnapshotVector(const CMutexVector<T, TLock> &i_atVector)
+                : CSnapshotVector(i_atVector.toStdVector()) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CSnapshotVector(const CSnapshotVector &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CSnapshotVector &operator=(const CSnapshotVector &) = delete;
+
+    public:
+        /// @brief Returns the current version of the vector. The call never blocks on writers.
+        /// @return The immutable snapshot.
+        Snapshot snapshot() const {
+            return this->m_pVersion.load(std::memory_order_acquire);
+        }
+
+        /// @brief Returns the number of elements of the current version.
+        /// @return The number of elements.
+        size_t size() const {
+            return this->snapshot()->size();
+        }
+
+        /// @brief Checks if the current version is empty.
+        /// @return True if the vector is empty, false otherwise.
+        bool isEmpty() const {
+            return this->snapshot()->empty();
+        }
+
+        /// @brief Returns a copy of the element at the specified index of the current version.
+        /// @param i_nIndex The index of the element.
+        /// @return The element.
+        /// @throws IndexOutOfRangeException if the index is out of range.
+        T at(const size_t i_nIndex) const {
+            const Snapshot pVersion = this->snapshot();
+            if (i_nIndex >= pVersion->size()) {
+                throw IndexOutOfRangeException;
+            }
+
+            return (*pVersion)[i_nIndex];
+        }
+
+        /// @brief Checks if the current version contains the specified value.
+        /// @param i_oValue The value to check for.
+        /// @return True if the vector contains the value, false otherwise.
+        bool contains(const T &i_oValue) const {
+            for (const T &tValue: *this->snapshot()) {
+                if (tValue == i_oValue) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// @brief Finds the first element of the current version that matches the given condition.
+        /// @param i_fnMatch The matching condition.
+        /// @return The first matching element.
+        /// @throws NoEntryFoundException if no matching element is found.
+        T find(FnMatch i_fnMatch) const {
+            for (const T &tValue: *this->snapshot()) {
+                if (i_fnMatch(tValue)) {
+                    return tValue;
+                }
+            }
+
+            throw NoEntryFoundException;
+        }
+
+        /// @brief Finds all elements of the current version that match the given condition.
+        /// @param i_fnMatch The matching condition.
+        /// @return A vector containing all matching elements.
+        std::vector<T> findAll(FnMatch i_fnMatch) const {
+            std::vector<T> atData;
+            for (const T &tValue: *this->snapshot()) {
+                if (i_fnMatch(tValue)) {
+                    atData.push_back(tValue);
+                }
+            }
+
+            return atData;
+        }
+
+        /// @brief Converts the current version to a standard vector.
+        /// @return A copy of the elements.
+        std::vector<T> toStdVector() const {
+            return *this->snapshot();
+        }
+
+    public:
+        /// @brief Modifies a copy of the current version and publishes it as the new version.
+        /// @param i_fnUpdate The function receiving the mutable copy.
+        template<typename F>
+        void update(F &&i_fnUpdate) {
+            RecursiveLockGuard(this->m_oWriteMutex);
+
+            auto pVersion = std::make_shared<std::vector<T>>(*this->m_pVersion.load(std::memory_order_relaxed));
+            std::forward<F>(i_fnUpdate)(*pVersion);
+            this->m_pVersion.store(std::move(pVersion), std::memory_order_release);
+        }
+
+        /// @brief Appends an element.
+        /// @param i_oValue The value to append.
+        void push_back(T i_oValue) {
+            this->update([&i_oValue](std::vector<T> &i_atVector) { i_atVector.push_back(std::move(i_oValue)); });
+        }
+
+        /// @brief Appends several elements with a single copy.
+        /// @param i_atValue The values to append.
+        void push_back(const std::vector<T> &i_atValue) {
+            this->update([&i_atValue](std::vector<T> &i_atVector) {
+                i_atVector.insert(i_atVector.end(), i_atValue.begin(), i_atValue.end());
+            });
+        }
+
+        /// @brief Removes the element at the specified index.
+        /// @param i_nIndex The index of the element to remove.
+        /// @return True if the element was removed, false if the index is out of range.
+        bool removeAt(const size_t i_nIndex) {
+            bool fWasSuccessful = false;
+            this->update([&](std::vector<T> &i_atVector) {
+                if (i_nIndex < i_atVector.size()) {
+                    i_atVector.erase(i_atVector.begin() + i_nIndex);
+                    fWasSuccessful = true;
+                }
+            });
+
+            return fWasSuccessful;
+        }
+
+        /// @brief Removes all elements that match the given condition.
+        /// @param i_fnMatch The matching condition.
+        /// @return True if any elements were removed, false otherwise.
+        bool removeAll(FnMatch i_fnMatch) {
+            size_t nCount = 0;
+            this->update([&](std::vector<T> &i_atVector) {
+                nCount = std::erase_if(i_atVector, i_fnMatch);
+            });
+
+            return nCount != 0;
+        }
+
+        /// @brief Removes all elements.
+        void clear() {
+            this->assign(std::vector<T>());
+        }
+
+        /// @brief Replaces the content without copying the current version.
+        /// @param i_atVector The new elements.
+        void assign(std::vector<T> i_atVector) {
+            RecursiveLockGuard(this->m_oWriteMutex);
+            this->m_pVersion.store(std::make_shared<const std::vector<T>>(std::move(i_atVector)),
+                                   std::memory_order_release);
+        }
+
+    private:
+        /// @var std::atomic<Snapshot> m_pVersion
+        /// @brief The current version of the vector.
+        std::atomic<Snapshot> m_pVersion;
+
+        /// @var CFutexMutex m_oWriteMutex
+        /// @brief Serializes the writers, readers never take it.
+        CFutexMutex m_oWriteMutex;
+    };
+}
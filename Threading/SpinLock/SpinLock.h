@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "Threading/LockProfiler/ProfiledLock.h"
+#include "Threading/ThreadUtils.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CSpinLock
+    /// @brief An adaptive, non-recursive spinlock for very short critical sections.
+    ///
+    /// Waiting threads only read the lock flag (test-and-test-and-set), so the cache line is not bounced while
+    /// the lock is held. Between two attempts the pause doubles, up to MaxBackoff cpuRelax() calls. When the
+    /// backoff is exhausted the thread yields its time slice instead, so a preempted owner can make progress.
+    ///
+    /// Prefer CFutexMutex if the critical section may block or run long.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CSpinLock lock;
+    ///     size_t counter = 0;
+    ///
+    ///     void increment() {
+    ///         RecursiveLockGuard(lock);
+    ///         counter++;
+    ///     }
+    /// @endcode
+    class CSpinLock : public CProfiledLock {
+    public:
+        /// @var size_t MaxBackoff
+        /// @brief The maximum number of cpuRelax() calls between two attempts.
+        static constexpr size_t MaxBackoff = 64;
+
+    public:
+        /// @brief Default constructor for CSpinLock.
+        CSpinLock() = default;
+
+        /// @brief Deleted copy constructor.
+        CSpinLock(const CSpinLock &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CSpinLock &operator=(const CSpinLock &) = delete;
+
+    public:
+        /// @brief Locks the spinlock, spinning with exponential backoff while it is held by another thread.
+        void lock() const {
+            size_t nBackoff = 1;
+
+            while (this->m_fIsLocked.exchange(true, std::memory_order_acquire)) {
+                do {
+                    if (nBackoff <= CSpinLock::MaxBackoff) {
+                        for (size_t i = 0; i < nBackoff; i++) {
+                            Utils::cpuRelax();
+                        }
+                        nBackoff <<= 1;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                } while (this->m_fIsLocked.load(std::memory_order_relaxed));
+            }
+        }
+
+        /// @brief Unlocks the spinlock.
+        void unlock() const {
+            this->m_fIsLocked.store(false, std::memory_order_release);
+        }
+
+        /// @brief Attempts to lock the spinlock without spinning.
+        /// @return True if the spinlock was successfully locked, false otherwise.
+        bool tryLock() const {
+            return !this->m_fIsLocked.load(std::memory_order_relaxed) &&
+                   !this->m_fIsLocked.exchange(true, std::memory_order_acquire);
+        }
+
+    private:
+        /// @var std::atomic<bool> m_fIsLocked
+        /// @brief True while the spinlock is held.
+        mutable std::atomic<bool> m_fIsLocked = false;
+    };
+}
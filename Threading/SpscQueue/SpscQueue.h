@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CSpscQueue<T>
+    /// @brief A wait-free bounded single-producer single-consumer queue.
+    ///
+    /// The queue is a ring buffer for exactly one producer thread and one consumer thread. Each side keeps a
+    /// cached copy of the other side's index and only reloads the shared index when the cached one says
+    /// the queue is full or empty, so in steady state push and pop touch no cache line written by the other thread.
+    ///
+    /// Besides single and batch push/pop the consumer can look at the front element in place with peek()
+    /// and release it with commit(), which avoids moving it out of the queue.
+    ///
+    /// @tparam T The type of elements stored in the queue.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CSpscQueue<Devel::IO::CReadStream> queue(1024);
+    ///
+    ///     // Reader thread
+    ///     queue.tryPush(std::move(packet));
+    ///
+    ///     // Decoder thread
+    ///     if (Devel::IO::CReadStream *pPacket = queue.peek()) {
+    ///         decode(*pPacket);
+    ///         queue.commit();
+    ///     }
+    /// @endcode
+    template<typename T>
+    class CSpscQueue {
+    public:
+        /// @brief Constructs an empty queue.
+        /// @param i_nCapacity The minimum number of elements, rounded up to a power of two.
+        explicit CSpscQueue(const size_t i_nCapacity = 1024)
+                : m_nHead(0), m_nCachedTail(0), m_nTail(0), m_nCachedHead(0) {
+            this->m_nCapacity = 2;
+            while (this->m_nCapacity < i_nCapacity) {
+                this->m_nCapacity *= 2;
+            }
+
+            this->m_nMask = this->m_nCapacity - 1;
+            this->m_pSlots = static_cast<T *>(::operator new(sizeof(T) * this->m_nCapacity,
+                                                             std::align_val_t(alignof(T))));
+        }
+
+        /// @brief Deleted copy constructor.
+        CSpscQueue(const CSpscQueue &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CSpscQueue &operator=(const CSpscQueue &) = delete;
+
+        /// @brief Destructor, destroys the remaining elements.
+        ~CSpscQueue() {
+            while (this->peek()) {
+                this->commit();
+            }
+
+            ::operator delete(this->m_pSlots, std::align_val_t(alignof(T)));
+        }
+
+    public:
+        /// @brief Returns the maximum number of elements.
+        /// @return The capacity.
+        size_t capacity() const { return this->m_nCapacity; }
+
+        /// @brief Returns an approximation of the number of elements in the queue.
+        /// @return The number of elements.
+        size_t size() const {
+            return this->m_nTail.load(std::memory_order_acquire) - this->m_nHead.load(std::memory_order_acquire);
+        }
+
+        /// @brief Checks if the queue is (approximately) empty.
+        /// @return True if the queue is empty, false otherwise.
+        bool isEmpty() const {
+            return this->size() == 0;
+        }
+
+    public:
+        /// @brief Constructs an element at the end of the queue. Must only be called by the producer.
+        /// @param i_aArgs The constructor arguments of the element.
+        /// @return True if the element was pushed, false if the queue is full.
+        template<typename... Args>
+        bool tryEmplace(Args &&... i_aArgs) {
+            const size_t nTail = this->m_nTail.load(std::memory_order_relaxed);
+            if (this->freeSlots(nTail, 1) == 0) {
+                return false;
+            }
+
+            new(&this->m_pSlots[nTail & this->m_nMask]) T(std::forward<Args>(i_aArgs)...);
+            this->m_nTail.store(nTail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Moves an element to the end of the queue. Must only be called by the producer.
+        /// @param i_tValue The element.
+        /// @return True if the element was pushed, false if the queue is full.
+        bool tryPush(T &&i_tValue) {
+            return this->tryEmplace(std::move(i_tValue));
+        }
+
+        /// @brief Copies an element to the end of the queue. Must only be called by the producer.
+        /// @param i_tValue The element.
+        /// @return True if the element was pushed, false if the queue is full.
+        bool tryPush(const T &i_tValue) {
+            return this->tryEmplace(i_tValue);
+        }
+
+        /// @brief Moves up to i_nCount elements to the end of the queue and publishes them at once.
+        /// Must only be called by the producer.
+        /// @param i_itFirst The first element to push, the elements are moved from.
+        /// @param i_nCount The number of elements available.
+        /// @return The number of elements pushed.
+        template<typename InputIt>
+        size_t pushBulk(InputIt i_itFirst, const size_t i_nCount) {
+            const size_t nTail = this->m_nTail.load(std::memory_order_relaxed);
+            const size_t nCount = std::min(i_nCount, this->freeSlots(nTail, i_nCount));
+
+            for (size_t i = 0; i < nCount; i++, ++i_itFirst) {
+                new(&this->m_pSlots[(nTail + i) & this->m_nMask]) T(std::move(*i_itFirst));
+            }
+
+            this->m_nTail.store(nTail + nCount, std::memory_order_release);
+            return nCount;
+        }
+
+    public:
+        /// @brief Returns the front element without removing it. Must only be called by the consumer.
+        /// The element stays valid until commit() is called.
+        /// @return A pointer to the front element, or nullptr if the queue is empty.
+        T *peek() {
+            const size_t nHead = this->m_nHead.load(std::memory_order_relaxed);
+            if (this->usedSlots(nHead, 1) == 0) {
+                return nullptr;
+            }
+
+            return &this->m_pSlots[nHead & this->m_nMask];
+        }
+
+        /// @brief Destroys the front element returned by peek(). Must only be called by the consumer.
+        void commit() {
+            const size_t nHead = this->m_nHead.load(std::memory_order_relaxed);
+            this->m_pSlots[nHead & this->m_nMask].~T();
+            this->m_nHead.store(nHead + 1, std::memory_order_release);
+        }
+
+        /// @brief Moves the front element out of the queue. Must only be called by the consumer.
+        /// @param i_tOutValue Receives the element on success.
+        /// @return True if an element was popped, false if the queue is empty.
+        bool tryPop(T &i_tOutValue) {
+            T *pValue = this->peek();
+            if (!pValue) {
+                return false;
+            }
+
+            i_tOutValue = std::move(*pValue);
+            this->commit();
+            return true;
+        }
+
+        /// @brief Moves up to i_nMaxCount elements out of the queue and releases their slots at once.
+        /// Must only be called by the consumer.
+        /// @param i_itOut The output iterator receiving the elements.
+        /// @param i_nMaxCount The maximum number of elements to pop.
+        /// @return The number of elements popped.
+        template<typename OutputIt>
+        size_t popBulk(OutputIt i_itOut, const size_t i_nMaxCount) {
+            const size_t nHead = this->m_nHead.load(std::memory_order_relaxed);
+            const size_t nCount = std::min(i_nMaxCount, this->usedSlots(nHead, i_nMaxCount));
+
+            for (size_t i = 0; i < nCount; i++, ++i_itOut) {
+                T &tValue = this->m_pSlots[(nHead + i) & this->m_nMask];
+                *i_itOut = std::move(tValue);
+                tValue.~T();
+            }
+
+            this->m_nHead.store(nHead + nCount, std::memory_order_release);
+            return nCount;
+        }
+
+    private:
+        /// @brief Returns the number of free slots seen by the producer.
+        /// The consumer index is only reloaded if the cached one leaves less than i_nWanted slots.
+        /// @param i_nTail The current producer index.
+        /// @param i_nWanted The number of slots the producer wants.
+        /// @return The number of free slots.
+        size_t freeSlots(const size_t i_nTail, const size_t i_nWanted) {
+            size_t nFree = this->m_nCapacity - (i_nTail - this->m_nCachedHead);
+            if (nFree < i_nWanted) {
+                this->m_nCachedHead = this->m_nHead.load(std::memory_order_acquire);
+                nFree = this->m_nCapacity - (i_nTail - this->m_nCachedHead);
+            }
+
+            return nFree;
+        }
+
+        /// @brief Returns the number of used slots seen by the consumer.
+        /// The producer index is only reloaded if the cached one shows less than i_nWanted elements.
+        /// @param i_nHead The current consumer index.
+        /// @param i_nWanted The number of elements the consumer wants.
+        /// @return The number of used slots.
+        size_t usedSlots(const size_t i_nHead, const size_t i_nWanted) {
+            size_t nUsed = this->m_nCachedTail - i_nHead;
+            if (nUsed < i_nWanted) {
+                this->m_nCachedTail = this->m_nTail.load(std::memory_order_acquire);
+                nUsed = this->m_nCachedTail - i_nHead;
+            }
+
+            return nUsed;
+        }
+
+    private:
+        /// @var size_t m_nCapacity
+        /// @brief The number of slots, a power of two.
+        size_t m_nCapacity;
+
+        /// @var size_t m_nMask
+        /// @brief The mask mapping an index to a slot.
+        size_t m_nMask;
+
+        /// @var T *m_pSlots
+        /// @brief The uninitialized storage of the slots.
+        T *m_pSlots;
+
+        /// @var std::atomic<size_t> m_nHead
+        /// @brief The index of the next element to pop, written by the consumer.
+        alignas(64) std::atomic<size_t> m_nHead;
+
+        /// @var size_t m_nCachedTail
+        /// @brief The consumer's cached copy of m_nTail.
+        size_t m_nCachedTail;
+
+        /// @var std::atomic<size_t> m_nTail
+        /// @brief The index of the next slot to push to, written by the producer.
+        alignas(64) std::atomic<size_t> m_nTail;
+
+        /// @var size_t m_nCachedHead
+        /// @brief The producer's cached copy of m_nHead.
+        size_t m_nCachedHead;
+    };
+}
@@ -0,0 +1,724 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Core/Exceptions.h"
+#include "Threading/PoolAllocator/PoolAllocator.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CCoroutineFrame
+    /// @brief Allocates coroutine frames from size classes of CPoolAllocator.
+    ///
+    /// The compiler elides the frame of a coroutine which is awaited right away (HALO) if it can see its body.
+    /// All other frames are taken from free lists of 128, 256, 512 or 1024 bytes, so starting a coroutine on a
+    /// thread that finished one before does not reach the global heap. Larger frames use the global heap.
+    class CCoroutineFrame {
+    private:
+        /// @class CBlock
+        /// @brief A block of a size class.
+        template<size_t Size>
+        class alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) CBlock {
+            unsigned char m_aData[Size];
+        };
+
+    public:
+        /// @brief Allocates a frame.
+        /// @param i_nSize The size of the frame.
+        /// @return The memory of the frame.
+        static void *allocate(const size_t i_nSize) {
+            if (i_nSize <= 128) {
+                return CPoolAllocator<CBlock<128>>::allocate();
+            } else if (i_nSize <= 256) {
+                return CPoolAllocator<CBlock<256>>::allocate();
+            } else if (i_nSize <= 512) {
+                return CPoolAllocator<CBlock<512>>::allocate();
+            } else if (i_nSize <= 1024) {
+                return CPoolAllocator<CBlock<1024>>::allocate();
+            }
+
+            return ::operator new(i_nSize);
+        }
+
+        /// @brief Releases a frame.
+        /// @param i_pFrame The memory of the frame.
+        /// @param i_nSize The size passed to allocate().
+        static void deallocate(void *i_pFrame, const size_t i_nSize) {
+            if (i_nSize <= 128) {
+                CPoolAllocator<CBlock<128>>::deallocate(i_pFrame);
+            } else if (i_nSize <= 256) {
+                CPoolAllocator<CBlock<256>>::deallocate(i_pFrame);
+            } else if (i_nSize <= 512) {
+                CPoolAllocator<CBlock<512>>::deallocate(i_pFrame);
+            } else if (i_nSize <= 1024) {
+                CPoolAllocator<CBlock<1024>>::deallocate(i_pFrame);
+            } else {
+                ::operator delete(i_pFrame);
+            }
+        }
+    };
+
+    /// @class Devel::Threading::CCoroutinePromiseBase
+    /// @brief The part of the promise of a CTask which does not depend on the result type.
+    class CCoroutinePromiseBase {
+    private:
+        /// @class CFinalAwaiter
+        /// @brief Transfers control to the awaiting coroutine when the task completes.
+        class CFinalAwaiter {
+        public:
+            /// @brief The task always suspends at the end, the CTask owns the frame.
+            /// @return False.
+            bool await_ready() const noexcept { return false; }
+
+            /// @brief Resumes the continuation without growing the stack (symmetric transfer).
+            /// @param i_hCoroutine The completed task.
+            /// @return The coroutine to resume.
+            template<typename TPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> i_hCoroutine) const noexcept {
+                std::coroutine_handle<> hContinuation = i_hCoroutine.promise().m_hContinuation;
+                return hContinuation ? hContinuation : std::noop_coroutine();
+            }
+
+            /// @brief Never called, the task is not resumed after its end.
+            void await_resume() const noexcept {}
+        };
+
+    public:
+        /// @brief Allocates the coroutine frame.
+        /// @param i_nSize The size of the frame.
+        /// @return The memory of the frame.
+        static void *operator new(const size_t i_nSize) {
+            return CCoroutineFrame::allocate(i_nSize);
+        }
+
+        /// @brief Releases the coroutine frame.
+        /// @param i_pFrame The memory of the frame.
+        /// @param i_nSize The size of the frame.
+        static void operator delete(void *i_pFrame, const size_t i_nSize) {
+            CCoroutineFrame::deallocate(i_pFrame, i_nSize);
+        }
+
+    public:
+        /// @brief A task starts when it is awaited.
+        /// @return The awaitable.
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        /// @brief Resumes the awaiting coroutine when the task completes.
+        /// @return The awaitable.
+        CFinalAwaiter final_suspend() const noexcept { return {}; }
+
+        /// @brief Stores an exception escaping the task, it is rethrown to the awaiting coroutine.
+        void unhandled_exception() noexcept {
+            this->m_pException = std::current_exception();
+        }
+
+    public:
+        /// @var std::coroutine_handle<> m_hContinuation
+        /// @brief The coroutine awaiting the task.
+        std::coroutine_handle<> m_hContinuation;
+
+        /// @var std::exception_ptr m_pException
+        /// @brief The exception thrown by the task.
+        std::exception_ptr m_pException;
+    };
+
+    template<typename T>
+    class CTask;
+
+    /// @class Devel::Threading::CCoroutinePromise<T>
+    /// @brief The promise of a CTask returning a value.
+    template<typename T>
+    class CCoroutinePromise : public CCoroutinePromiseBase {
+    public:
+        /// @brief Creates the task object of the coroutine.
+        /// @return The task.
+        CTask<T> get_return_object() noexcept;
+
+        /// @brief Stores the value of a co_return statement.
+        /// @param i_tValue The value.
+        template<typename U>
+        void return_value(U &&i_tValue) {
+            this->m_tValue.emplace(std::forward<U>(i_tValue));
+        }
+
+        /// @brief Returns the result of the task.
+        /// @return The value, moved out of the promise.
+        /// @throws The exception thrown by the task.
+        T result() {
+            if (this->m_pException) {
+                std::rethrow_exception(this->m_pException);
+            }
+
+            return std::move(*this->m_tValue);
+        }
+
+    private:
+        /// @var std::optional<T> m_tValue
+        /// @brief The value of the task.
+        std::optional<T> m_tValue;
+    };
+
+    /// @class Devel::Threading::CCoroutinePromise<void>
+    /// @brief The promise of a CTask without a value.
+    template<>
+    class CCoroutinePromise<void> : public CCoroutinePromiseBase {
+    public:
+        /// @brief Creates the task object of the coroutine.
+        /// @return The task.
+        CTask<void> get_return_object() noexcept;
+
+        /// @brief Called by co_return without a value.
+        void return_void() const noexcept {}
+
+        /// @brief Returns the result of the task.
+        /// @throws The exception thrown by the task.
+        void result() {
+            if (this->m_pException) {
+                std::rethrow_exception(this->m_pException);
+            }
+        }
+    };
+
+    /// @class Devel::Threading::CTask<T>
+    /// @brief A lazily started coroutine which produces a value of type T.
+    ///
+    /// A function returning CTask<T> becomes a coroutine which runs when it is awaited with co_await. The awaiting
+    /// coroutine is resumed on the thread that completes the task, using symmetric transfer, so chains of awaited
+    /// tasks neither grow the stack nor pass through a queue. An exception escaping the task is rethrown by co_await.
+    ///
+    /// A task moves to a thread pool with co_await CThreadPool::schedule() and sleeps without blocking a thread with
+    /// co_await CTimerWheel::sleepFor(). whenAll() and whenAny() await several tasks, syncWait() blocks a normal
+    /// thread until a task completes.
+    ///
+    /// Frames of tasks which are awaited right away are usually elided by the compiler, the others come from the
+    /// size class allocator CCoroutineFrame. Resuming on the pool stores only the coroutine handle in the inline
+    /// buffer of the pool task, so no allocation happens between suspension and resumption.
+    ///
+    /// @tparam T The result type, void for tasks without a value.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CTask<std::string> download(CThreadPool &pool, CTimerWheel &timers, std::string url) {
+    ///         co_await pool.schedule();                                  // continue on a worker
+    ///         while (!isReachable(url)) {
+    ///             co_await timers.sleepFor(std::chrono::seconds(1));     // no thread is blocked meanwhile
+    ///         }
+    ///         co_return fetch(url);
+    ///     }
+    ///
+    ///     Devel::Threading::CTask<size_t> downloadAll(CThreadPool &pool, CTimerWheel &timers) {
+    ///         std::vector<Devel::Threading::CTask<std::string>> tasks;
+    ///         tasks.push_back(download(pool, timers, "a"));
+    ///         tasks.push_back(download(pool, timers, "b"));
+    ///
+    ///         std::vector<std::string> pages = co_await Devel::Threading::whenAll(std::move(tasks));
+    ///         co_return pages.size();
+    ///     }
+    ///
+    ///     size_t count = Devel::Threading::syncWait(downloadAll(pool, timers));
+    /// @endcode
+    template<typename T = void>
+    class CTask {
+    public:
+        /// @typedef promise_type
+        /// @brief The promise type looked up by the compiler.
+        typedef CCoroutinePromise<T> promise_type;
+
+    private:
+        /// @class CAwaiter
+        /// @brief Starts the task and resumes the awaiting coroutine when it completes.
+        template<bool ReturnsResult>
+        class CAwaiter {
+        public:
+            /// @brief Constructs the awaiter.
+            /// @param i_hCoroutine The task.
+            explicit CAwaiter(std::coroutine_handle<promise_type> i_hCoroutine)
+                    : m_hCoroutine(i_hCoroutine) {
+            }
+
+        public:
+            /// @brief A completed task does not suspend the awaiting coroutine.
+            /// @return True if the task is completed.
+            bool await_ready() const noexcept { return !this->m_hCoroutine || this->m_hCoroutine.done(); }
+
+            /// @brief Starts the task, the awaiting coroutine becomes its continuation.
+            /// @param i_hAwaiting The awaiting coroutine.
+            /// @return The task, resumed by symmetric transfer.
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> i_hAwaiting) noexcept {
+                this->m_hCoroutine.promise().m_hContinuation = i_hAwaiting;
+                return this->m_hCoroutine;
+            }
+
+            /// @brief Returns the result of the task.
+            /// @return The result, or nothing if only the completion is awaited.
+            /// @throws The exception thrown by the task if the result is returned.
+            auto await_resume() {
+                if constexpr (ReturnsResult) {
+                    return this->m_hCoroutine.promise().result();
+                }
+            }
+
+        private:
+            /// @var std::coroutine_handle<promise_type> m_hCoroutine
+            /// @brief The task.
+            std::coroutine_handle<promise_type> m_hCoroutine;
+        };
+
+    public:
+        /// @brief Constructs an empty task.
+        CTask() noexcept = default;
+
+        /// @brief Constructs the task of a coroutine.
+        /// @param i_hCoroutine The coroutine.
+        explicit CTask(std::coroutine_handle<promise_type> i_hCoroutine) noexcept
+                : m_hCoroutine(i_hCoroutine) {
+        }
+
+        /// @brief Move constructor.
+        /// @param i_oOther The task to move from.
+        CTask(CTask &&i_oOther) noexcept
+                : m_hCoroutine(std::exchange(i_oOther.m_hCoroutine, nullptr)) {
+        }
+
+        /// @brief Move assignment operator.
+        /// @param i_oOther The task to move from.
+        /// @return A reference to this task.
+        CTask &operator=(CTask &&i_oOther) noexcept {
+            if (this != &i_oOther) {
+                this->destroy();
+                this->m_hCoroutine = std::exchange(i_oOther.m_hCoroutine, nullptr);
+            }
+
+            return *this;
+        }
+
+        /// @brief Deleted copy constructor.
+        CTask(const CTask &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CTask &operator=(const CTask &) = delete;
+
+        /// @brief Destructor, destroys the coroutine frame. A started task must have completed.
+        ~CTask() {
+            this->destroy();
+        }
+
+    public:
+        /// @brief Starts the task if needed and returns its result to the awaiting coroutine.
+        /// @return The awaitable.
+        CAwaiter<true> operator co_await() const noexcept {
+            return CAwaiter<true>(this->m_hCoroutine);
+        }
+
+        /// @brief Starts the task if needed and waits for its completion without taking the result.
+        /// The result stays available through result().
+        /// @return The awaitable.
+        CAwaiter<false> whenReady() const noexcept {
+            return CAwaiter<false>(this->m_hCoroutine);
+        }
+
+        /// @brief Returns the result of a completed task.
+        /// @return The result, a value is moved out of the task.
+        /// @throws The exception thrown by the task.
+        T result() {
+            return this->m_hCoroutine.promise().result();
+        }
+
+        /// @brief Checks if the task refers to a coroutine.
+        /// @return True if the task is valid.
+        bool isValid() const noexcept { return static_cast<bool>(this->m_hCoroutine); }
+
+        /// @brief Checks if the task has completed.
+        /// @return True if the task is completed.
+        bool isReady() const noexcept { return !this->m_hCoroutine || this->m_hCoroutine.done(); }
+
+    private:
+        /// @brief Destroys the coroutine frame.
+        void destroy() {
+            if (this->m_hCoroutine) {
+                this->m_hCoroutine.destroy();
+                this->m_hCoroutine = nullptr;
+            }
+        }
+
+    private:
+        /// @var std::coroutine_handle<promise_type> m_hCoroutine
+        /// @brief The coroutine of the task.
+        std::coroutine_handle<promise_type> m_hCoroutine;
+    };
+
+    template<typename T>
+    CTask<T> CCoroutinePromise<T>::get_return_object() noexcept {
+        return CTask<T>(std::coroutine_handle<CCoroutinePromise<T>>::from_promise(*this));
+    }
+
+    inline CTask<void> CCoroutinePromise<void>::get_return_object() noexcept {
+        return CTask<void>(std::coroutine_handle<CCoroutinePromise<void>>::from_promise(*this));
+    }
+
+    /// @class Devel::Threading::CDetachedCoroutine
+    /// @brief A coroutine which starts on start() and destroys its frame when it completes.
+    /// Used by the combinators to observe the completion of a task.
+    class CDetachedCoroutine {
+    public:
+        /// @class promise_type
+        /// @brief The promise of the detached coroutine.
+        class promise_type {
+        public:
+            /// @brief Allocates the coroutine frame.
+            /// @param i_nSize The size of the frame.
+            /// @return The memory of the frame.
+            static void *operator new(const size_t i_nSize) {
+                return CCoroutineFrame::allocate(i_nSize);
+            }
+
+            /// @brief Releases the coroutine frame.
+            /// @param i_pFrame The memory of the frame.
+            /// @param i_nSize The size of the frame.
+            static void operator delete(void *i_pFrame, const size_t i_nSize) {
+                CCoroutineFrame::deallocate(i_pFrame, i_nSize);
+            }
+
+        public:
+            /// @brief Creates the coroutine object.
+            /// @return The coroutine.
+            CDetachedCoroutine get_return_object() noexcept {
+                return CDetachedCoroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            /// @brief The coroutine starts on start().
+            /// @return The awaitable.
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+
+            /// @brief The frame is destroyed when the coroutine completes.
+            /// @return The awaitable.
+            std::suspend_never final_suspend() const noexcept { return {}; }
+
+            /// @brief Called by co_return.
+            void return_void() const noexcept {}
+
+            /// @brief The combinators never let an exception escape.
+            void unhandled_exception() const noexcept {
+                std::terminate();
+            }
+        };
+
+    public:
+        /// @brief Constructs the coroutine object.
+        /// @param i_hCoroutine The coroutine.
+        explicit CDetachedCoroutine(std::coroutine_handle<promise_type> i_hCoroutine) noexcept
+                : m_hCoroutine(i_hCoroutine) {
+        }
+
+    public:
+        /// @brief Starts the coroutine, the frame is owned by the coroutine from now on.
+        void start() {
+            this->m_hCoroutine.resume();
+        }
+
+    private:
+        /// @var std::coroutine_handle<promise_type> m_hCoroutine
+        /// @brief The coroutine.
+        std::coroutine_handle<promise_type> m_hCoroutine;
+    };
+
+    /// @class Devel::Threading::CWhenAllCounter
+    /// @brief Counts the completed tasks of whenAll() and resumes the awaiting coroutine after the last one.
+    class CWhenAllCounter {
+    public:
+        /// @brief Constructs the counter.
+        /// @param i_nCount The number of tasks.
+        explicit CWhenAllCounter(const size_t i_nCount)
+                : m_nPending(i_nCount + 1) {
+        }
+
+    public:
+        /// @brief Called when a task completes.
+        void notify() {
+            if (this->m_nPending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                this->m_hAwaiting.resume();
+            }
+        }
+
+        /// @brief Suspends the awaiting coroutine after the tasks were started.
+        /// @param i_hAwaiting The awaiting coroutine.
+        /// @return False if all tasks completed already and the coroutine continues.
+        bool suspend(const std::coroutine_handle<> i_hAwaiting) {
+            this->m_hAwaiting = i_hAwaiting;
+            return this->m_nPending.fetch_sub(1, std::memory_order_acq_rel) != 1;
+        }
+
+    private:
+        /// @var std::atomic<size_t> m_nPending
+        /// @brief The number of running tasks, plus one for the awaiting coroutine until it suspended.
+        std::atomic<size_t> m_nPending;
+
+        /// @var std::coroutine_handle<> m_hAwaiting
+        /// @brief The coroutine awaiting the tasks.
+        std::coroutine_handle<> m_hAwaiting;
+    };
+
+    /// @brief Awaits a task and notifies a counter, used by whenAll().
+    /// @param i_oTask The task.
+    /// @param i_oCounter The counter.
+    /// @return The detached coroutine.
+    template<typename T>
+    CDetachedCoroutine whenAllObserve(CTask<T> &i_oTask, CWhenAllCounter &i_oCounter) {
+        co_await i_oTask.whenReady();
+        i_oCounter.notify();
+    }
+
+    /// @class Devel::Threading::CWhenAllAwaiter<F>
+    /// @brief Starts the tasks of whenAll() and suspends the awaiting coroutine until all have completed.
+    template<typename F>
+    class CWhenAllAwaiter {
+    public:
+        /// @brief Constructs the awaiter.
+        /// @param i_nCount The number of tasks.
+        /// @param i_fnStart The function starting all tasks with the counter.
+        CWhenAllAwaiter(const size_t i_nCount, F i_fnStart)
+                : m_oCounter(i_nCount), m_fnStart(std::move(i_fnStart)) {
+        }
+
+    public:
+        /// @brief The tasks are started in await_suspend().
+        /// @return False.
+        bool await_ready() const noexcept { return false; }
+
+        /// @brief Starts the tasks.
+        /// @param i_hAwaiting The awaiting coroutine.
+        /// @return False if all tasks completed synchronously.
+        bool await_suspend(std::coroutine_handle<> i_hAwaiting) {
+            this->m_fnStart(this->m_oCounter);
+            return this->m_oCounter.suspend(i_hAwaiting);
+        }
+
+        /// @brief Called when all tasks have completed.
+        void await_resume() const noexcept {}
+
+    private:
+        /// @var CWhenAllCounter m_oCounter
+        /// @brief The completion counter.
+        CWhenAllCounter m_oCounter;
+
+        /// @var F m_fnStart
+        /// @brief The function starting the tasks.
+        F m_fnStart;
+    };
+
+    /// @brief Awaits all tasks of a vector. The tasks run concurrently if they move to a thread pool.
+    /// @param i_aoTasks The tasks.
+    /// @return A task producing the results in the order of the tasks, nothing for void tasks.
+    /// The first exception of a task in that order is rethrown after all tasks have completed.
+    template<typename T>
+    CTask<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> whenAll(std::vector<CTask<T>> i_aoTasks) {
+        co_await CWhenAllAwaiter(i_aoTasks.size(), [&i_aoTasks](CWhenAllCounter &i_oCounter) {
+            for (CTask<T> &oTask: i_aoTasks) {
+                whenAllObserve(oTask, i_oCounter).start();
+            }
+        });
+
+        if constexpr (std::is_void_v<T>) {
+            for (CTask<T> &oTask: i_aoTasks) {
+                oTask.result();
+            }
+        } else {
+            std::vector<T> atResults;
+            atResults.reserve(i_aoTasks.size());
+            for (CTask<T> &oTask: i_aoTasks) {
+                atResults.push_back(oTask.result());
+            }
+
+            co_return atResults;
+        }
+    }
+
+    /// @brief Awaits tasks of different result types. The tasks run concurrently if they move to a thread pool.
+    /// @param i_aoTasks The tasks, none of them may be a void task.
+    /// @return A task producing a tuple of the results.
+    /// The first exception of a task in argument order is rethrown after all tasks have completed.
+    template<typename... Ts>
+    CTask<std::tuple<Ts...>> whenAll(CTask<Ts>... i_aoTasks) {
+        static_assert((!std::is_void_v<Ts> && ...), "Use the vector overload of whenAll for void tasks");
+
+        co_await CWhenAllAwaiter(sizeof...(Ts), [&](CWhenAllCounter &i_oCounter) {
+            (whenAllObserve(i_aoTasks, i_oCounter).start(), ...);
+        });
+
+        co_return std::tuple<Ts...>(i_aoTasks.result()...);
+    }
+
+    /// @class Devel::Threading::CWhenAnyState<T>
+    /// @brief The state of whenAny(), shared with the tasks which are still running after the first completed.
+    template<typename T>
+    class CWhenAnyState {
+    public:
+        /// @brief Constructs the state.
+        /// @param i_aoTasks The tasks.
+        explicit CWhenAnyState(std::vector<CTask<T>> i_aoTasks)
+                : m_aoTasks(std::move(i_aoTasks)), m_nWinner(0), m_fHasWinner(false), m_nHandshake(0) {
+        }
+
+    public:
+        /// @brief Called when a task completes, the first one resumes the awaiting coroutine.
+        /// @param i_nIndex The index of the task.
+        void notify(const size_t i_nIndex) {
+            if (!this->m_fHasWinner.exchange(true, std::memory_order_acq_rel)) {
+                this->m_nWinner = i_nIndex;
+                if (this->m_nHandshake.fetch_add(1, std::memory_order_acq_rel) == 1) {
+                    this->m_hAwaiting.resume();
+                }
+            }
+        }
+
+        /// @brief Suspends the awaiting coroutine after the tasks were started.
+        /// @param i_hAwaiting The awaiting coroutine.
+        /// @return False if a task completed already and the coroutine continues.
+        bool suspend(const std::coroutine_handle<> i_hAwaiting) {
+            this->m_hAwaiting = i_hAwaiting;
+            return this->m_nHandshake.fetch_add(1, std::memory_order_acq_rel) != 1;
+        }
+
+    public:
+        /// @var std::vector<CTask<T>> m_aoTasks
+        /// @brief The tasks, owned by the state so that slower tasks can finish after whenAny() returned.
+        std::vector<CTask<T>> m_aoTasks;
+
+        /// @var size_t m_nWinner
+        /// @brief The index of the first completed task.
+        size_t m_nWinner;
+
+    private:
+        /// @var std::atomic<bool> m_fHasWinner
+        /// @brief Whether a task has completed.
+        std::atomic<bool> m_fHasWinner;
+
+        /// @var std::atomic<size_t> m_nHandshake
+        /// @brief Counts the first completion and the suspension, the second of them resumes the coroutine.
+        std::atomic<size_t> m_nHandshake;
+
+        /// @var std::coroutine_handle<> m_hAwaiting
+        /// @brief The coroutine awaiting the first task.
+        std::coroutine_handle<> m_hAwaiting;
+    };
+
+    /// @brief Awaits a task and notifies the state of whenAny().
+    /// @param i_pState The state, kept alive until the task completed.
+    /// @param i_nIndex The index of the task.
+    /// @return The detached coroutine.
+    template<typename T>
+    CDetachedCoroutine whenAnyObserve(std::shared_ptr<CWhenAnyState<T>> i_pState, const size_t i_nIndex) {
+        co_await i_pState->m_aoTasks[i_nIndex].whenReady();
+        i_pState->notify(i_nIndex);
+    }
+
+    /// @class Devel::Threading::CWhenAnyAwaiter<T>
+    /// @brief Starts the tasks of whenAny() and suspends the awaiting coroutine until the first has completed.
+    template<typename T>
+    class CWhenAnyAwaiter {
+    public:
+        /// @brief Constructs the awaiter.
+        /// @param i_pState The state.
+        explicit CWhenAnyAwaiter(std::shared_ptr<CWhenAnyState<T>> i_pState)
+                : m_pState(std::move(i_pState)) {
+        }
+
+    public:
+        /// @brief The tasks are started in await_suspend().
+        /// @return False.
+        bool await_ready() const noexcept { return false; }
+
+        /// @brief Starts the tasks.
+        /// @param i_hAwaiting The awaiting coroutine.
+        /// @return False if a task completed synchronously.
+        bool await_suspend(std::coroutine_handle<> i_hAwaiting) {
+            for (size_t i = 0; i < this->m_pState->m_aoTasks.size(); i++) {
+                whenAnyObserve(this->m_pState, i).start();
+            }
+
+            return this->m_pState->suspend(i_hAwaiting);
+        }
+
+        /// @brief Called when the first task has completed.
+        void await_resume() const noexcept {}
+
+    private:
+        /// @var std::shared_ptr<CWhenAnyState<T>> m_pState
+        /// @brief The state.
+        std::shared_ptr<CWhenAnyState<T>> m_pState;
+    };
+
+    /// @brief Awaits the first completed task of a vector.
+    /// The other tasks can not be cancelled, they keep running and are destroyed when they complete.
+    /// @param i_aoTasks The tasks, at least one, EmptyWhenAnyException is thrown without a task.
+    /// @return A task producing the index of the first completed task and its result.
+    /// The exception of the first completed task is rethrown.
+    template<typename T>
+    CTask<std::conditional_t<std::is_void_v<T>, size_t, std::pair<size_t, T>>> whenAny(std::vector<CTask<T>> i_aoTasks) {
+        // No task would ever resume the awaiting coroutine
+        if (i_aoTasks.empty()) {
+            throw EmptyWhenAnyException;
+        }
+
+        auto pState = std::make_shared<CWhenAnyState<T>>(std::move(i_aoTasks));
+        co_await CWhenAnyAwaiter<T>(pState);
+
+        const size_t nWinner = pState->m_nWinner;
+        if constexpr (std::is_void_v<T>) {
+            pState->m_aoTasks[nWinner].result();
+            co_return nWinner;
+        } else {
+            co_return std::pair<size_t, T>(nWinner, pState->m_aoTasks[nWinner].result());
+        }
+    }
+
+    /// @brief Awaits a task and signals a waiting thread, used by syncWait().
+    /// @param i_oTask The task.
+    /// @param i_oMutex The mutex of the waiting thread.
+    /// @param i_oCondition The condition variable of the waiting thread.
+    /// @param i_fIsDone The flag set on completion.
+    /// @return The detached coroutine.
+    template<typename T>
+    CDetachedCoroutine syncWaitObserve(CTask<T> &i_oTask, std::mutex &i_oMutex, std::condition_variable &i_oCondition,
+                                       bool &i_fIsDone) {
+        co_await i_oTask.whenReady();
+
+        // Notifying under the lock keeps the waiting thread from destroying the condition variable too early
+        std::lock_guard<std::mutex> oLock(i_oMutex);
+        i_fIsDone = true;
+        i_oCondition.notify_one();
+    }
+
+    /// @brief Runs a task and blocks the calling thread until it has completed.
+    /// Must not be called from a pool worker the task needs to complete.
+    /// @param i_oTask The task.
+    /// @return The result of the task.
+    /// @throws The exception thrown by the task.
+    template<typename T>
+    T syncWait(CTask<T> i_oTask) {
+        std::mutex oMutex;
+        std::condition_variable oCondition;
+        bool fIsDone = false;
+
+        syncWaitObserve(i_oTask, oMutex, oCondition, fIsDone).start();
+
+        {
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCondition.wait(oLock, [&fIsDone]() { return fIsDone; });
+        }
+
+        return i_oTask.result();
+    }
+}
@@ -0,0 +1,417 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "Core/Exceptions.h"
+#include "Threading/InplaceTask/InplaceTask.h"
+#include "Threading/PoolAllocator/PoolAllocator.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    template<typename T>
+    class CTaskFuture;
+
+    /// @class Devel::Threading::CTaskState<T>
+    /// @brief The shared state between a CTaskPromise and a CTaskFuture.
+    ///
+    /// The state is reference counted and allocated through CPoolAllocator, so creating a future
+    /// does not reach the global heap in the common case. It stores either the result or the exception of the task
+    /// and an optional continuation which is run by the thread that completes the state.
+    ///
+    /// @tparam T The result type of the task.
+    template<typename T>
+    class CTaskState {
+    public:
+        /// @typedef ValueType
+        /// @brief The type used to store the result, std::monostate for void tasks.
+        typedef std::conditional_t<std::is_void_v<T>, std::monostate, T> ValueType;
+
+        /// @enum EState
+        /// @brief An enumeration of the states of a task state.
+        enum EState : uint32_t {
+            EPending,           ///< The task has not finished yet.
+            EContinuation,      ///< The task has not finished yet and a continuation is attached.
+            EReady,             ///< The task has finished with a value or an exception.
+        };
+
+    public:
+        /// @brief Allocates a state from the pool allocator.
+        static void *operator new(size_t) { return CPoolAllocator<CTaskState>::allocate(); }
+
+        /// @brief Returns a state to the pool allocator.
+        static void operator delete(void *i_pBlock) { CPoolAllocator<CTaskState>::deallocate(i_pBlock); }
+
+    public:
+        /// @brief Constructs a pending state with a reference count of one.
+        CTaskState()
+                : m_nReferences(1), m_nPromises(0), m_eState(EPending), m_fIsSatisfied(false) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CTaskState(const CTaskState &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CTaskState &operator=(const CTaskState &) = delete;
+
+    public:
+        /// @brief Increments the reference count.
+        void addReference() {
+            this->m_nReferences.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// @brief Decrements the reference count and destroys the state when it reaches zero.
+        void release() {
+            if (this->m_nReferences.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+
+        /// @brief Increments the number of promises referencing the state.
+        void addPromise() {
+            this->m_nPromises.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// @brief Decrements the number of promises referencing the state.
+        /// When the last promise is gone without satisfying the state, BrokenPromiseException is stored.
+        void releasePromise() {
+            if (this->m_nPromises.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                this->setException(std::make_exception_ptr(BrokenPromiseException));
+            }
+        }
+
+    public:
+        /// @brief Checks if the task has finished.
+        /// @return True if a value or an exception is available.
+        bool isReady() const {
+            return this->m_eState.load(std::memory_order_acquire) == EReady;
+        }
+
+        /// @brief Blocks until the task has finished.
+        void wait() const {
+            uint32_t eState;
+            while ((eState = this->m_eState.load(std::memory_order_acquire)) != EReady) {
+                this->m_eState.wait(eState, std::memory_order_acquire);
+            }
+        }
+
+        /// @brief Returns the exception of the task. Must only be called once the state is ready.
+        /// @return The exception, or nullptr if the task returned a value.
+        const std::exception_ptr &exception() const {
+            return this->m_pException;
+        }
+
+        /// @brief Returns the result of the task. Must only be called once the state is ready without exception.
+        /// @return A reference to the result.
+        ValueType &value() {
+            return *this->m_oValue;
+        }
+
+    public:
+        /// @brief Stores the result of the task. Ignored if the state is already satisfied.
+        /// @param i_tValue The result.
+        void setValue(ValueType &&i_tValue) {
+            if (!this->m_fIsSatisfied.exchange(true, std::memory_order_acq_rel)) {
+                this->m_oValue.emplace(std::move(i_tValue));
+                this->complete();
+            }
+        }
+
+        /// @brief Stores the exception of the task. Ignored if the state is already satisfied.
+        /// @param i_pException The exception.
+        void setException(std::exception_ptr i_pException) {
+            if (!this->m_fIsSatisfied.exchange(true, std::memory_order_acq_rel)) {
+                this->m_pException = std::move(i_pException);
+                this->complete();
+            }
+        }
+
+        /// @brief Attaches a continuation which is run as soon as the state is ready.
+        /// If the state is already ready, the continuation is run immediately on the calling thread.
+        /// @param i_fnContinuation The continuation.
+        void setContinuation(CInplaceTask<> &&i_fnContinuation) {
+            this->m_fnContinuation = std::move(i_fnContinuation);
+
+            uint32_t eExpected = EPending;
+            if (!this->m_eState.compare_exchange_strong(eExpected, EContinuation, std::memory_order_acq_rel)) {
+                CInplaceTask<> fnContinuation = std::move(this->m_fnContinuation);
+                fnContinuation();
+            }
+        }
+
+    private:
+        /// @brief Marks the state as ready, runs the continuation and wakes up all waiting threads.
+        void complete() {
+            if (this->m_eState.exchange(EReady, std::memory_order_acq_rel) == EContinuation) {
+                CInplaceTask<> fnContinuation = std::move(this->m_fnContinuation);
+                fnContinuation();
+            }
+
+            this->m_eState.notify_all();
+        }
+
+    private:
+        /// @var std::atomic<uint32_t> m_nReferences
+        /// @brief The number of promises and futures referencing the state.
+        std::atomic<uint32_t> m_nReferences;
+
+        /// @var std::atomic<uint32_t> m_nPromises
+        /// @brief The number of promises referencing the state.
+        std::atomic<uint32_t> m_nPromises;
+
+        /// @var std::atomic<uint32_t> m_eState
+        /// @brief The current EState of the state.
+        std::atomic<uint32_t> m_eState;
+
+        /// @var std::atomic<bool> m_fIsSatisfied
+        /// @brief Flag indicating whether a value or an exception was stored.
+        std::atomic<bool> m_fIsSatisfied;
+
+        /// @var std::optional<ValueType> m_oValue
+        /// @brief The result of the task.
+        std::optional<ValueType> m_oValue;
+
+        /// @var std::exception_ptr m_pException
+        /// @brief The exception thrown by the task.
+        std::exception_ptr m_pException;
+
+        /// @var CInplaceTask<> m_fnContinuation
+        /// @brief The continuation attached by CTaskFuture::then(), it may be move-only.
+        CInplaceTask<> m_fnContinuation;
+    };
+
+    /// @class Devel::Threading::CTaskPromise<T>
+    /// @brief The producing side of a CTaskState.
+    ///
+    /// A promise runs a callable and stores its result or exception in the shared state.
+    /// If the last copy of a promise is destroyed without doing so, for example because the task was dropped
+    /// from a queue, the future receives BrokenPromiseException.
+    ///
+    /// @tparam T The result type of the task.
+    template<typename T>
+    class CTaskPromise {
+    public:
+        /// @brief Constructs a promise referencing the given state.
+        /// @param i_pState The shared state.
+        explicit CTaskPromise(CTaskState<T> *i_pState)
+                : m_pState(i_pState) {
+            this->m_pState->addReference();
+            this->m_pState->addPromise();
+        }
+
+        /// @brief Copy constructor, references the same state.
+        /// @param i_oOther The promise to copy.
+        CTaskPromise(const CTaskPromise &i_oOther)
+                : CTaskPromise(i_oOther.m_pState) {
+        }
+
+        /// @brief Move constructor.
+        /// @param i_oOther The promise to move.
+        CTaskPromise(CTaskPromise &&i_oOther) noexcept
+                : m_pState(std::exchange(i_oOther.m_pState, nullptr)) {
+        }
+
+        /// @brief Deleted copy assignment operator.
+        CTaskPromise &operator=(const CTaskPromise &) = delete;
+
+        /// @brief Destructor, releases the state.
+        ~CTaskPromise() {
+            if (this->m_pState) {
+                this->m_pState->releasePromise();
+                this->m_pState->release();
+            }
+        }
+
+    public:
+        /// @brief Runs the callable and stores its result or exception in the shared state.
+        /// @param i_fnTask The callable, returning T.
+        template<typename F>
+        void run(F &&i_fnTask) {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    std::forward<F>(i_fnTask)();
+                    this->m_pState->setValue(std::monostate());
+                } else {
+                    this->m_pState->setValue(std::forward<F>(i_fnTask)());
+                }
+            } catch (...) {
+                this->m_pState->setException(std::current_exception());
+            }
+        }
+
+        /// @brief Stores an exception in the shared state.
+        /// @param i_pException The exception.
+        void setException(std::exception_ptr i_pException) {
+            this->m_pState->setException(std::move(i_pException));
+        }
+
+    private:
+        /// @var CTaskState<T> *m_pState
+        /// @brief The shared state.
+        CTaskState<T> *m_pState;
+    };
+
+    /// @class Devel::Threading::CTaskFuture<T>
+    /// @brief A lightweight handle to the result of a task submitted with CThreadPool::submit().
+    ///
+    /// The future is move-only. Its result can be consumed once, either with get() or by attaching
+    /// a continuation with then(). Exceptions thrown by the task are rethrown by get() and propagated through then().
+    ///
+    /// @tparam T The result type of the task.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CThreadPool pool(4);
+    ///     pool.execute();
+    ///
+    ///     auto future = pool.submit([](int a, int b) { return a + b; }, 1, 2)
+    ///             .then([](int sum) { return sum * 2; });
+    ///
+    ///     std::cout << future.get() << std::endl; // 6
+    /// @endcode
+    template<typename T>
+    class CTaskFuture {
+    public:
+        /// @brief Constructs a future without shared state.
+        CTaskFuture()
+                : m_pState(nullptr) {
+        }
+
+        /// @brief Constructs a future adopting one reference of the given state.
+        /// @param i_pState The shared state.
+        explicit CTaskFuture(CTaskState<T> *i_pState)
+                : m_pState(i_pState) {
+        }
+
+        /// @brief Move constructor.
+        /// @param i_oOther The future to move.
+        CTaskFuture(CTaskFuture &&i_oOther) noexcept
+                : m_pState(std::exchange(i_oOther.m_pState, nullptr)) {
+        }
+
+        /// @brief Move assignment operator.
+        /// @param i_oOther The future to move.
+        /// @return A reference to this future.
+        CTaskFuture &operator=(CTaskFuture &&i_oOther) noexcept {
+            if (this != &i_oOther) {
+                this->reset();
+                this->m_pState = std::exchange(i_oOther.m_pState, nullptr);
+            }
+
+            return *this;
+        }
+
+        /// @brief Deleted copy constructor.
+        CTaskFuture(const CTaskFuture &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CTaskFuture &operator=(const CTaskFuture &) = delete;
+
+        /// @brief Destructor, releases the shared state.
+        ~CTaskFuture() {
+            this->reset();
+        }
+
+    public:
+        /// @brief Checks if the future has a shared state.
+        /// @return True if the future is valid.
+        bool isValid() const { return this->m_pState != nullptr; }
+
+        /// @brief Checks if the task has finished.
+        /// @return True if the result is available.
+        bool isReady() const { return this->m_pState && this->m_pState->isReady(); }
+
+        /// @brief Blocks until the task has finished.
+        /// @throws InvalidFutureException if the future has no shared state.
+        void wait() const {
+            if (!this->m_pState) {
+                throw InvalidFutureException;
+            }
+
+            this->m_pState->wait();
+        }
+
+        /// @brief Waits for the task and returns its result. The future is invalid afterwards.
+        /// @return The result of the task.
+        /// @throws InvalidFutureException if the future has no shared state.
+        /// @throws Any exception thrown by the task.
+        T get() {
+            this->wait();
+
+            CTaskState<T> *pState = std::exchange(this->m_pState, nullptr);
+
+            if (pState->exception()) {
+                std::exception_ptr pException = pState->exception();
+                pState->release();
+                std::rethrow_exception(pException);
+            }
+
+            if constexpr (std::is_void_v<T>) {
+                pState->release();
+            } else {
+                T tValue = std::move(pState->value());
+                pState->release();
+                return tValue;
+            }
+        }
+
+        /// @brief Attaches a continuation that receives the result of the task. The future is invalid afterwards.
+        ///
+        /// The continuation is run by the thread that finishes the task, or immediately if the task has already finished.
+        /// If the task threw an exception, the continuation is skipped and the exception is passed to the returned future.
+        ///
+        /// @param i_fnContinuation The continuation, taking T (or nothing for void tasks). It may be move-only, it is
+        /// stored in a CInplaceTask together with two pointers, so larger state is captured through a pointer.
+        /// @return A future for the result of the continuation.
+        /// @throws InvalidFutureException if the future has no shared state.
+        template<typename F>
+        auto then(F &&i_fnContinuation) {
+            typedef std::decay_t<F> TContinuation;
+            typedef typename std::conditional_t<std::is_void_v<T>,
+                    std::invoke_result<TContinuation>,
+                    std::invoke_result<TContinuation, T>>::type TResult;
+
+            if (!this->m_pState) {
+                throw InvalidFutureException;
+            }
+
+            auto *pNext = new CTaskState<TResult>();
+            CTaskPromise<TResult> oPromise(pNext);
+            CTaskState<T> *pState = std::exchange(this->m_pState, nullptr);
+
+            pState->setContinuation(
+                    [pState, oPromise, fnContinuation = TContinuation(std::forward<F>(i_fnContinuation))]() mutable {
+                        if (pState->exception()) {
+                            oPromise.setException(pState->exception());
+                        } else if constexpr (std::is_void_v<T>) {
+                            oPromise.run(fnContinuation);
+                        } else {
+                            oPromise.run([&]() { return fnContinuation(std::move(pState->value())); });
+                        }
+
+                        pState->release();
+                    });
+
+            return CTaskFuture<TResult>(pNext);
+        }
+
+    private:
+        /// @brief Releases the shared state.
+        void reset() {
+            if (this->m_pState) {
+                std::exchange(this->m_pState, nullptr)->release();
+            }
+        }
+
+    private:
+        /// @var CTaskState<T> *m_pState
+        /// @brief The shared state.
+        CTaskState<T> *m_pState;
+    };
+}
@@ -0,0 +1,152 @@
+#include "TaskGraph.h"
+
+void Devel::Threading::CGraphTask::addSuccessor(const CGraphTask &i_oTask) const {
+    this->m_pNode->m_apSuccessors.push_back(i_oTask.m_pNode);
+    i_oTask.m_pNode->m_nDependencies++;
+    this->m_pNode->m_pGraph->m_fIsValidated = false;
+}
+
+void Devel::Threading::CTaskGraph::clear() {
+    if (this->isRunning()) {
+        throw GraphIsRunningException;
+    }
+
+    this->m_aoNodes.clear();
+    this->m_apSources.clear();
+    this->m_nSinkCount = 0;
+    this->m_fIsValidated = true;
+}
+
+void Devel::Threading::CTaskGraph::dispatch(CThreadPool &i_oPool) {
+    {
+        std::lock_guard<std::mutex> oLock(this->m_oMutex);
+        if (this->m_fIsRunning) {
+            throw GraphIsRunningException;
+        }
+
+        this->validate();
+        this->m_pException = nullptr;
+        this->m_fIsRunning = !this->m_aoNodes.empty();
+    }
+
+    if (this->m_aoNodes.empty()) {
+        return;
+    }
+
+    for (CTaskGraphNode &oNode: this->m_aoNodes) {
+        oNode.m_nPending.store(oNode.m_nDependencies, std::memory_order_relaxed);
+    }
+    this->m_nRemainingSinks.store(this->m_nSinkCount, std::memory_order_relaxed);
+    this->m_fHasFailed.store(false, std::memory_order_relaxed);
+    this->m_pPool = &i_oPool;
+
+    // Adding the tasks to the pool publishes the reset counters to the workers
+    for (CTaskGraphNode *pNode: this->m_apSources) {
+        this->schedule(pNode);
+    }
+}
+
+void Devel::Threading::CTaskGraph::wait() {
+    std::unique_lock<std::mutex> oLock(this->m_oMutex);
+    this->m_oCondition.wait(oLock, [this]() { return !this->m_fIsRunning; });
+
+    if (this->m_pException) {
+        std::rethrow_exception(std::exchange(this->m_pException, nullptr));
+    }
+}
+
+void Devel::Threading::CTaskGraph::validate() {
+    if (this->m_fIsValidated) {
+        return;
+    }
+
+    // Kahn's algorithm: every node is reached once all its predecessors are, nodes on a cycle never are
+    std::vector<size_t> anPending;
+    std::vector<CTaskGraphNode *> apReady;
+    std::vector<CTaskGraphNode *> apSources;
+    size_t nSinkCount = 0;
+
+    anPending.reserve(this->m_aoNodes.size());
+    for (CTaskGraphNode &oNode: this->m_aoNodes) {
+        // The pending counters are free between runs, they index the temporary counts
+        oNode.m_nPending.store(anPending.size(), std::memory_order_relaxed);
+        anPending.push_back(oNode.m_nDependencies);
+
+        if (oNode.m_nDependencies == 0) {
+            apSources.push_back(&oNode);
+        }
+        if (oNode.m_apSuccessors.empty()) {
+            nSinkCount++;
+        }
+    }
+
+    apReady = apSources;
+    size_t nVisited = 0;
+    while (!apReady.empty()) {
+        CTaskGraphNode *pNode = apReady.back();
+        apReady.pop_back();
+        nVisited++;
+
+        for (CTaskGraphNode *pSuccessor: pNode->m_apSuccessors) {
+            if (--anPending[pSuccessor->m_nPending.load(std::memory_order_relaxed)] == 0) {
+                apReady.push_back(pSuccessor);
+            }
+        }
+    }
+
+    if (nVisited != this->m_aoNodes.size()) {
+        throw CyclicGraphException;
+    }
+
+    this->m_apSources = std::move(apSources);
+    this->m_nSinkCount = nSinkCount;
+    this->m_fIsValidated = true;
+}
+
+void Devel::Threading::CTaskGraph::schedule(CTaskGraphNode *i_pNode) {
+    this->m_pPool->addTask([this, i_pNode]() { this->runNode(i_pNode); });
+}
+
+void Devel::Threading::CTaskGraph::runNode(CTaskGraphNode *i_pNode) {
+    while (i_pNode) {
+        // After a failure the remaining nodes are only counted down, so the run still completes
+        if (!this->m_fHasFailed.load(std::memory_order_relaxed)) {
+            try {
+                i_pNode->m_fnWork();
+            } catch (...) {
+                std::lock_guard<std::mutex> oLock(this->m_oMutex);
+                if (!this->m_pException) {
+                    this->m_pException = std::current_exception();
+                }
+                this->m_fHasFailed.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        if (i_pNode->m_apSuccessors.empty()) {
+            if (this->m_nRemainingSinks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                this->finish();
+            }
+            return;
+        }
+
+        // The first successor which becomes ready continues on this thread, skipping a trip through the pool
+        CTaskGraphNode *pNext = nullptr;
+        for (CTaskGraphNode *pSuccessor: i_pNode->m_apSuccessors) {
+            if (pSuccessor->m_nPending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                if (!pNext) {
+                    pNext = pSuccessor;
+                } else {
+                    this->schedule(pSuccessor);
+                }
+            }
+        }
+        i_pNode = pNext;
+    }
+}
+
+void Devel::Threading::CTaskGraph::finish() {
+    // Notifying under the lock keeps the graph alive until the waiter has been woken
+    std::lock_guard<std::mutex> oLock(this->m_oMutex);
+    this->m_fIsRunning = false;
+    this->m_oCondition.notify_all();
+}
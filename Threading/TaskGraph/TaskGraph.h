@@ -0,0 +1,297 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "Core/Exceptions.h"
+#include "Threading/ThreadPool/ThreadPool.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    class CTaskGraph;
+
+    /// @class Devel::Threading::CTaskGraphNode
+    /// @brief A task of a CTaskGraph with its successors and dependency counters.
+    ///
+    /// Nodes are aligned to a cache line, so predecessors finishing on different cores do not
+    /// contend on the counters of neighbouring nodes.
+    class alignas(64) CTaskGraphNode {
+        friend class CTaskGraph;
+        friend class CGraphTask;
+
+    public:
+        /// @brief Constructs a node.
+        /// @param i_pGraph The graph owning the node.
+        /// @param i_fnWork The work of the node.
+        CTaskGraphNode(CTaskGraph *i_pGraph, std::function<void()> &&i_fnWork)
+                : m_nPending(0), m_nDependencies(0), m_fnWork(std::move(i_fnWork)), m_pGraph(i_pGraph) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CTaskGraphNode(const CTaskGraphNode &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CTaskGraphNode &operator=(const CTaskGraphNode &) = delete;
+
+    private:
+        /// @var std::atomic<size_t> m_nPending
+        /// @brief The number of predecessors which have not finished in the current run.
+        std::atomic<size_t> m_nPending;
+
+        /// @var size_t m_nDependencies
+        /// @brief The number of predecessors, the pending counter is reset to it before every run.
+        size_t m_nDependencies;
+
+        /// @var std::vector<CTaskGraphNode *> m_apSuccessors
+        /// @brief The nodes which depend on this node.
+        std::vector<CTaskGraphNode *> m_apSuccessors;
+
+        /// @var std::function<void()> m_fnWork
+        /// @brief The work of the node, invoked once per run.
+        std::function<void()> m_fnWork;
+
+        /// @var CTaskGraph *m_pGraph
+        /// @brief The graph owning the node.
+        CTaskGraph *m_pGraph;
+    };
+
+    /// @class Devel::Threading::CGraphTask
+    /// @brief A handle to a task of a CTaskGraph, used to declare the dependencies between tasks.
+    ///
+    /// Handles are cheap to copy and stay valid as long as their graph is not cleared or destroyed.
+    class CGraphTask {
+        friend class CTaskGraph;
+
+    public:
+        /// @brief Constructs a handle which refers to no task.
+        CGraphTask()
+                : m_pNode(nullptr) {
+        }
+
+    public:
+        /// @brief Lets the given tasks start only after this task has finished.
+        /// @param i_aoTasks The successors, they must belong to the same graph.
+        /// @return A reference to this handle.
+        template<typename... Tasks>
+        CGraphTask &precede(const Tasks &... i_aoTasks) {
+            (this->addSuccessor(i_aoTasks), ...);
+            return *this;
+        }
+
+        /// @brief Lets this task start only after the given tasks have finished.
+        /// @param i_aoTasks The predecessors, they must belong to the same graph.
+        /// @return A reference to this handle.
+        template<typename... Tasks>
+        CGraphTask &succeed(const Tasks &... i_aoTasks) {
+            (i_aoTasks.addSuccessor(*this), ...);
+            return *this;
+        }
+
+    public:
+        /// @brief Checks if the handle refers to a task.
+        /// @return True if the handle was returned by CTaskGraph::emplace().
+        bool isValid() const { return this->m_pNode != nullptr; }
+
+        /// @brief Returns the number of tasks this task waits for.
+        /// @return The number of predecessors.
+        size_t dependencyCount() const { return this->m_pNode->m_nDependencies; }
+
+        /// @brief Returns the number of tasks waiting for this task.
+        /// @return The number of successors.
+        size_t successorCount() const { return this->m_pNode->m_apSuccessors.size(); }
+
+    private:
+        /// @brief Constructs a handle of a node.
+        /// @param i_pNode The node.
+        explicit CGraphTask(CTaskGraphNode *i_pNode)
+                : m_pNode(i_pNode) {
+        }
+
+        /// @brief Adds an edge from this task to another one.
+        /// @param i_oTask The successor.
+        void addSuccessor(const CGraphTask &i_oTask) const;
+
+    private:
+        /// @var CTaskGraphNode *m_pNode
+        /// @brief The node, owned by the graph.
+        CTaskGraphNode *m_pNode;
+    };
+
+    /// @class Devel::Threading::CTaskGraph
+    /// @brief A directed acyclic graph of tasks which runs on a CThreadPool.
+    ///
+    /// Tasks are added with emplace() and ordered with precede() and succeed(). A run starts all tasks without
+    /// predecessors, every finished task decrements the counters of its successors and schedules those whose
+    /// counter reaches zero. One ready successor is run directly by the thread which finished the task, the others
+    /// are added to the pool, where they go to the local deque of the worker and are stolen by idle workers.
+    ///
+    /// The graph is kept after a run, so the same graph can be run again without rebuilding it.
+    /// It must not be modified while it is running. A graph with a cycle is rejected when it is run.
+    ///
+    /// If a task throws, the tasks which have not started yet are skipped and the first exception is
+    /// rethrown by wait().
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CThreadPool pool(4);
+    ///     pool.execute();
+    ///
+    ///     Devel::Threading::CTaskGraph graph;
+    ///     Devel::Threading::CGraphTask load = graph.emplace([]() { load(); });
+    ///     Devel::Threading::CGraphTask parse = graph.emplace([]() { parse(); });
+    ///     Devel::Threading::CGraphTask index = graph.emplace([]() { index(); });
+    ///     Devel::Threading::CGraphTask store = graph.emplace([]() { store(); });
+    ///
+    ///     load.precede(parse, index);
+    ///     store.succeed(parse, index);
+    ///
+    ///     // The same graph can run any number of times
+    ///     for (int i = 0; i < 10; i++) {
+    ///         graph.run(pool);
+    ///     }
+    /// @endcode
+    class CTaskGraph {
+        friend class CGraphTask;
+
+    public:
+        /// @brief Constructs an empty graph.
+        CTaskGraph()
+                : m_pPool(nullptr), m_nRemainingSinks(0), m_nSinkCount(0), m_fHasFailed(false),
+                  m_fIsValidated(true), m_fIsRunning(false) {
+        }
+
+        /// @brief Destructor, waits for a running graph to finish.
+        ~CTaskGraph() {
+            std::unique_lock<std::mutex> oLock(this->m_oMutex);
+            this->m_oCondition.wait(oLock, [this]() { return !this->m_fIsRunning; });
+        }
+
+        /// @brief Deleted copy constructor.
+        CTaskGraph(const CTaskGraph &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CTaskGraph &operator=(const CTaskGraph &) = delete;
+
+    public:
+        /// @brief Adds a task to the graph.
+        /// @param i_fnWork The work of the task, it is invoked once per run.
+        /// @return The handle of the task.
+        template<typename F>
+        CGraphTask emplace(F &&i_fnWork) {
+            this->m_fIsValidated = false;
+            return CGraphTask(&this->m_aoNodes.emplace_back(this, std::function<void()>(std::forward<F>(i_fnWork))));
+        }
+
+        /// @brief Removes all tasks, the handles of the graph become invalid.
+        /// @throws GraphIsRunningException if the graph is running.
+        void clear();
+
+    public:
+        /// @brief Starts a run of the graph on a thread pool and returns immediately.
+        /// @param i_oPool The thread pool.
+        /// @throws CyclicGraphException if the graph contains a cycle.
+        /// @throws GraphIsRunningException if the graph is already running.
+        void dispatch(CThreadPool &i_oPool);
+
+        /// @brief Blocks until the current run has finished.
+        /// Must not be called from a task of the pool if the remaining workers cannot finish the graph.
+        /// @throws Rethrows the first exception thrown by a task of the run.
+        void wait();
+
+        /// @brief Runs the graph on a thread pool and blocks until it has finished.
+        /// @param i_oPool The thread pool.
+        /// @throws CyclicGraphException if the graph contains a cycle.
+        /// @throws GraphIsRunningException if the graph is already running.
+        /// @throws Rethrows the first exception thrown by a task of the run.
+        void run(CThreadPool &i_oPool) {
+            this->dispatch(i_oPool);
+            this->wait();
+        }
+
+    public:
+        /// @brief Returns the number of tasks.
+        /// @return The number of tasks.
+        size_t size() const { return this->m_aoNodes.size(); }
+
+        /// @brief Checks if the graph has no tasks.
+        /// @return True if the graph is empty.
+        bool empty() const { return this->m_aoNodes.empty(); }
+
+        /// @brief Checks if a run is in progress.
+        /// @return True if the graph is running.
+        bool isRunning() const {
+            std::lock_guard<std::mutex> oLock(this->m_oMutex);
+            return this->m_fIsRunning;
+        }
+
+    private:
+        /// @brief Checks the graph for cycles and collects the tasks without predecessors.
+        /// The result is kept until the graph is modified.
+        /// @throws CyclicGraphException if the graph contains a cycle.
+        void validate();
+
+        /// @brief Adds a ready node to the thread pool.
+        /// @param i_pNode The node.
+        void schedule(CTaskGraphNode *i_pNode);
+
+        /// @brief Runs a node and the chain of successors it makes ready.
+        /// @param i_pNode The node.
+        void runNode(CTaskGraphNode *i_pNode);
+
+        /// @brief Ends the run, called by the node finishing the last sink.
+        void finish();
+
+    private:
+        /// @var std::deque<CTaskGraphNode> m_aoNodes
+        /// @brief The nodes of the graph, a deque keeps their addresses stable while tasks are added.
+        std::deque<CTaskGraphNode> m_aoNodes;
+
+        /// @var std::vector<CTaskGraphNode *> m_apSources
+        /// @brief The nodes without predecessors, valid while the graph is validated.
+        std::vector<CTaskGraphNode *> m_apSources;
+
+        /// @var CThreadPool *m_pPool
+        /// @brief The thread pool of the current run.
+        CThreadPool *m_pPool;
+
+        /// @var std::atomic<size_t> m_nRemainingSinks
+        /// @brief The number of nodes without successors which have not finished in the current run.
+        /// Only sinks are counted, so inner nodes do not contend on a shared counter.
+        std::atomic<size_t> m_nRemainingSinks;
+
+        /// @var size_t m_nSinkCount
+        /// @brief The number of nodes without successors, valid while the graph is validated.
+        size_t m_nSinkCount;
+
+        /// @var std::atomic<bool> m_fHasFailed
+        /// @brief Whether a task of the current run has thrown.
+        std::atomic<bool> m_fHasFailed;
+
+        /// @var std::exception_ptr m_pException
+        /// @brief The first exception thrown by a task of the current run.
+        std::exception_ptr m_pException;
+
+        /// @var bool m_fIsValidated
+        /// @brief Whether the graph was checked since its last modification.
+        bool m_fIsValidated;
+
+        /// @var bool m_fIsRunning
+        /// @brief Whether a run is in progress, guarded by the mutex.
+        bool m_fIsRunning;
+
+        /// @var std::mutex m_oMutex
+        /// @brief The mutex guarding the run state and the exception.
+        mutable std::mutex m_oMutex;
+
+        /// @var std::condition_variable m_oCondition
+        /// @brief Signalled when a run has finished.
+        std::condition_variable m_oCondition;
+    };
+}
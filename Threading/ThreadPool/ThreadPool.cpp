@@ -1,14 +1,22 @@
 #include "ThreadPool.h"
 #include "Threading/ThreadUtils.h"
 
+/// @var thread_local Devel::Threading::CThreadPoolWorker *s_pCurrentWorker
+/// @brief The worker state of the calling thread, nullptr for threads that are not pool workers.
+static thread_local Devel::Threading::CThreadPoolWorker *s_pCurrentWorker = nullptr;
 
 Devel::Threading::CThreadPool::EError Devel::Threading::CThreadPool::execute() {
     if (!this->m_fIsExecuted) {
-        this->m_aoWorker.reserve(this->m_nWorkerCount);
+        if (this->isElastic()) {
+            this->m_nWorkerCount = std::clamp(this->m_nWorkerCount.load(), this->m_nMinWorkers, this->m_nMaxWorkers);
+        }
+
+        this->m_nLastProgress = CThreadPool::now();
         this->m_fIsExecuted = true;
+        this->spawnWorkers();
 
-        for (size_t i = 0; i < this->m_nWorkerCount; i++) {
-            this->m_aoWorker.emplace_back(&CThreadPool::handleWorker, this);
+        if (this->isElastic()) {
+            this->m_oMonitorThread = std::thread(&CThreadPool::handleMonitor, this);
         }
 
         return CThreadPool::EError::ESuccess;
@@ -19,38 +27,804 @@ Devel::Threading::CThreadPool::EError Devel::Threading::CThreadPool::execute() {
 
 void Devel::Threading::CThreadPool::stop(bool i_fClearTasks) {
     if (this->m_fIsExecuted) {
-        this->m_fIsExecuted = false;
+        {
+            std::lock_guard<std::mutex> oLock(this->m_oWakeMutex);
+            this->m_fIsExecuted = false;
+        }
+        this->m_oWakeCondition.notify_all();
+        this->m_oReservedCondition.notify_all();
+        this->m_oMonitorCondition.notify_all();
+        this->notifyIdle();
+
+        if (this->m_oMonitorThread.joinable()) {
+            this->m_oMonitorThread.join();
+        }
 
-        for (std::thread &oWorker: this->m_aoWorker) {
-            if (oWorker.joinable()) {
-                oWorker.join();
+        // A running task may still call resize() or metrics(), so the threads are joined without the resize mutex.
+        // No thread is started any more, spawnWorkers() checks the executed flag under the mutex.
+        std::vector<std::thread> aoThreads;
+        {
+            std::lock_guard<std::mutex> oResizeLock(this->m_oResizeMutex);
+            const size_t nSlotCount = this->m_nSlotCount;
+            for (size_t i = 0; i < nSlotCount; i++) {
+                aoThreads.push_back(std::move(this->worker(i)->m_oThread));
             }
         }
 
+        for (std::thread &oThread: aoThreads) {
+            if (oThread.joinable()) {
+                oThread.join();
+            }
+        }
+
+        std::lock_guard<std::mutex> oResizeLock(this->m_oResizeMutex);
+        const size_t nSlotCount = this->m_nSlotCount;
+
         if (i_fClearTasks) {
+            // Dropped tasks never finish, only tasks added while stopping are still outstanding
+            this->m_nOutstandingTasks.fetch_sub(this->queuedTaskCount(), std::memory_order_relaxed);
             this->m_aoTasks.clear();
+            this->m_oHighLane.clear();
+            this->m_oBackgroundLane.clear();
+            for (std::unique_ptr<CSafeQueue<ThreadPoolTaskFn, CFutexMutex>> &pNodeTasks: this->m_apNodeTasks) {
+                pNodeTasks->clear();
+            }
+            if (this->m_pBoundedTasks) {
+                this->m_pBoundedTasks->clear();
+            }
+            for (size_t i = 0; i < nSlotCount; i++) {
+                ThreadPoolTaskFn *pTask = nullptr;
+                while (this->worker(i)->m_oDeque.steal(pTask)) {
+                    CThreadPoolWorker::releaseTask(pTask);
+                }
+            }
+        } else {
+            // Keep the tasks of the local deques, they are picked up again by the next execute()
+            for (size_t i = 0; i < nSlotCount; i++) {
+                ThreadPoolTaskFn *pTask = nullptr;
+                while (this->worker(i)->m_oDeque.steal(pTask)) {
+                    if (!this->enqueueShared(std::move(*pTask), false)) {
+                        this->m_aoTasks.enqueue(std::move(*pTask));
+                    }
+                    CThreadPoolWorker::releaseTask(pTask);
+                }
+            }
         }
 
-        this->m_aoWorker.clear();
+        // The worker slots are kept for the next execute(), metrics() reads them without a lock
+        this->m_nActiveWorkers = 0;
+        this->m_nIdleWorkers = 0;
     }
 }
 
-void Devel::Threading::CThreadPool::handleWorker() {
-    while (this->m_fIsExecuted) {
+void Devel::Threading::CThreadPool::resize(const size_t i_nWorkerCount) {
+    size_t nWorkerCount = std::clamp<size_t>(i_nWorkerCount, 1, MaxWorkerCount);
+    if (this->isElastic()) {
+        nWorkerCount = std::clamp(nWorkerCount, this->m_nMinWorkers, this->m_nMaxWorkers);
+    }
+
+    this->m_nWorkerCount = nWorkerCount;
+    if (!this->m_fIsExecuted) {
+        return;
+    }
+
+    this->spawnWorkers();
+
+    // Surplus workers check the worker count before they park, see notifyWorker()
+    {
+        std::lock_guard<std::mutex> oLock(this->m_oWakeMutex);
+    }
+    this->m_oWakeCondition.notify_all();
+    this->m_oReservedCondition.notify_all();
+}
+
+void Devel::Threading::CThreadPool::spawnWorkers() {
+    std::lock_guard<std::mutex> oLock(this->m_oResizeMutex);
+    if (!this->m_fIsExecuted) {
+        return;
+    }
+
+    size_t nSlot = 0;
+    while (this->m_nActiveWorkers < this->m_nWorkerCount) {
+        const size_t nSlotCount = this->m_nSlotCount;
+        while (nSlot < nSlotCount && this->worker(nSlot)->m_fIsRunning) {
+            nSlot++;
+        }
+
+        CThreadPoolWorker *pWorker = nullptr;
+        if (nSlot < nSlotCount) {
+            // The slot of a retired or stopped worker, its thread has left handleWorker() or is about to
+            pWorker = this->worker(nSlot);
+            if (pWorker->m_oThread.joinable()) {
+                pWorker->m_oThread.join();
+            }
+        } else if (nSlotCount < MaxWorkerCount) {
+            // The worker is published before the slot count, so stealers never see an empty slot
+            pWorker = new CThreadPoolWorker(this, nSlot);
+            this->m_apWorker[nSlot].store(pWorker, std::memory_order_release);
+            this->m_nSlotCount.store(nSlotCount + 1, std::memory_order_release);
+        } else {
+            break;
+        }
+
+        this->placeWorker(pWorker);
+        pWorker->m_fIsRunning = true;
+        this->m_nActiveWorkers++;
+        pWorker->m_oThread = std::thread(&CThreadPool::handleWorker, this, pWorker);
+        nSlot++;
+    }
+}
+
+void Devel::Threading::CThreadPool::placeWorker(CThreadPoolWorker *i_pWorker) const {
+    const CCpuTopology *pTopology = CCpuTopology::instance();
+    const std::vector<size_t> anCpus = this->m_anCpus.empty() ? pTopology->cpus() : this->m_anCpus;
 
-        if (this->m_aoTasks.isEmpty()) {
-            Devel::Threading::Utils::sleep(3);
+    i_pWorker->m_anCpus.clear();
+    i_pWorker->m_nNode = i_pWorker->m_nIndex % pTopology->nodeCount();
+
+    if (this->m_eAffinity == EPinToCore) {
+        const size_t nCpu = anCpus[i_pWorker->m_nIndex % anCpus.size()];
+        i_pWorker->m_anCpus.push_back(nCpu);
+        i_pWorker->m_nNode = pTopology->nodeOfCpu(nCpu);
+    } else if (this->m_eAffinity == ESpreadNodes) {
+        // Only nodes owning one of the allowed CPUs take part
+        std::vector<std::vector<size_t>> aanNodeCpus(pTopology->nodeCount());
+        std::vector<size_t> anNodes;
+        for (const size_t nCpu: anCpus) {
+            const size_t nNode = pTopology->nodeOfCpu(nCpu);
+            if (aanNodeCpus[nNode].empty()) {
+                anNodes.push_back(nNode);
+            }
+            aanNodeCpus[nNode].push_back(nCpu);
+        }
+
+        std::sort(anNodes.begin(), anNodes.end());
+        i_pWorker->m_nNode = anNodes[i_pWorker->m_nIndex % anNodes.size()];
+        i_pWorker->m_anCpus = std::move(aanNodeCpus[i_pWorker->m_nNode]);
+    }
+}
+
+void Devel::Threading::CThreadPool::setNodeLocalQueues(const bool i_fUseNodeQueues) {
+    if (this->m_fIsExecuted || i_fUseNodeQueues == this->hasNodeLocalQueues()) {
+        return;
+    }
+
+    if (i_fUseNodeQueues) {
+        const size_t nNodeCount = CCpuTopology::instance()->nodeCount();
+        for (size_t i = 0; i < nNodeCount; i++) {
+            this->m_apNodeTasks.emplace_back(std::make_unique<CSafeQueue<ThreadPoolTaskFn, CFutexMutex>>());
+        }
+    } else {
+        for (std::unique_ptr<CSafeQueue<ThreadPoolTaskFn, CFutexMutex>> &pNodeTasks: this->m_apNodeTasks) {
+            std::queue<ThreadPoolTaskFn> afnTasks;
+            pNodeTasks->swapAll(afnTasks);
+            while (!afnTasks.empty()) {
+                this->m_aoTasks.enqueue(std::move(afnTasks.front()));
+                afnTasks.pop();
+            }
+        }
+        this->m_apNodeTasks.clear();
+    }
+}
+
+bool Devel::Threading::CThreadPool::tryRetire() {
+    size_t nActive = this->m_nActiveWorkers;
+    while (nActive > this->m_nWorkerCount) {
+        if (this->m_nActiveWorkers.compare_exchange_weak(nActive, nActive - 1)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Devel::Threading::CThreadPool::tryShrink() {
+    size_t nWorkerCount = this->m_nWorkerCount;
+    while (nWorkerCount > this->m_nMinWorkers) {
+        if (this->m_nWorkerCount.compare_exchange_weak(nWorkerCount, nWorkerCount - 1)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Devel::Threading::CThreadPool::handleMonitor() {
+    const Duration oInterval = std::max<Duration>(this->m_oGrowLatency / 2, std::chrono::microseconds(100));
+    const uint64_t nGrowLatencyNs =
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(this->m_oGrowLatency).count());
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> oLock(this->m_oWakeMutex);
+            if (this->m_oMonitorCondition.wait_for(oLock, oInterval, [this]() { return !this->m_fIsExecuted; })) {
+                return;
+            }
+        }
+
+        // The queue latency is the longest wait of the tasks picked up since the last check. While no task is
+        // picked up at all, the time since the last pickup bounds the wait of the queued tasks from below.
+        const uint64_t nQueueWaitNs = this->m_nQueueWaitNs.exchange(0, std::memory_order_relaxed);
+        if (this->m_nIdleWorkers != 0 || !this->hasPendingTask()) {
+            continue;
+        }
+
+        if (nQueueWaitNs < nGrowLatencyNs &&
+            CThreadPool::now() - this->m_nLastProgress.load(std::memory_order_relaxed) < this->m_oGrowLatency.count()) {
             continue;
         }
 
+        size_t nWorkerCount = this->m_nWorkerCount;
+        if (nWorkerCount < this->m_nMaxWorkers &&
+            this->m_nWorkerCount.compare_exchange_strong(nWorkerCount, nWorkerCount + 1)) {
+            this->m_nLastProgress = CThreadPool::now();
+            this->spawnWorkers();
+        }
+    }
+}
+
+Devel::Threading::CThreadPool::CTimedTaskRunner::CTimedTaskRunner(CThreadPool *i_pPool, ThreadPoolTaskFn &&i_fnTask,
+                                                                  const ETaskPriority i_ePriority)
+        : m_pPool(i_pPool), m_pTask(new(CPoolAllocator<CTimedTask>::allocate()) CTimedTask()) {
+    this->m_pTask->m_fnTask = std::move(i_fnTask);
+    this->m_pTask->m_nEnqueueNs = CWorkerCounters::now();
+    this->m_pTask->m_ePriority = i_ePriority;
+}
+
+Devel::Threading::CThreadPool::CTimedTaskRunner::~CTimedTaskRunner() {
+    if (this->m_pTask) {
+        this->m_pTask->~CTimedTask();
+        CPoolAllocator<CTimedTask>::deallocate(this->m_pTask);
+    }
+}
+
+void Devel::Threading::CThreadPool::CTimedTaskRunner::operator()() {
+    const uint64_t nStartNs = CWorkerCounters::now();
+    std::exception_ptr pException;
+
+    // The monitor of an elastic pool grows the pool on the queue latency, it is reported before the task runs
+    if (this->m_pPool->isElastic()) {
+        this->m_pPool->recordQueueWait(nStartNs - this->m_pTask->m_nEnqueueNs);
+    }
+
+    try {
+        this->m_pTask->m_fnTask();
+    } catch (...) {
+        pException = std::current_exception();
+    }
+
+    // A task run inline by a foreign thread, e.g. on a full bounded queue, has no counters to record on.
+    // A task dropped by its token did not run, it has no run time.
+    CThreadPoolWorker *pWorker = this->m_pPool->localWorker();
+    if (pWorker && this->m_pPool->hasTaskTiming() && !pWorker->m_fHasDroppedTask) {
+        pWorker->m_oCounters.recordTask(this->m_pTask->m_ePriority, nStartNs - this->m_pTask->m_nEnqueueNs,
+                                        CWorkerCounters::now() - nStartNs);
+    }
+
+    if (pException) {
+        std::rethrow_exception(pException);
+    }
+}
+
+Devel::Threading::CThreadPool::CGuardedTaskRunner::CGuardedTaskRunner(CThreadPool *i_pPool,
+                                                                      ThreadPoolTaskFn &&i_fnTask,
+                                                                      const CCancellationToken &i_oToken)
+        : m_pTask(new(CPoolAllocator<CGuardedTask>::allocate())
+                          CGuardedTask{std::move(i_fnTask), i_oToken, i_pPool}) {
+}
+
+Devel::Threading::CThreadPool::CGuardedTaskRunner::~CGuardedTaskRunner() {
+    if (this->m_pTask) {
+        this->m_pTask->~CGuardedTask();
+        CPoolAllocator<CGuardedTask>::deallocate(this->m_pTask);
+    }
+}
+
+void Devel::Threading::CThreadPool::CGuardedTaskRunner::operator()() {
+    if (!this->m_pTask->m_pPool->dropCancelled(this->m_pTask->m_oToken)) {
+        this->m_pTask->m_fnTask();
+    }
+}
+
+bool Devel::Threading::CThreadPool::dropCancelled(const CCancellationToken &i_oToken) const {
+    if (!i_oToken.isCancelled()) {
+        return false;
+    }
+
+    // A task run outside of a worker of this pool has no counters to record on
+    CThreadPoolWorker *pWorker = this->localWorker();
+    if (pWorker) {
+        CWorkerCounters &oCounters = pWorker->m_oCounters;
+        CWorkerCounters::add(i_oToken.hasExpired() ? oCounters.m_nExpired : oCounters.m_nCancelled, 1);
+        pWorker->m_fHasDroppedTask = true;
+    }
+
+    return true;
+}
+
+void Devel::Threading::CThreadPool::waitIdle() {
+    // The waiter count is raised before the outstanding count is checked, see finishTask()
+    this->m_nIdleWaiters.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> oLock(this->m_oIdleMutex);
+        this->m_oIdleCondition.wait(oLock, [this]() {
+            return this->m_nOutstandingTasks.load() == 0 || !this->m_fIsExecuted;
+        });
+    }
+    this->m_nIdleWaiters.fetch_sub(1);
+}
+
+void Devel::Threading::CThreadPool::finishTask() {
+    // Either the last task sees the waiter, or the waiter sees the outstanding count at zero
+    if (this->m_nOutstandingTasks.fetch_sub(1) == 1 && this->m_nIdleWaiters.load() != 0) {
+        this->notifyIdle();
+    }
+}
+
+void Devel::Threading::CThreadPool::notifyIdle() {
+    {
+        std::lock_guard<std::mutex> oLock(this->m_oIdleMutex);
+    }
+    this->m_oIdleCondition.notify_all();
+}
+
+void Devel::Threading::CThreadPool::addTask(ThreadPoolTaskFn &&i_oTask, const ETaskPriority i_ePriority) {
+    this->m_nOutstandingTasks.fetch_add(1, std::memory_order_relaxed);
+
+    // The tasks of an elastic pool are stamped as well, the monitor grows the pool on their queue latency
+    if (this->m_fHasTaskTiming.load(std::memory_order_relaxed) || this->isElastic()) {
+        i_oTask = ThreadPoolTaskFn(CTimedTaskRunner(this, std::move(i_oTask), i_ePriority));
+    }
+
+    if (i_ePriority != ENormalPriority) {
+        this->lane(i_ePriority).enqueue(std::move(i_oTask));
+        this->notifyWorker(i_ePriority);
+        return;
+    }
+
+    CThreadPoolWorker *pWorker = this->localWorker();
+
+    // A reserved worker never pops its own deque, its tasks would wait for a thief
+    if (pWorker && this->m_eMode == EWorkStealing && !this->isReserved(pWorker)) {
+        pWorker->m_oDeque.push(CThreadPoolWorker::allocateTask(std::move(i_oTask)));
+    } else if (!this->enqueueShared(std::move(i_oTask), !pWorker)) {
+        // The bounded queue is full and a worker or a caller of a stopped pool must not block on it,
+        // so the caller runs the task. The drop flag of the worker belongs to the enclosing task, it is restored.
+        const bool fHasDroppedTask = pWorker && std::exchange(pWorker->m_fHasDroppedTask, false);
+        CThreadPool::runTask(pWorker, i_oTask);
+        if (pWorker) {
+            pWorker->m_fHasDroppedTask = fHasDroppedTask;
+        }
+        i_oTask = nullptr;
+        this->finishTask();
+        return;
+    }
+
+    this->notifyWorker();
+}
+
+void Devel::Threading::CThreadPool::addTask(ThreadPoolTaskFn &&i_oTask, const CCancellationToken &i_oToken,
+                                            const ETaskPriority i_ePriority) {
+    if (!i_oToken.canBeCancelled()) {
+        return this->addTask(std::move(i_oTask), i_ePriority);
+    }
+
+    this->addTask(ThreadPoolTaskFn(CGuardedTaskRunner(this, std::move(i_oTask), i_oToken)), i_ePriority);
+}
+
+void Devel::Threading::CThreadPool::setQueueType(const EQueueType i_eQueueType) {
+    if (this->m_fIsExecuted || this->m_eQueueType == i_eQueueType) {
+        return;
+    }
+
+    this->m_eQueueType = i_eQueueType;
+    if (i_eQueueType == EBoundedQueue) {
+        this->m_pBoundedTasks = std::make_unique<CBoundedQueue<ThreadPoolTaskFn, BoundedQueueCapacity>>();
+        ThreadPoolTaskFn fnTask;
+        while (this->m_pBoundedTasks->size() < BoundedQueueCapacity && this->m_aoTasks.tryDequeue(fnTask)) {
+            this->m_pBoundedTasks->tryEnqueue(std::move(fnTask));
+        }
+    } else {
+        std::vector<ThreadPoolTaskFn> afnTasks;
+        afnTasks.reserve(this->m_pBoundedTasks->size());
+
+        ThreadPoolTaskFn fnTask;
+        while (this->m_pBoundedTasks->tryDequeue(fnTask)) {
+            afnTasks.emplace_back(std::move(fnTask));
+        }
+
+        this->m_aoTasks.enqueueBulk(std::move(afnTasks));
+        this->m_pBoundedTasks.reset();
+    }
+}
+
+bool Devel::Threading::CThreadPool::enqueueShared(ThreadPoolTaskFn &&i_oTask, const bool i_fMayBlock) {
+    if (this->m_eQueueType == EBoundedQueue) {
+        // Only running workers make room, the caller would spin forever before execute() or after stop()
+        for (size_t nAttempt = 0; !this->m_pBoundedTasks->tryEnqueue(std::move(i_oTask)); nAttempt++) {
+            if (!i_fMayBlock || !this->m_fIsExecuted) {
+                return false;
+            }
+
+            if (nAttempt < 64) {
+                Devel::Threading::Utils::cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        return true;
+    }
+
+    if (!this->m_apNodeTasks.empty()) {
+        const CThreadPoolWorker *pWorker = this->localWorker();
+        const size_t nNode = pWorker ? pWorker->m_nNode : CCpuTopology::instance()->currentNode();
+
+        this->m_apNodeTasks[nNode % this->m_apNodeTasks.size()]->enqueue(std::move(i_oTask));
+        return true;
+    }
+
+    this->m_aoTasks.enqueue(std::move(i_oTask));
+    return true;
+}
+
+bool Devel::Threading::CThreadPool::dequeueShared(ThreadPoolTaskFn &i_fnOutTask, const size_t i_nNode) {
+    const size_t nNodeCount = this->m_apNodeTasks.size();
+    if (nNodeCount != 0 && this->m_apNodeTasks[i_nNode % nNodeCount]->tryDequeue(i_fnOutTask)) {
+        return true;
+    }
+
+    if (this->m_eQueueType == EBoundedQueue && this->m_pBoundedTasks->tryDequeue(i_fnOutTask)) {
+        return true;
+    }
+
+    if (this->m_aoTasks.tryDequeue(i_fnOutTask)) {
+        return true;
+    }
+
+    // The own node has run dry, help out on the remote nodes
+    for (size_t i = 1; i < nNodeCount; i++) {
+        if (this->m_apNodeTasks[(i_nNode + i) % nNodeCount]->tryDequeue(i_fnOutTask)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Devel::Threading::CThreadPoolMetrics Devel::Threading::CThreadPool::metrics() const {
+    CThreadPoolMetrics oMetrics;
+
+    // Worker slots are only deleted by the destructor, so the snapshot is taken without a lock
+    const size_t nSlotCount = this->m_nSlotCount.load(std::memory_order_acquire);
+    const uint64_t nNowNs = CWorkerCounters::now();
+
+    oMetrics.m_aoWorkers.resize(nSlotCount);
+    for (size_t i = 0; i < nSlotCount; i++) {
+        const CThreadPoolWorker *pWorker = this->worker(i);
+        const CWorkerCounters &oCounters = pWorker->m_oCounters;
+        CWorkerMetrics &oWorker = oMetrics.m_aoWorkers[i];
+
+        const uint64_t nStartNs = oCounters.m_nStartNs.load(std::memory_order_relaxed);
+        oWorker.m_nIndex = i;
+        oWorker.m_fIsRunning = pWorker->m_fIsRunning.load(std::memory_order_relaxed);
+        oWorker.m_nExecuted = oCounters.m_nExecuted.load(std::memory_order_relaxed);
+        oWorker.m_nFailed = oCounters.m_nFailed.load(std::memory_order_relaxed);
+        oWorker.m_nStolen = oCounters.m_nStolen.load(std::memory_order_relaxed);
+        oWorker.m_nCancelled = oCounters.m_nCancelled.load(std::memory_order_relaxed);
+        oWorker.m_nExpired = oCounters.m_nExpired.load(std::memory_order_relaxed);
+        oWorker.m_nQueueDepth = pWorker->m_oDeque.size();
+        oWorker.m_nUptimeNs = oCounters.m_nRetiredUptimeNs.load(std::memory_order_relaxed) +
+                              ((nStartNs != 0 && nNowNs > nStartNs) ? nNowNs - nStartNs : 0);
+        // A worker which is parked right now has not added its current idle time yet
+        const uint64_t nParkedSinceNs = oCounters.m_nParkedSinceNs.load(std::memory_order_relaxed);
+        oWorker.m_nIdleNs = oCounters.m_nIdleNs.load(std::memory_order_relaxed) +
+                            ((nParkedSinceNs != 0 && nNowNs > nParkedSinceNs) ? nNowNs - nParkedSinceNs : 0);
+        oWorker.m_nTimedTasks = oCounters.m_nTimedTasks.load(std::memory_order_relaxed);
+        oWorker.m_nWaitNs = oCounters.m_nWaitNs.load(std::memory_order_relaxed);
+        oWorker.m_nRunNs = oCounters.m_nRunNs.load(std::memory_order_relaxed);
+
+        for (size_t nLane = 0; nLane < TaskPriorityCount; nLane++) {
+            oWorker.m_anLaneTimedTasks[nLane] = oCounters.m_anLaneTimedTasks[nLane].load(std::memory_order_relaxed);
+            oWorker.m_anLaneWaitNs[nLane] = oCounters.m_anLaneWaitNs[nLane].load(std::memory_order_relaxed);
+            for (size_t nBucket = 0; nBucket < PoolHistogramBuckets; nBucket++) {
+                oWorker.m_aanLaneWaitHistogram[nLane][nBucket] =
+                        oCounters.m_aanLaneWaitHistogram[nLane][nBucket].load(std::memory_order_relaxed);
+            }
+        }
+
+        for (size_t nBucket = 0; nBucket < PoolHistogramBuckets; nBucket++) {
+            oWorker.m_anWaitHistogram[nBucket] = oCounters.m_anWaitHistogram[nBucket].load(std::memory_order_relaxed);
+            oWorker.m_anRunHistogram[nBucket] = oCounters.m_anRunHistogram[nBucket].load(std::memory_order_relaxed);
+        }
+    }
+
+    size_t &nNormalDepth = oMetrics.m_anLaneQueueDepth[ENormalPriority];
+    nNormalDepth = this->m_aoTasks.size();
+    for (const std::unique_ptr<CSafeQueue<ThreadPoolTaskFn, CFutexMutex>> &pNodeTasks: this->m_apNodeTasks) {
+        nNormalDepth += pNodeTasks->size();
+    }
+    if (this->m_eQueueType == EBoundedQueue) {
+        nNormalDepth += this->m_pBoundedTasks->size();
+    }
+    oMetrics.m_anLaneQueueDepth[EHighPriority] = this->m_oHighLane.size();
+    oMetrics.m_anLaneQueueDepth[EBackgroundPriority] = this->m_oBackgroundLane.size();
+    oMetrics.m_nSharedQueueDepth = nNormalDepth + this->m_oHighLane.size() + this->m_oBackgroundLane.size();
+
+    oMetrics.m_nWorkerCount = this->m_nActiveWorkers;
+    oMetrics.m_nIdleWorkers = this->m_nIdleWorkers;
+    return oMetrics;
+}
+
+size_t Devel::Threading::CThreadPool::queuedTaskCount() const {
+    size_t nCount = this->m_aoTasks.size() + this->m_oHighLane.size() + this->m_oBackgroundLane.size();
+    for (const std::unique_ptr<CSafeQueue<ThreadPoolTaskFn, CFutexMutex>> &pNodeTasks: this->m_apNodeTasks) {
+        nCount += pNodeTasks->size();
+    }
+    if (this->m_eQueueType == EBoundedQueue) {
+        nCount += this->m_pBoundedTasks->size();
+    }
+
+    const size_t nSlotCount = this->m_nSlotCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < nSlotCount; i++) {
+        nCount += this->worker(i)->m_oDeque.size();
+    }
+
+    return nCount;
+}
+
+bool Devel::Threading::CThreadPool::isSharedEmpty() const {
+    for (const std::unique_ptr<CSafeQueue<ThreadPoolTaskFn, CFutexMutex>> &pNodeTasks: this->m_apNodeTasks) {
+        if (!pNodeTasks->isEmpty()) {
+            return false;
+        }
+    }
+
+    return this->m_oHighLane.isEmpty() && this->m_oBackgroundLane.isEmpty() && this->m_aoTasks.isEmpty() &&
+           (this->m_eQueueType != EBoundedQueue || this->m_pBoundedTasks->isEmpty());
+}
+
+Devel::Threading::CThreadPoolWorker *Devel::Threading::CThreadPool::currentWorker() {
+    return s_pCurrentWorker;
+}
+
+Devel::Threading::CThreadPoolWorker *Devel::Threading::CThreadPool::localWorker() const {
+    return (s_pCurrentWorker && s_pCurrentWorker->pool() == this) ? s_pCurrentWorker : nullptr;
+}
+
+bool Devel::Threading::CThreadPool::hasPendingTask() const {
+    if (!this->isSharedEmpty()) {
+        return true;
+    }
+
+    if (this->m_eMode == EWorkStealing) {
+        const size_t nSlotCount = this->m_nSlotCount.load(std::memory_order_acquire);
+        for (size_t i = 0; i < nSlotCount; i++) {
+            if (!this->worker(i)->m_oDeque.isEmpty()) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool Devel::Threading::CThreadPool::hasPendingTask(const CThreadPoolWorker *i_pWorker) const {
+    return this->isReserved(i_pWorker) ? !this->m_oHighLane.isEmpty() : this->hasPendingTask();
+}
+
+void Devel::Threading::CThreadPool::waitForTask(CThreadPoolWorker *i_pWorker) {
+    // A resize can end the reservation of a parked worker, it then returns to park on the other condition
+    const bool fIsReserved = this->isReserved(i_pWorker);
+    const auto fnIsReady = [this, i_pWorker, fIsReserved]() {
+        return this->hasPendingTask(i_pWorker) || !this->m_fIsExecuted || this->hasSurplusWorker() ||
+               this->isReserved(i_pWorker) != fIsReserved;
+    };
+    std::condition_variable &oCondition = fIsReserved ? this->m_oReservedCondition : this->m_oWakeCondition;
+
+    for (size_t i = 0; i < this->m_nSpinCount; i++) {
+        if (fnIsReady()) {
+            return;
+        }
+
+        Devel::Threading::Utils::cpuRelax();
+    }
+
+    // Only the parked time is idle time, the clock is read on the slow path only
+    const uint64_t nParkNs = CWorkerCounters::now();
+    i_pWorker->m_oCounters.m_nParkedSinceNs.store(nParkNs, std::memory_order_relaxed);
+    this->m_nIdleWorkers++;
+    {
+        std::unique_lock<std::mutex> oLock(this->m_oWakeMutex);
+        if (!this->isElastic()) {
+            oCondition.wait(oLock, fnIsReady);
+        } else if (!oCondition.wait_for(oLock, this->m_oIdleTimeout, fnIsReady)) {
+            // Idle for the whole timeout, the worker retires in handleWorker() if the count was decreased
+            this->tryShrink();
+        }
+    }
+    this->m_nIdleWorkers--;
+    // The park is cleared before its time is added, a snapshot in between misses it instead of counting it twice
+    i_pWorker->m_oCounters.m_nParkedSinceNs.exchange(0, std::memory_order_relaxed);
+    CWorkerCounters::add(i_pWorker->m_oCounters.m_nIdleNs, CWorkerCounters::now() - nParkNs);
+}
+
+void Devel::Threading::CThreadPool::notifyWorker(const ETaskPriority i_ePriority) {
+    // Acquiring the wake mutex orders the enqueue before a worker that is just about to park,
+    // so the notification can not get lost between its predicate check and the wait.
+    {
+        std::lock_guard<std::mutex> oLock(this->m_oWakeMutex);
+    }
+
+    // The reserved workers may all be busy, so another worker is woken as well
+    if (i_ePriority == EHighPriority && this->m_nReservedWorkers != 0) {
+        this->m_oReservedCondition.notify_one();
+    }
+    this->m_oWakeCondition.notify_one();
+}
+
+bool Devel::Threading::CThreadPool::fetchTask(CThreadPoolWorker *i_pWorker, ThreadPoolTaskFn &i_fnOutTask) {
+    if (this->isReserved(i_pWorker)) {
+        return this->m_oHighLane.tryDequeue(i_fnOutTask);
+    }
+
+    if (this->m_eLanePolicy == EStrictPriority) {
+        return this->m_oHighLane.tryDequeue(i_fnOutTask) || this->fetchNormalTask(i_pWorker, i_fnOutTask) ||
+               this->m_oBackgroundLane.tryDequeue(i_fnOutTask);
+    }
+
+    // Smooth weighted round robin: every fetch credits each lane with its weight and the served lane pays the
+    // sum of the weights, so the lanes are interleaved by weight instead of served in bursts
+    std::array<int64_t, TaskPriorityCount> &anCredits = i_pWorker->m_anLaneCredits;
+    std::array<ETaskPriority, TaskPriorityCount> aeOrder = {EHighPriority, ENormalPriority, EBackgroundPriority};
+    int64_t nTotal = 0;
+
+    for (size_t i = 0; i < TaskPriorityCount; i++) {
+        anCredits[i] += this->m_anLaneWeights[i];
+        nTotal += this->m_anLaneWeights[i];
+    }
+    std::stable_sort(aeOrder.begin(), aeOrder.end(), [&anCredits](const ETaskPriority i_eA, const ETaskPriority i_eB) {
+        return anCredits[i_eA] > anCredits[i_eB];
+    });
+
+    for (const ETaskPriority ePriority: aeOrder) {
+        if (this->fetchLaneTask(i_pWorker, ePriority, i_fnOutTask)) {
+            anCredits[ePriority] -= nTotal;
+
+            // An empty lane must not save up credits for a burst once it fills up again
+            for (int64_t &nCredit: anCredits) {
+                nCredit = std::clamp(nCredit, -nTotal, nTotal);
+            }
+            return true;
+        }
+    }
+
+    anCredits.fill(0);
+    return false;
+}
+
+bool Devel::Threading::CThreadPool::fetchLaneTask(CThreadPoolWorker *i_pWorker, const ETaskPriority i_ePriority,
+                                                  ThreadPoolTaskFn &i_fnOutTask) {
+    if (i_ePriority == ENormalPriority) {
+        return this->fetchNormalTask(i_pWorker, i_fnOutTask);
+    }
+
+    return this->lane(i_ePriority).tryDequeue(i_fnOutTask);
+}
+
+bool Devel::Threading::CThreadPool::fetchNormalTask(CThreadPoolWorker *i_pWorker, ThreadPoolTaskFn &i_fnOutTask) {
+    ThreadPoolTaskFn *pTask = nullptr;
+
+    if (this->m_eMode == EWorkStealing && i_pWorker->m_oDeque.pop(pTask)) {
+        i_fnOutTask = std::move(*pTask);
+        CThreadPoolWorker::releaseTask(pTask);
+        return true;
+    }
+
+    if (this->dequeueShared(i_fnOutTask, i_pWorker->m_nNode)) {
+        return true;
+    }
+
+    if (this->m_eMode == EWorkStealing) {
+        const size_t nSlotCount = this->m_nSlotCount.load(std::memory_order_acquire);
+        const size_t nStart = static_cast<size_t>(i_pWorker->nextRandom() % nSlotCount);
+
+        for (size_t i = 0; i < nSlotCount; i++) {
+            CThreadPoolWorker *pVictim = this->worker((nStart + i) % nSlotCount);
+
+            if (pVictim != i_pWorker && pVictim->m_oDeque.steal(pTask)) {
+                i_fnOutTask = std::move(*pTask);
+                CThreadPoolWorker::releaseTask(pTask);
+                CWorkerCounters::add(i_pWorker->m_oCounters.m_nStolen, 1);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void Devel::Threading::CThreadPool::handleWorker(CThreadPoolWorker *i_pWorker) {
+    s_pCurrentWorker = i_pWorker;
+
+    if (!this->m_stThreadName.empty()) {
+        Devel::Threading::Utils::setCurrentThreadName(this->m_stThreadName + '-' + std::to_string(i_pWorker->m_nIndex));
+    }
+    if (!i_pWorker->m_anCpus.empty()) {
+        Devel::Threading::Utils::setCurrentThreadAffinity(i_pWorker->m_anCpus);
+    }
+
+    i_pWorker->m_oCounters.m_nStartNs.store(CWorkerCounters::now(), std::memory_order_relaxed);
+    bool fHasRetired = false;
+
+    while (this->m_fIsExecuted) {
+        if (this->hasSurplusWorker() && this->tryRetire()) {
+            fHasRetired = true;
+            break;
+        }
+
         ThreadPoolTaskFn fnTask = nullptr;
 
-        try {
-            fnTask = this->m_aoTasks.dequeue();
-        } catch (const std::range_error &) {}
+        if (!this->fetchTask(i_pWorker, fnTask)) {
+            this->waitForTask(i_pWorker);
+            continue;
+        }
+
+        if (this->isElastic()) {
+            this->m_nLastProgress.store(CThreadPool::now(), std::memory_order_relaxed);
+        }
 
         if (fnTask) {
-            fnTask();
+            CThreadPool::runTask(i_pWorker, fnTask);
         }
+
+        // The captures of the task are released before waitIdle() can return
+        fnTask = nullptr;
+        i_pWorker->resetScratch();
+        this->finishTask();
     }
-}
\ No newline at end of file
+
+    if (fHasRetired) {
+        // Hand the local deque over to the remaining workers, nothing queued is dropped by a resize
+        ThreadPoolTaskFn *pTask = nullptr;
+        bool fHasMoved = false;
+
+        while (i_pWorker->m_oDeque.pop(pTask)) {
+            if (!this->enqueueShared(std::move(*pTask), false)) {
+                this->m_aoTasks.enqueue(std::move(*pTask));
+            }
+            CThreadPoolWorker::releaseTask(pTask);
+            fHasMoved = true;
+        }
+
+        if (fHasMoved) {
+            {
+                std::lock_guard<std::mutex> oLock(this->m_oWakeMutex);
+            }
+            this->m_oWakeCondition.notify_all();
+        }
+    }
+
+    CWorkerCounters &oCounters = i_pWorker->m_oCounters;
+    CWorkerCounters::add(oCounters.m_nRetiredUptimeNs,
+                         CWorkerCounters::now() - oCounters.m_nStartNs.load(std::memory_order_relaxed));
+    oCounters.m_nStartNs.store(0, std::memory_order_relaxed);
+
+    s_pCurrentWorker = nullptr;
+    i_pWorker->m_fIsRunning.store(false, std::memory_order_release);
+}
+
+void Devel::Threading::CThreadPool::runTask(CThreadPoolWorker *i_pWorker, ThreadPoolTaskFn &i_fnTask) {
+    try {
+        i_fnTask();
+    } catch (...) {
+        if (i_pWorker) {
+            CWorkerCounters::add(i_pWorker->m_oCounters.m_nFailed, 1);
+        }
+    }
+
+    // A dropped task is counted as cancelled or expired instead, see dropCancelled()
+    if (i_pWorker && !std::exchange(i_pWorker->m_fHasDroppedTask, false)) {
+        CWorkerCounters::add(i_pWorker->m_oCounters.m_nExecuted, 1);
+    }
+}
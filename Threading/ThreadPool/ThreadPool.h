@@ -1,18 +1,73 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <thread>
+#include <chrono>
+#include <coroutine>
 #include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "Threading/SafeQueue/SafeQueue.h"
+#include "Threading/FutexMutex/FutexMutex.h"
+#include "Threading/BoundedQueue/BoundedQueue.h"
+#include "Threading/ThreadPool/ThreadPoolWorker.h"
+#include "Threading/CpuTopology/CpuTopology.h"
+#include "Threading/TaskFuture/TaskFuture.h"
+#include "Threading/CancellationToken/CancellationToken.h"
 
 /// @namespace Devel::Threading
 /// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
 namespace Devel::Threading {
-    typedef std::function<void()> ThreadPoolTaskFn;
-
     /// @class CThreadPool
     /// @brief A class that implements a thread pool for executing tasks concurrently.
     ///
-    /// The CThreadPool class manages a fixed number of worker threads that execute tasks from a task queue.
+    /// The CThreadPool class manages a set of worker threads that execute tasks from a task queue.
+    /// Idle workers are parked on a condition variable and are woken up as soon as a task is added.
+    /// For latency-critical pools a spin phase can be configured with setSpinCount(), during which an idle
+    /// worker keeps polling the queue before it parks.
+    ///
+    /// In EWorkStealing mode every worker owns a lock-free deque. Tasks added from inside a worker are pushed
+    /// to its own deque, tasks added from other threads go through the shared injection queue, and idle workers
+    /// steal from the deques of random victims.
+    ///
+    /// The shared queue is a CSafeQueue by default. With setQueueType(EBoundedQueue) a lock-free CBoundedQueue
+    /// is used instead. When it is full, foreign threads block in addTask() until space is available,
+    /// while workers of the pool run the task inline to avoid a deadlock.
+    ///
+    /// By default the number of workers is fixed. setWorkerLimits() makes the pool elastic: a monitor thread adds
+    /// a worker whenever tasks are waiting, no worker is idle and the queue latency exceeds the grow latency, and a
+    /// worker which stayed idle for the idle timeout retires, down to the minimum. The queue latency is the longest
+    /// wait of the tasks picked up since the last check, or the time since the last pickup if no task was picked up.
+    /// resize() changes the number of workers of a running pool without dropping queued tasks, retiring workers
+    /// hand the tasks of their local deque back to the shared queue.
+    ///
+    /// setAffinity() places the workers on the CPUs of the machine, either one core per worker or one NUMA node
+    /// per worker, see CCpuTopology. With setNodeLocalQueues() the unbounded shared queue is split into one queue
+    /// per NUMA node: tasks are queued on the node of the submitting thread and workers prefer the queue of their
+    /// own node before they help out on the other nodes. Worker threads are named "<thread name>-<index>".
+    ///
+    /// Tasks are queued in one of three priority lanes, see ETaskPriority. The normal lane is the queue described
+    /// above, the high and background lanes are shared queues of their own. By default workers serve the lanes in
+    /// strict priority order, with setLanePolicy(EWeightedFair) they share out the tasks by the lane weights so
+    /// the background lane is never starved. setReservedWorkers() dedicates workers to the high lane, they stay
+    /// available for it while the other workers are busy with bulk work.
+    ///
+    /// Every worker counts the tasks it ran, the tasks it stole and the time it was parked. setTaskTiming() adds
+    /// histograms of the queue wait time and the run time of every task, the wait time also per lane. metrics() collects a snapshot of all
+    /// counters without touching the task path, it is meant to be scraped periodically.
+    ///
+    /// Tasks can be added with a CCancellationToken. A worker drops a task whose token was cancelled or whose
+    /// deadline has passed when it picks the task up, instead of running it, and counts the drop in the metrics.
+    /// Running tasks poll the token themselves.
+    ///
+    /// Tasks added with addTask() must not throw, exceptions escaping them are dropped by the worker.
+    /// Use submit() to get a CTaskFuture which carries the result or the exception of the task.
     class CThreadPool {
     public:
         /// @enum EError
@@ -22,10 +77,247 @@ namespace Devel::Threading {
             EAlreadyExecuted,   ///< The thread pool has already been executed.
         };
 
+        /// @enum EMode
+        /// @brief An enumeration of the scheduling modes of the thread pool.
+        enum EMode {
+            ESharedQueue,       ///< All workers pull from one shared task queue.
+            EWorkStealing,      ///< Every worker has a local deque and idle workers steal from each other.
+        };
+
+        /// @enum EQueueType
+        /// @brief An enumeration of the queue types backing the shared task queue.
+        enum EQueueType {
+            EUnboundedQueue,    ///< A futex mutex protected CSafeQueue without size limit.
+            EBoundedQueue,      ///< A lock-free CBoundedQueue with BoundedQueueCapacity slots.
+        };
+
+        /// @enum EAffinity
+        /// @brief An enumeration of the CPU placements of the workers.
+        enum EAffinity {
+            EFloating,          ///< The operating system schedules the workers on any CPU.
+            EPinToCore,         ///< Every worker is pinned to a single CPU, round robin over the CPU set.
+            ESpreadNodes,       ///< Workers are spread round robin over the NUMA nodes and float within their node.
+        };
+
+        /// @enum ELanePolicy
+        /// @brief An enumeration of the ways workers choose between the priority lanes.
+        enum ELanePolicy {
+            EStrictPriority,    ///< A lane is only served while all higher lanes are empty.
+            EWeightedFair,      ///< Every worker serves the non-empty lanes in proportion to the lane weights.
+        };
+
+        /// @var static constexpr size_t BoundedQueueCapacity
+        /// @brief The number of slots of the shared queue in EBoundedQueue mode.
+        static constexpr size_t BoundedQueueCapacity = 4096;
+
+        /// @var static constexpr size_t MaxWorkerCount
+        /// @brief The maximum number of workers of a pool.
+        static constexpr size_t MaxWorkerCount = 1024;
+
+        /// @typedef Duration
+        /// @brief The duration type of the elastic pool settings.
+        typedef std::chrono::steady_clock::duration Duration;
+
+        /// @class CScheduleAwaiter
+        /// @brief The awaitable returned by schedule(), it resumes the awaiting coroutine on a worker of the pool.
+        class CScheduleAwaiter {
+        public:
+            /// @brief Constructs the awaitable.
+            /// @param i_pPool The thread pool.
+            /// @param i_ePriority The lane the resumption is queued in.
+            CScheduleAwaiter(CThreadPool *i_pPool, const ETaskPriority i_ePriority)
+                    : m_pPool(i_pPool), m_ePriority(i_ePriority) {
+            }
+
+        public:
+            /// @brief The coroutine always suspends.
+            /// @return False.
+            bool await_ready() const noexcept { return false; }
+
+            /// @brief Adds the resumption of the coroutine as a task, the handle fits into the inline buffer.
+            /// @param i_hCoroutine The suspended coroutine.
+            void await_suspend(std::coroutine_handle<> i_hCoroutine) {
+                this->m_pPool->addTask([i_hCoroutine]() { i_hCoroutine.resume(); }, this->m_ePriority);
+            }
+
+            /// @brief Called on the worker when the coroutine resumes.
+            void await_resume() const noexcept {}
+
+        private:
+            /// @var CThreadPool *m_pPool
+            /// @brief The thread pool.
+            CThreadPool *m_pPool;
+
+            /// @var ETaskPriority m_ePriority
+            /// @brief The lane the resumption is queued in.
+            ETaskPriority m_ePriority;
+        };
+
+    private:
+        /// @class CTimedTask
+        /// @brief A task queued with task timing enabled, allocated from a pool allocator.
+        class CTimedTask {
+        public:
+            /// @var ThreadPoolTaskFn m_fnTask
+            /// @brief The task.
+            ThreadPoolTaskFn m_fnTask;
+
+            /// @var uint64_t m_nEnqueueNs
+            /// @brief The time the task was added, see CWorkerCounters::now().
+            uint64_t m_nEnqueueNs;
+
+            /// @var ETaskPriority m_ePriority
+            /// @brief The lane the task was queued in.
+            ETaskPriority m_ePriority;
+        };
+
+        /// @class CTimedTaskRunner
+        /// @brief The callable queued in place of a timed task, it records the wait and run time of the task.
+        class CTimedTaskRunner {
+        public:
+            /// @brief Takes ownership of a task and stamps the enqueue time.
+            /// @param i_pPool The thread pool the task is added to.
+            /// @param i_fnTask The task.
+            /// @param i_ePriority The lane the task is queued in.
+            CTimedTaskRunner(CThreadPool *i_pPool, ThreadPoolTaskFn &&i_fnTask, ETaskPriority i_ePriority);
+
+            /// @brief Move constructor.
+            /// @param i_oOther The runner to take the task from.
+            CTimedTaskRunner(CTimedTaskRunner &&i_oOther) noexcept
+                    : m_pPool(i_oOther.m_pPool), m_pTask(std::exchange(i_oOther.m_pTask, nullptr)) {
+            }
+
+            /// @brief Destructor, releases a task which was not run.
+            ~CTimedTaskRunner();
+
+            /// @brief Deleted copy constructor.
+            CTimedTaskRunner(const CTimedTaskRunner &) = delete;
+
+        public:
+            /// @brief Runs the task and records its times on the worker running it.
+            void operator()();
+
+        private:
+            /// @var CThreadPool *m_pPool
+            /// @brief The thread pool the task was added to.
+            CThreadPool *m_pPool;
+
+            /// @var CTimedTask *m_pTask
+            /// @brief The task.
+            CTimedTask *m_pTask;
+        };
+
+        /// @class CGuardedTask
+        /// @brief A task queued with a cancellation token, allocated from a pool allocator.
+        class CGuardedTask {
+        public:
+            /// @var ThreadPoolTaskFn m_fnTask
+            /// @brief The task.
+            ThreadPoolTaskFn m_fnTask;
+
+            /// @var CCancellationToken m_oToken
+            /// @brief The token checked before the task runs.
+            CCancellationToken m_oToken;
+
+            /// @var CThreadPool *m_pPool
+            /// @brief The pool the task was added to, it counts the drop.
+            CThreadPool *m_pPool;
+        };
+
+        /// @class CGuardedTaskRunner
+        /// @brief The callable queued in place of a task with a token, it drops the task if the token is cancelled.
+        class CGuardedTaskRunner {
+        public:
+            /// @brief Takes ownership of a task.
+            /// @param i_pPool The pool the task is added to.
+            /// @param i_fnTask The task.
+            /// @param i_oToken The token checked before the task runs.
+            CGuardedTaskRunner(CThreadPool *i_pPool, ThreadPoolTaskFn &&i_fnTask, const CCancellationToken &i_oToken);
+
+            /// @brief Move constructor.
+            /// @param i_oOther The runner to take the task from.
+            CGuardedTaskRunner(CGuardedTaskRunner &&i_oOther) noexcept
+                    : m_pTask(std::exchange(i_oOther.m_pTask, nullptr)) {
+            }
+
+            /// @brief Destructor, releases a task which was not run.
+            ~CGuardedTaskRunner();
+
+            /// @brief Deleted copy constructor.
+            CGuardedTaskRunner(const CGuardedTaskRunner &) = delete;
+
+        public:
+            /// @brief Runs the task unless its token is cancelled.
+            void operator()();
+
+        private:
+            /// @var CGuardedTask *m_pTask
+            /// @brief The task.
+            CGuardedTask *m_pTask;
+        };
+
+        /// @class CPriorityLane
+        /// @brief The shared queue of the high or the background lane.
+        /// The task count lets workers skip an empty lane without taking the queue lock.
+        class alignas(64) CPriorityLane {
+        public:
+            /// @brief Enqueues a task.
+            /// @param i_oTask The task.
+            void enqueue(ThreadPoolTaskFn &&i_oTask) {
+                this->m_aoTasks.enqueue(std::move(i_oTask));
+                this->m_nSize.fetch_add(1, std::memory_order_release);
+            }
+
+            /// @brief Dequeues a task.
+            /// @param i_fnOutTask Receives the task on success.
+            /// @return True if a task was dequeued, false if the lane is empty.
+            bool tryDequeue(ThreadPoolTaskFn &i_fnOutTask) {
+                if (this->m_nSize.load(std::memory_order_acquire) == 0 || !this->m_aoTasks.tryDequeue(i_fnOutTask)) {
+                    return false;
+                }
+
+                this->m_nSize.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            /// @brief Drops all queued tasks.
+            void clear() {
+                this->m_aoTasks.clear();
+                this->m_nSize.store(0, std::memory_order_relaxed);
+            }
+
+        public:
+            /// @brief Returns the number of queued tasks.
+            /// @return The number of tasks.
+            size_t size() const { return this->m_nSize.load(std::memory_order_acquire); }
+
+            /// @brief Checks if the lane is empty.
+            /// @return True if no task is queued.
+            bool isEmpty() const { return this->size() == 0; }
+
+        private:
+            /// @var CSafeQueue<ThreadPoolTaskFn, CFutexMutex> m_aoTasks
+            /// @brief The queued tasks.
+            CSafeQueue<ThreadPoolTaskFn, CFutexMutex> m_aoTasks;
+
+            /// @var std::atomic<size_t> m_nSize
+            /// @brief The number of queued tasks, raised after the enqueue and lowered after the dequeue.
+            std::atomic<size_t> m_nSize = 0;
+        };
+
     public:
         /// @brief Default constructor for CThreadPool.
         CThreadPool()
-                : m_nWorkerCount(3), m_fIsExecuted(false) {
+                : m_nWorkerCount(3), m_nMinWorkers(0), m_nMaxWorkers(0),
+                  m_oGrowLatency(std::chrono::milliseconds(10)), m_oIdleTimeout(std::chrono::seconds(30)),
+                  m_apWorker(new std::atomic<CThreadPoolWorker *>[MaxWorkerCount]()), m_nSlotCount(0),
+                  m_nActiveWorkers(0), m_nIdleWorkers(0), m_nLastProgress(0), m_nQueueWaitNs(0),
+                  m_nSpinCount(0),
+                  m_eMode(ESharedQueue), m_eQueueType(EUnboundedQueue),
+                  m_eAffinity(EFloating), m_stThreadName("worker"), m_eLanePolicy(EStrictPriority),
+                  m_anLaneWeights{8, 4, 1}, m_nReservedWorkers(0), m_nOutstandingTasks(0), m_nIdleWaiters(0),
+                  m_fHasTaskTiming(false),
+                  m_fIsExecuted(false) {
         }
 
         /// @brief Constructor that sets the worker count for the thread pool.
@@ -35,9 +327,22 @@ namespace Devel::Threading {
             this->setWorkerCount(i_nWorkerCount);
         }
 
+        /// @brief Constructor that sets the worker count and the scheduling mode for the thread pool.
+        /// @param i_nWorkerCount The number of worker threads in the thread pool.
+        /// @param i_eMode The scheduling mode of the thread pool.
+        CThreadPool(const size_t i_nWorkerCount, const EMode i_eMode)
+                : CThreadPool(i_nWorkerCount) {
+            this->setMode(i_eMode);
+        }
+
         // @brief Destructor for CThreadPool.
         ~CThreadPool() {
             this->stop();
+
+            const size_t nSlotCount = this->m_nSlotCount;
+            for (size_t i = 0; i < nSlotCount; i++) {
+                delete this->worker(i);
+            }
         }
 
 
@@ -60,57 +365,675 @@ namespace Devel::Threading {
         /// @param i_nWorkerCount The number of worker threads to use in the thread pool.
         /// @return The execution result.
         EError execute(const size_t i_nWorkerCount) {
+            if (this->m_fIsExecuted) {
+                return CThreadPool::EError::EAlreadyExecuted;
+            }
+
             this->setWorkerCount(i_nWorkerCount);
             return this->execute();
         }
 
         /// @brief Stops the execution of the thread pool.
+        /// Workers finish their current task and exit, queued tasks are not run.
         /// @param i_fClearTasks Flag indicating whether to clear the task queue.
         void stop(bool i_fClearTasks = true);
 
+        /// @brief Blocks until every added task has finished, including the tasks those tasks add.
+        /// Returns immediately if the pool is not executed, and when it is stopped while waiting.
+        /// Must not be called from a task of this pool, the calling task itself never finishes.
+        void waitIdle();
+
+        /// @brief Runs every queued task to completion, then stops the thread pool.
+        /// Tasks added by other threads while the pool drains are run as well. Tasks added after the pool
+        /// became idle are kept for the next execute().
+        void drainAndStop() {
+            this->waitIdle();
+            this->stop(false);
+        }
+
+        /// @brief Changes the number of workers, also while the pool is executed.
+        /// New workers start immediately. Surplus workers retire after their current task and move the tasks
+        /// of their local deque to the shared queue, so no queued task is dropped.
+        /// @param i_nWorkerCount The number of worker threads, clamped to [1, MaxWorkerCount],
+        /// or to the worker limits of an elastic pool.
+        void resize(size_t i_nWorkerCount);
+
     private:
         /// @brief Worker function that handles executing tasks from the task queue.
-        void handleWorker();
+        /// @param i_pWorker The state of the worker.
+        void handleWorker(CThreadPoolWorker *i_pWorker);
+
+        /// @brief Runs a task and counts it as executed or failed on the worker.
+        /// An exception must not take down the worker, it is swallowed, submit() is used to observe it.
+        /// @param i_pWorker The worker running the task, nullptr for a foreign thread which has no counters.
+        /// @param i_fnTask The task.
+        static void runTask(CThreadPoolWorker *i_pWorker, ThreadPoolTaskFn &i_fnTask);
+
+        /// @brief Fetches the next task for a worker from the lanes in the order of the lane policy.
+        /// Reserved workers only fetch from the high lane.
+        /// @param i_pWorker The state of the worker.
+        /// @param i_fnOutTask Receives the task on success.
+        /// @return True if a task was fetched, false otherwise.
+        bool fetchTask(CThreadPoolWorker *i_pWorker, ThreadPoolTaskFn &i_fnOutTask);
+
+        /// @brief Fetches a task of one lane for a worker.
+        /// @param i_pWorker The state of the worker.
+        /// @param i_ePriority The lane.
+        /// @param i_fnOutTask Receives the task on success.
+        /// @return True if a task was fetched, false if the lane is empty.
+        bool fetchLaneTask(CThreadPoolWorker *i_pWorker, ETaskPriority i_ePriority, ThreadPoolTaskFn &i_fnOutTask);
+
+        /// @brief Fetches a task of the normal lane for a worker.
+        /// The local deque is checked first, then the shared queue, and finally random victims are stolen from.
+        /// @param i_pWorker The state of the worker.
+        /// @param i_fnOutTask Receives the task on success.
+        /// @return True if a task was fetched, false otherwise.
+        bool fetchNormalTask(CThreadPoolWorker *i_pWorker, ThreadPoolTaskFn &i_fnOutTask);
+
+        /// @brief Enqueues a task into the shared queue.
+        /// @param i_oTask The task.
+        /// @param i_fMayBlock Whether the call may block on a full bounded queue, it only does while the pool runs.
+        /// @return True if the task was enqueued, false if the bounded queue is full and the call must not block.
+        bool enqueueShared(ThreadPoolTaskFn &&i_oTask, bool i_fMayBlock);
+
+        /// @brief Dequeues a task from the shared queue.
+        /// @param i_fnOutTask Receives the task on success.
+        /// @return True if a task was dequeued, false if the shared queue is empty.
+        /// @param i_nNode The NUMA node whose queue is preferred if node-local queues are used.
+        bool dequeueShared(ThreadPoolTaskFn &i_fnOutTask, size_t i_nNode);
+
+        /// @brief Checks if the shared queue is empty.
+        /// @return True if no task is waiting in the shared queue or in the high and background lanes.
+        bool isSharedEmpty() const;
+
+        /// @brief Checks if any task is waiting in the shared queue or in a local deque.
+        /// @return True if a task is pending, false otherwise.
+        bool hasPendingTask() const;
+
+        /// @brief Checks if a task is waiting which a worker may run.
+        /// @param i_pWorker The worker.
+        /// @return True if a task is pending, reserved workers only look at the high lane.
+        bool hasPendingTask(const CThreadPoolWorker *i_pWorker) const;
+
+        /// @brief Checks if a worker is reserved for the high lane.
+        /// At least one worker of the pool is never reserved.
+        /// @param i_pWorker The worker.
+        /// @return True if the worker only runs tasks of the high lane.
+        bool isReserved(const CThreadPoolWorker *i_pWorker) const {
+            return i_pWorker->m_nIndex < std::min(this->m_nReservedWorkers,
+                                                  this->m_nWorkerCount.load(std::memory_order_relaxed) - 1);
+        }
+
+        /// @brief Returns the shared queue of the high or the background lane.
+        /// @param i_ePriority The lane, not ENormalPriority.
+        /// @return The lane.
+        CPriorityLane &lane(const ETaskPriority i_ePriority) {
+            return i_ePriority == EHighPriority ? this->m_oHighLane : this->m_oBackgroundLane;
+        }
+
+        /// @brief Returns the number of tasks waiting in the shared queues and in the local deques.
+        /// @return The number of queued tasks.
+        size_t queuedTaskCount() const;
+
+        /// @brief Returns the worker state of the calling thread if it is a worker of this pool.
+        /// @return The worker state, or nullptr if called from a foreign thread.
+        CThreadPoolWorker *localWorker() const;
+
+        /// @brief Blocks the calling worker until a task is available or the pool is stopped.
+        /// The worker spins for the configured spin count before it parks on the condition variable.
+        /// @param i_pWorker The calling worker.
+        void waitForTask(CThreadPoolWorker *i_pWorker);
+
+        /// @brief Wakes up one parked worker which may run a task of a lane.
+        /// A task of the high lane wakes a reserved worker as well as another worker.
+        /// @param i_ePriority The lane of the added task.
+        void notifyWorker(ETaskPriority i_ePriority = ENormalPriority);
+
+        /// @brief Checks the token of a task a worker is about to run, and counts the drop if it is cancelled.
+        /// Only a worker of this pool counts the drop, a task of this pool run inline by another thread does not
+        /// touch the worker state of that thread.
+        /// @param i_oToken The token of the task.
+        /// @return True if the task must be dropped.
+        bool dropCancelled(const CCancellationToken &i_oToken) const;
+
+        /// @brief Marks a task as finished and wakes the threads in waitIdle() when it was the last one.
+        void finishTask();
+
+        /// @brief Wakes the threads in waitIdle().
+        void notifyIdle();
+
+        /// @brief Decides the CPUs and the NUMA node of a worker from the affinity settings.
+        /// @param i_pWorker The worker, placed by its index.
+        void placeWorker(CThreadPoolWorker *i_pWorker) const;
+
+        /// @brief Starts workers until the number of running workers reaches the worker count.
+        /// Slots of retired workers are reused.
+        void spawnWorkers();
+
+        /// @brief Checks if the pool has more running workers than the worker count.
+        /// @return True if a worker should retire.
+        bool hasSurplusWorker() const {
+            return this->m_nActiveWorkers.load(std::memory_order_relaxed) >
+                   this->m_nWorkerCount.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Lets the calling worker claim the retirement of a surplus worker.
+        /// @return True if the calling worker must retire.
+        bool tryRetire();
+
+        /// @brief Shrinks the worker count of an elastic pool by one, not below the minimum.
+        /// @return True if the worker count was decreased.
+        bool tryShrink();
+
+        /// @brief The monitor thread of an elastic pool, it adds workers when the queue latency grows.
+        void handleMonitor();
+
+        /// @brief Raises the longest queue wait the monitor of an elastic pool checks next.
+        /// @param i_nWaitNs The queue wait of a task which was just picked up in nanoseconds.
+        void recordQueueWait(const uint64_t i_nWaitNs) {
+            uint64_t nWaitNs = this->m_nQueueWaitNs.load(std::memory_order_relaxed);
+            while (nWaitNs < i_nWaitNs &&
+                   !this->m_nQueueWaitNs.compare_exchange_weak(nWaitNs, i_nWaitNs, std::memory_order_relaxed)) {
+            }
+        }
+
+        /// @brief Returns the worker in a slot.
+        /// @param i_nSlot The slot index, must be less than the slot count.
+        /// @return The worker.
+        CThreadPoolWorker *worker(const size_t i_nSlot) const {
+            return this->m_apWorker[i_nSlot].load(std::memory_order_acquire);
+        }
+
+        /// @brief Returns the current time used for the latency measurement.
+        /// @return The time in ticks of std::chrono::steady_clock.
+        static int64_t now() {
+            return std::chrono::steady_clock::now().time_since_epoch().count();
+        }
 
     public:
+        /// @brief Adds a callable to the task queue.
+        /// The callable is stored inline in a ThreadPoolTaskFn, captures exceeding its buffer fail to compile.
+        /// @param i_fnTask The callable to be added.
+        /// @param i_ePriority The lane the task is queued in.
+        template<typename F, typename std::enable_if_t<!std::is_same_v<std::decay_t<F>, ThreadPoolTaskFn>> * = nullptr>
+        inline void addTask(F &&i_fnTask, const ETaskPriority i_ePriority = ENormalPriority) {
+            return this->addTask(ThreadPoolTaskFn(std::forward<F>(i_fnTask)), i_ePriority);
+        }
+
         /// @brief Adds a task to the task queue.
+        /// In EWorkStealing mode a normal task added from a worker of this pool is pushed to the local deque of
+        /// that worker. Tasks of the high and background lanes always go through the shared queue of their lane.
         /// @param i_oTask The task to be added.
-        inline void addTask(const ThreadPoolTaskFn &i_oTask) { this->m_aoTasks.enqueue(i_oTask); }
+        /// @param i_ePriority The lane the task is queued in.
+        void addTask(ThreadPoolTaskFn &&i_oTask, ETaskPriority i_ePriority = ENormalPriority);
 
-        /// @brief Adds a task to the task queue.
+        /// @brief Adds a callable which is dropped instead of run if its token is cancelled when a worker picks it up.
+        /// @param i_fnTask The callable to be added.
+        /// @param i_oToken The cancellation token, it may carry a deadline.
+        /// @param i_ePriority The lane the task is queued in.
+        template<typename F, typename std::enable_if_t<!std::is_same_v<std::decay_t<F>, ThreadPoolTaskFn>> * = nullptr>
+        inline void addTask(F &&i_fnTask, const CCancellationToken &i_oToken,
+                            const ETaskPriority i_ePriority = ENormalPriority) {
+            return this->addTask(ThreadPoolTaskFn(std::forward<F>(i_fnTask)), i_oToken, i_ePriority);
+        }
+
+        /// @brief Adds a task which is dropped instead of run if its token is cancelled when a worker picks it up.
+        /// The task and the token are moved to a pool allocated block, a token which can not be cancelled costs nothing.
         /// @param i_oTask The task to be added.
-        inline void addTask(ThreadPoolTaskFn &&i_oTask) { this->m_aoTasks.enqueue(std::move(i_oTask)); }
+        /// @param i_oToken The cancellation token, it may carry a deadline.
+        /// @param i_ePriority The lane the task is queued in.
+        void addTask(ThreadPoolTaskFn &&i_oTask, const CCancellationToken &i_oToken,
+                     ETaskPriority i_ePriority = ENormalPriority);
+
+        /// @brief Returns an awaitable which moves the awaiting coroutine onto a worker of the pool.
+        /// @code{.cpp}
+        ///     co_await pool.schedule();   // continues on a worker
+        /// @endcode
+        /// @param i_ePriority The lane the resumption is queued in.
+        /// @return The awaitable.
+        CScheduleAwaiter schedule(const ETaskPriority i_ePriority = ENormalPriority) {
+            return CScheduleAwaiter(this, i_ePriority);
+        }
+
+        /// @brief Adds a task to the task queue and returns a future for its result.
+        ///
+        /// The arguments are decay-copied into the task, which must fit into the inline buffer of ThreadPoolTaskFn.
+        /// The shared state of the future is taken from a pool allocator.
+        /// An exception thrown by the task is stored in the future and rethrown by CTaskFuture::get().
+        ///
+        /// @param i_fnTask The callable to execute.
+        /// @param i_aArgs The arguments passed to the callable.
+        /// @return A future for the result of the callable.
+        template<typename F, typename std::enable_if_t<!std::is_same_v<std::decay_t<F>, CCancellationToken>> * = nullptr,
+                typename... Args>
+        auto submit(F &&i_fnTask, Args &&... i_aArgs) {
+            return this->submit(ENormalPriority, std::forward<F>(i_fnTask), std::forward<Args>(i_aArgs)...);
+        }
+
+        /// @brief Adds a task to a priority lane and returns a future for its result, see submit().
+        /// @param i_ePriority The lane the task is queued in.
+        /// @param i_fnTask The callable to execute.
+        /// @param i_aArgs The arguments passed to the callable.
+        /// @return A future for the result of the callable.
+        template<typename F, typename... Args>
+        auto submit(const ETaskPriority i_ePriority, F &&i_fnTask, Args &&... i_aArgs) {
+            typedef std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...> TResult;
+
+            auto *pState = new CTaskState<TResult>();
+            CTaskPromise<TResult> oPromise(pState);
+
+            this->addTask([oPromise, fnTask = std::decay_t<F>(std::forward<F>(i_fnTask)),
+                                  ... aArgs = std::decay_t<Args>(std::forward<Args>(i_aArgs))]() mutable {
+                oPromise.run([&]() { return std::invoke(std::move(fnTask), std::move(aArgs)...); });
+            }, i_ePriority);
+
+            return CTaskFuture<TResult>(pState);
+        }
+
+        /// @brief Adds a task with a cancellation token and returns a future for its result, see submit().
+        /// If the token is cancelled when a worker picks up the task, the task is dropped and the future receives
+        /// TaskCancelledException. The token takes 16 bytes of the inline buffer of ThreadPoolTaskFn.
+        /// @param i_oToken The cancellation token, it may carry a deadline.
+        /// @param i_fnTask The callable to execute.
+        /// @param i_aArgs The arguments passed to the callable.
+        /// @return A future for the result of the callable.
+        template<typename F, typename... Args>
+        auto submit(const CCancellationToken &i_oToken, F &&i_fnTask, Args &&... i_aArgs) {
+            return this->submit(i_oToken, ENormalPriority, std::forward<F>(i_fnTask), std::forward<Args>(i_aArgs)...);
+        }
+
+        /// @brief Adds a task with a cancellation token to a priority lane and returns a future for its result.
+        /// @param i_oToken The cancellation token, it may carry a deadline.
+        /// @param i_ePriority The lane the task is queued in.
+        /// @param i_fnTask The callable to execute.
+        /// @param i_aArgs The arguments passed to the callable.
+        /// @return A future for the result of the callable.
+        template<typename F, typename... Args>
+        auto submit(const CCancellationToken &i_oToken, const ETaskPriority i_ePriority, F &&i_fnTask,
+                    Args &&... i_aArgs) {
+            typedef std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...> TResult;
+
+            auto *pState = new CTaskState<TResult>();
+            CTaskPromise<TResult> oPromise(pState);
+
+            // The token is checked inside the task, the promise has to learn about the drop
+            this->addTask([this, oPromise, oToken = i_oToken, fnTask = std::decay_t<F>(std::forward<F>(i_fnTask)),
+                                  ... aArgs = std::decay_t<Args>(std::forward<Args>(i_aArgs))]() mutable {
+                if (this->dropCancelled(oToken)) {
+                    oPromise.setException(std::make_exception_ptr(TaskCancelledException));
+                    return;
+                }
+                oPromise.run([&]() { return std::invoke(std::move(fnTask), std::move(aArgs)...); });
+            }, i_ePriority);
+
+            return CTaskFuture<TResult>(pState);
+        }
 
         /// @brief Sets the worker count for the thread pool.
+        /// On an executed pool this is the same as resize().
         /// @param i_nWorkerCount The number of worker threads to use in the thread pool.
         inline void setWorkerCount(const size_t i_nWorkerCount) {
-            this->m_nWorkerCount = (i_nWorkerCount == 0 ? 1 : i_nWorkerCount);
+            if (this->m_fIsExecuted) {
+                return this->resize(i_nWorkerCount);
+            }
+
+            this->m_nWorkerCount = std::clamp<size_t>(i_nWorkerCount, 1, MaxWorkerCount);
+        }
+
+        /// @brief Makes the thread pool elastic, the number of workers follows the load between the limits.
+        /// The limits can only be changed while the thread pool is not executed, execute() starts with the
+        /// worker count clamped to the limits.
+        /// @param i_nMinWorkers The minimum number of workers, idle workers retire down to it.
+        /// @param i_nMaxWorkers The maximum number of workers, the monitor adds workers up to it.
+        inline void setWorkerLimits(const size_t i_nMinWorkers, const size_t i_nMaxWorkers) {
+            if (!this->m_fIsExecuted) {
+                this->m_nMinWorkers = std::clamp<size_t>(i_nMinWorkers, 1, MaxWorkerCount);
+                this->m_nMaxWorkers = std::clamp<size_t>(i_nMaxWorkers, this->m_nMinWorkers, MaxWorkerCount);
+            }
+        }
+
+        /// @brief Sets the queue latency after which an elastic pool adds a worker.
+        /// A worker is added if tasks are waiting, no worker is idle, and a task picked up since the last check
+        /// waited in the queue for this duration, or no task was picked up for this duration.
+        /// The latency can only be changed while the thread pool is not executed.
+        /// @param i_oLatency The latency threshold.
+        inline void setGrowLatency(const Duration i_oLatency) {
+            if (!this->m_fIsExecuted) {
+                this->m_oGrowLatency = i_oLatency;
+            }
+        }
+
+        /// @brief Sets the time after which an idle worker of an elastic pool retires.
+        /// The timeout can only be changed while the thread pool is not executed.
+        /// @param i_oTimeout The idle timeout.
+        inline void setIdleTimeout(const Duration i_oTimeout) {
+            if (!this->m_fIsExecuted) {
+                this->m_oIdleTimeout = i_oTimeout;
+            }
+        }
+
+        /// @brief Sets the number of spin iterations an idle worker polls the queue before it parks.
+        /// A value of 0 parks idle workers immediately. Higher values lower the wakeup latency
+        /// at the cost of CPU time burned by idle workers.
+        /// @param i_nSpinCount The number of spin iterations.
+        inline void setSpinCount(const size_t i_nSpinCount) {
+            this->m_nSpinCount = i_nSpinCount;
         }
 
+        /// @brief Sets the scheduling mode of the thread pool.
+        /// The mode can only be changed while the thread pool is not executed.
+        /// @param i_eMode The scheduling mode.
+        inline void setMode(const EMode i_eMode) {
+            if (!this->m_fIsExecuted) {
+                this->m_eMode = i_eMode;
+            }
+        }
+
+        /// @brief Sets the type of the shared task queue.
+        /// The type can only be changed while the thread pool is not executed, pending tasks are moved to the new queue.
+        /// @param i_eQueueType The queue type.
+        void setQueueType(EQueueType i_eQueueType);
+
+        /// @brief Sets the CPU placement of the workers.
+        /// The placement can only be changed while the thread pool is not executed.
+        /// @param i_eAffinity The placement.
+        /// @param i_anCpus The CPUs the workers may use, all CPUs of the machine if empty.
+        inline void setAffinity(const EAffinity i_eAffinity, std::vector<size_t> i_anCpus = {}) {
+            if (!this->m_fIsExecuted) {
+                this->m_eAffinity = i_eAffinity;
+                this->m_anCpus = std::move(i_anCpus);
+            }
+        }
+
+        /// @brief Splits the unbounded shared queue into one queue per NUMA node.
+        /// The setting can only be changed while the thread pool is not executed, pending tasks are kept.
+        /// It has no effect on tasks added while the queue type is EBoundedQueue.
+        /// @param i_fUseNodeQueues True to use node-local queues.
+        void setNodeLocalQueues(bool i_fUseNodeQueues);
+
+        /// @brief Sets the name prefix of the worker threads, an empty name keeps the name of the process.
+        /// The name can only be changed while the thread pool is not executed.
+        /// @param i_stName The name prefix, the worker index is appended.
+        inline void setThreadName(std::string i_stName) {
+            if (!this->m_fIsExecuted) {
+                this->m_stThreadName = std::move(i_stName);
+            }
+        }
+
+        /// @brief Sets how workers choose between the priority lanes.
+        /// The policy can only be changed while the thread pool is not executed.
+        /// @param i_ePolicy The lane policy.
+        inline void setLanePolicy(const ELanePolicy i_ePolicy) {
+            if (!this->m_fIsExecuted) {
+                this->m_eLanePolicy = i_ePolicy;
+            }
+        }
+
+        /// @brief Sets the share of the tasks every lane gets in EWeightedFair mode while all lanes are busy.
+        /// A lane with weight 0 is only served while the other lanes are empty.
+        /// The weights can only be changed while the thread pool is not executed.
+        /// @param i_nHigh The weight of the high lane.
+        /// @param i_nNormal The weight of the normal lane.
+        /// @param i_nBackground The weight of the background lane.
+        inline void setLaneWeights(const size_t i_nHigh, const size_t i_nNormal, const size_t i_nBackground) {
+            if (!this->m_fIsExecuted) {
+                this->m_anLaneWeights = {static_cast<int64_t>(i_nHigh), static_cast<int64_t>(i_nNormal),
+                                         static_cast<int64_t>(i_nBackground)};
+            }
+        }
+
+        /// @brief Reserves workers for the high lane, they never run tasks of the other lanes.
+        /// At least one worker always serves all lanes, so at most workerCount() - 1 workers are reserved.
+        /// The reservation can only be changed while the thread pool is not executed.
+        /// @param i_nReservedWorkers The number of reserved workers.
+        inline void setReservedWorkers(const size_t i_nReservedWorkers) {
+            if (!this->m_fIsExecuted) {
+                this->m_nReservedWorkers = i_nReservedWorkers;
+            }
+        }
+
+        /// @brief Returns the number of tasks which were added and have not finished yet.
+        /// @return The number of queued and running tasks.
+        size_t outstandingTaskCount() const { return this->m_nOutstandingTasks.load(std::memory_order_relaxed); }
+
+        /// @brief Records the queue wait and run time of every task added from now on.
+        /// Timing costs two clock reads and a pool allocation per task, it can be switched at any time.
+        /// @param i_fHasTaskTiming True to record the task times.
+        inline void setTaskTiming(const bool i_fHasTaskTiming) {
+            this->m_fHasTaskTiming.store(i_fHasTaskTiming, std::memory_order_relaxed);
+        }
+
+    public:
+        /// @brief Returns the worker running the calling thread, to reach its worker-local storage.
+        /// @return The worker of any CThreadPool, nullptr if the calling thread is not a pool worker.
+        static CThreadPoolWorker *currentWorker();
+
+        /// @brief Collects a snapshot of the counters of all workers and the depth of the queues.
+        /// The workers are not stopped or synchronized, the counters of a snapshot are each up to date but not
+        /// taken at the same instant.
+        /// @return The snapshot.
+        CThreadPoolMetrics metrics() const;
+
     public:
         /// @brief Returns the current worker count of the thread pool.
         /// @return The worker count.
         size_t workerCount() const { return this->m_nWorkerCount; }
 
+        /// @brief Returns the number of currently running worker threads.
+        /// It differs from workerCount() while workers start or retire.
+        /// @return The number of running workers.
+        size_t activeWorkerCount() const { return this->m_nActiveWorkers; }
+
+        /// @brief Checks if the thread pool is elastic, see setWorkerLimits().
+        /// @return True if the worker count follows the load.
+        bool isElastic() const { return this->m_nMaxWorkers != 0; }
+
+        /// @brief Returns the minimum number of workers of an elastic pool.
+        /// @return The minimum, 0 if the pool is not elastic.
+        size_t minWorkers() const { return this->m_nMinWorkers; }
+
+        /// @brief Returns the maximum number of workers of an elastic pool.
+        /// @return The maximum, 0 if the pool is not elastic.
+        size_t maxWorkers() const { return this->m_nMaxWorkers; }
+
+        /// @brief Returns the queue latency after which an elastic pool adds a worker.
+        /// @return The latency threshold.
+        Duration growLatency() const { return this->m_oGrowLatency; }
+
+        /// @brief Returns the time after which an idle worker of an elastic pool retires.
+        /// @return The idle timeout.
+        Duration idleTimeout() const { return this->m_oIdleTimeout; }
+
+        /// @brief Returns the number of spin iterations before an idle worker parks.
+        /// @return The spin count.
+        size_t spinCount() const { return this->m_nSpinCount; }
+
+        /// @brief Returns the scheduling mode of the thread pool.
+        /// @return The scheduling mode.
+        EMode mode() const { return this->m_eMode; }
+
+        /// @brief Returns the type of the shared task queue.
+        /// @return The queue type.
+        EQueueType queueType() const { return this->m_eQueueType; }
+
+        /// @brief Returns the CPU placement of the workers.
+        /// @return The placement.
+        EAffinity affinity() const { return this->m_eAffinity; }
+
+        /// @brief Checks if the shared queue is split into one queue per NUMA node.
+        /// @return True if node-local queues are used.
+        bool hasNodeLocalQueues() const { return !this->m_apNodeTasks.empty(); }
+
+        /// @brief Returns the name prefix of the worker threads.
+        /// @return The name prefix.
+        const std::string &threadName() const { return this->m_stThreadName; }
+
+        /// @brief Returns how workers choose between the priority lanes.
+        /// @return The lane policy.
+        ELanePolicy lanePolicy() const { return this->m_eLanePolicy; }
+
+        /// @brief Returns the number of workers reserved for the high lane.
+        /// @return The number of reserved workers as configured.
+        size_t reservedWorkers() const { return this->m_nReservedWorkers; }
+
+        /// @brief Checks if the wait and run time of added tasks is recorded.
+        /// @return True if task timing is enabled.
+        bool hasTaskTiming() const { return this->m_fHasTaskTiming.load(std::memory_order_relaxed); }
+
         /// @brief Checks if the thread pool has been executed.
         /// @return True if the thread pool has been executed, false otherwise.
         bool isExecuted() const { return this->m_fIsExecuted; }
 
     private:
-        /// @var size_t m_nWorkerCount
-        /// @brief The number of worker threads in the thread pool.
-        size_t m_nWorkerCount;
+        /// @var std::atomic<size_t> m_nWorkerCount
+        /// @brief The number of worker threads in the thread pool, running workers converge to it.
+        std::atomic<size_t> m_nWorkerCount;
+
+        /// @var size_t m_nMinWorkers
+        /// @brief The minimum number of workers of an elastic pool, 0 if the pool is not elastic.
+        size_t m_nMinWorkers;
+
+        /// @var size_t m_nMaxWorkers
+        /// @brief The maximum number of workers of an elastic pool, 0 if the pool is not elastic.
+        size_t m_nMaxWorkers;
+
+        /// @var Duration m_oGrowLatency
+        /// @brief The queue latency after which an elastic pool adds a worker.
+        Duration m_oGrowLatency;
+
+        /// @var Duration m_oIdleTimeout
+        /// @brief The time after which an idle worker of an elastic pool retires.
+        Duration m_oIdleTimeout;
+
+        /// @var std::unique_ptr<std::atomic<CThreadPoolWorker *>[]> m_apWorker
+        /// @brief The worker slots. Slots are only appended while the pool is executed and only deleted by the
+        /// destructor, so workers and metrics() iterate them without a lock. Retired and stopped workers keep
+        /// their slot for reuse.
+        std::unique_ptr<std::atomic<CThreadPoolWorker *>[]> m_apWorker;
+
+        /// @var std::atomic<size_t> m_nSlotCount
+        /// @brief The number of used worker slots.
+        std::atomic<size_t> m_nSlotCount;
+
+        /// @var std::atomic<size_t> m_nActiveWorkers
+        /// @brief The number of running workers.
+        std::atomic<size_t> m_nActiveWorkers;
+
+        /// @var std::atomic<size_t> m_nIdleWorkers
+        /// @brief The number of workers waiting for a task.
+        std::atomic<size_t> m_nIdleWorkers;
+
+        /// @var std::atomic<int64_t> m_nLastProgress
+        /// @brief The time a worker of an elastic pool last picked up a task.
+        std::atomic<int64_t> m_nLastProgress;
+
+        /// @var std::atomic<uint64_t> m_nQueueWaitNs
+        /// @brief The longest queue wait of the tasks an elastic pool picked up since the last check of the monitor.
+        std::atomic<uint64_t> m_nQueueWaitNs;
+
+        /// @var std::mutex m_oResizeMutex
+        /// @brief Serializes starting, joining and deleting of worker threads.
+        mutable std::mutex m_oResizeMutex;
+
+        /// @var std::thread m_oMonitorThread
+        /// @brief The monitor thread of an elastic pool.
+        std::thread m_oMonitorThread;
+
+        /// @var std::condition_variable m_oMonitorCondition
+        /// @brief Wakes up the monitor thread when the pool is stopped, used with m_oWakeMutex.
+        std::condition_variable m_oMonitorCondition;
+
+        /// @var CSafeQueue<ThreadPoolTaskFn, CFutexMutex> m_aoTasks
+        /// @brief The task queue for the thread pool. In EWorkStealing mode this is the shared injection queue.
+        /// In EBoundedQueue mode it only holds the tasks which did not fit into the bounded queue on stop().
+        CSafeQueue<ThreadPoolTaskFn, CFutexMutex> m_aoTasks;
+
+        /// @var std::unique_ptr<CBoundedQueue<ThreadPoolTaskFn, BoundedQueueCapacity>> m_pBoundedTasks
+        /// @brief The lock-free shared task queue in EBoundedQueue mode.
+        std::unique_ptr<CBoundedQueue<ThreadPoolTaskFn, BoundedQueueCapacity>> m_pBoundedTasks;
+
+        /// @var size_t m_nSpinCount
+        /// @brief The number of spin iterations an idle worker polls the queue before it parks.
+        size_t m_nSpinCount;
+
+        /// @var EMode m_eMode
+        /// @brief The scheduling mode of the thread pool.
+        EMode m_eMode;
+
+        /// @var EQueueType m_eQueueType
+        /// @brief The type of the shared task queue.
+        EQueueType m_eQueueType;
+
+        /// @var EAffinity m_eAffinity
+        /// @brief The CPU placement of the workers.
+        EAffinity m_eAffinity;
+
+        /// @var std::vector<size_t> m_anCpus
+        /// @brief The CPUs the workers may use, all CPUs if empty.
+        std::vector<size_t> m_anCpus;
+
+        /// @var std::string m_stThreadName
+        /// @brief The name prefix of the worker threads.
+        std::string m_stThreadName;
+
+        /// @var std::vector<std::unique_ptr<CSafeQueue<ThreadPoolTaskFn, CFutexMutex>>> m_apNodeTasks
+        /// @brief The node-local task queues indexed by NUMA node, empty if they are not used.
+        std::vector<std::unique_ptr<CSafeQueue<ThreadPoolTaskFn, CFutexMutex>>> m_apNodeTasks;
+
+        /// @var CPriorityLane m_oHighLane
+        /// @brief The shared queue of the high lane.
+        CPriorityLane m_oHighLane;
+
+        /// @var CPriorityLane m_oBackgroundLane
+        /// @brief The shared queue of the background lane.
+        CPriorityLane m_oBackgroundLane;
+
+        /// @var ELanePolicy m_eLanePolicy
+        /// @brief How workers choose between the priority lanes.
+        ELanePolicy m_eLanePolicy;
+
+        /// @var std::array<int64_t, TaskPriorityCount> m_anLaneWeights
+        /// @brief The weights of the priority lanes in EWeightedFair mode.
+        std::array<int64_t, TaskPriorityCount> m_anLaneWeights;
+
+        /// @var size_t m_nReservedWorkers
+        /// @brief The number of workers reserved for the high lane.
+        size_t m_nReservedWorkers;
+
+        /// @var std::mutex m_oWakeMutex
+        /// @brief The mutex protecting the parking of idle workers.
+        std::mutex m_oWakeMutex;
+
+        /// @var std::condition_variable m_oWakeCondition
+        /// @brief The condition variable idle workers are parked on.
+        std::condition_variable m_oWakeCondition;
+
+        /// @var std::condition_variable m_oReservedCondition
+        /// @brief The condition variable idle reserved workers are parked on, used with m_oWakeMutex.
+        std::condition_variable m_oReservedCondition;
+
+        /// @var std::atomic<size_t> m_nOutstandingTasks
+        /// @brief The number of added tasks which have not finished yet, on its own cache line.
+        alignas(64) std::atomic<size_t> m_nOutstandingTasks;
+
+        /// @var std::atomic<size_t> m_nIdleWaiters
+        /// @brief The number of threads blocked in waitIdle().
+        std::atomic<size_t> m_nIdleWaiters;
+
+        /// @var std::mutex m_oIdleMutex
+        /// @brief The mutex protecting the idle condition.
+        std::mutex m_oIdleMutex;
 
-        /// @var std::vector<std::thread> m_aoWorker
-        /// @brief The vector of worker threads in the thread pool.
-        std::vector<std::thread> m_aoWorker;
+        /// @var std::condition_variable m_oIdleCondition
+        /// @brief Signalled when the last outstanding task has finished or the pool is stopped.
+        std::condition_variable m_oIdleCondition;
 
-        /// @var CSafeQueue<ThreadPoolTaskFn> m_aoTasks
-        /// @brief The task queue for the thread pool.
-        CSafeQueue<ThreadPoolTaskFn> m_aoTasks;
+        /// @var std::atomic<bool> m_fHasTaskTiming
+        /// @brief Whether the wait and run time of added tasks is recorded.
+        std::atomic<bool> m_fHasTaskTiming;
 
-        /// @var bool m_fIsExecuted
+        /// @var std::atomic<bool> m_fIsExecuted
         /// @brief Flag indicating whether the thread pool has been executed.
-        bool m_fIsExecuted;
+        std::atomic<bool> m_fIsExecuted;
     };
 }
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @var size_t PoolHistogramBuckets
+    /// @brief The number of buckets of the task wait and run time histograms.
+    /// Bucket i counts durations in [2^i, 2^(i+1)) nanoseconds, the last bucket is open-ended.
+    inline constexpr size_t PoolHistogramBuckets = 40;
+
+    /// @typedef PoolHistogram
+    /// @brief A snapshot of a task wait or run time histogram.
+    typedef std::array<uint64_t, PoolHistogramBuckets> PoolHistogram;
+
+    /// @enum ETaskPriority
+    /// @brief An enumeration of the priority lanes of a CThreadPool.
+    enum ETaskPriority {
+        EHighPriority,          ///< Latency-sensitive tasks, e.g. control messages.
+        ENormalPriority,        ///< The default lane.
+        EBackgroundPriority,    ///< Bulk work which may wait for the other lanes.
+    };
+
+    /// @var size_t TaskPriorityCount
+    /// @brief The number of priority lanes.
+    inline constexpr size_t TaskPriorityCount = 3;
+
+    /// @class Devel::Threading::CWorkerCounters
+    /// @brief The live counters of a single worker of a CThreadPool.
+    ///
+    /// Every counter is only written by the thread of its worker, so updates are a relaxed load and store
+    /// without a locked instruction. The counters sit on their own cache lines, readers never slow down the
+    /// worker by sharing a line with its hot data.
+    class alignas(64) CWorkerCounters {
+    public:
+        /// @brief Returns the current time for the duration measurements.
+        /// @return The current time in nanoseconds.
+        static uint64_t now() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /// @brief Returns the histogram bucket of a duration.
+        /// @param i_nNs The duration in nanoseconds.
+        /// @return The bucket index.
+        static size_t bucket(const uint64_t i_nNs) {
+            const size_t nBucket = i_nNs ? static_cast<size_t>(std::bit_width(i_nNs)) - 1 : 0;
+            return nBucket < PoolHistogramBuckets ? nBucket : PoolHistogramBuckets - 1;
+        }
+
+        /// @brief Adds a value to a counter owned by the calling worker.
+        /// @param i_nCounter The counter.
+        /// @param i_nValue The value to add.
+        static void add(std::atomic<uint64_t> &i_nCounter, const uint64_t i_nValue) {
+            i_nCounter.store(i_nCounter.load(std::memory_order_relaxed) + i_nValue, std::memory_order_relaxed);
+        }
+
+    public:
+        /// @brief Records the queue wait and run time of a timed task.
+        /// @param i_ePriority The lane the task was queued in.
+        /// @param i_nWaitNs The time between adding the task and its start in nanoseconds.
+        /// @param i_nRunNs The run time in nanoseconds.
+        void recordTask(const ETaskPriority i_ePriority, const uint64_t i_nWaitNs, const uint64_t i_nRunNs) {
+            const size_t nWaitBucket = CWorkerCounters::bucket(i_nWaitNs);
+            CWorkerCounters::add(this->m_nTimedTasks, 1);
+            CWorkerCounters::add(this->m_nWaitNs, i_nWaitNs);
+            CWorkerCounters::add(this->m_nRunNs, i_nRunNs);
+            CWorkerCounters::add(this->m_anWaitHistogram[nWaitBucket], 1);
+            CWorkerCounters::add(this->m_anRunHistogram[CWorkerCounters::bucket(i_nRunNs)], 1);
+
+            CWorkerCounters::add(this->m_anLaneTimedTasks[i_ePriority], 1);
+            CWorkerCounters::add(this->m_anLaneWaitNs[i_ePriority], i_nWaitNs);
+            CWorkerCounters::add(this->m_aanLaneWaitHistogram[i_ePriority][nWaitBucket], 1);
+        }
+
+    public:
+        /// @var std::atomic<uint64_t> m_nExecuted
+        /// @brief The number of tasks the worker has run, without the dropped ones.
+        std::atomic<uint64_t> m_nExecuted = 0;
+
+        /// @var std::atomic<uint64_t> m_nFailed
+        /// @brief The number of tasks which exited with an exception, they are counted as executed as well.
+        std::atomic<uint64_t> m_nFailed = 0;
+
+        /// @var std::atomic<uint64_t> m_nStolen
+        /// @brief The number of tasks the worker has stolen from other workers.
+        std::atomic<uint64_t> m_nStolen = 0;
+
+        /// @var std::atomic<uint64_t> m_nCancelled
+        /// @brief The number of tasks the worker dropped because their token was cancelled.
+        std::atomic<uint64_t> m_nCancelled = 0;
+
+        /// @var std::atomic<uint64_t> m_nExpired
+        /// @brief The number of tasks the worker dropped because their deadline had passed.
+        std::atomic<uint64_t> m_nExpired = 0;
+
+        /// @var std::atomic<uint64_t> m_nIdleNs
+        /// @brief The time the worker was parked waiting for a task in nanoseconds.
+        std::atomic<uint64_t> m_nIdleNs = 0;
+
+        /// @var std::atomic<uint64_t> m_nParkedSinceNs
+        /// @brief The time the worker parked, 0 while it is not parked.
+        std::atomic<uint64_t> m_nParkedSinceNs = 0;
+
+        /// @var std::atomic<uint64_t> m_nStartNs
+        /// @brief The time the current thread of the worker started, see now().
+        std::atomic<uint64_t> m_nStartNs = 0;
+
+        /// @var std::atomic<uint64_t> m_nRetiredUptimeNs
+        /// @brief The uptime of the earlier threads of the worker slot in nanoseconds.
+        std::atomic<uint64_t> m_nRetiredUptimeNs = 0;
+
+        /// @var std::atomic<uint64_t> m_nTimedTasks
+        /// @brief The number of tasks recorded in the histograms.
+        std::atomic<uint64_t> m_nTimedTasks = 0;
+
+        /// @var std::atomic<uint64_t> m_nWaitNs
+        /// @brief The total wait time of the timed tasks in nanoseconds.
+        std::atomic<uint64_t> m_nWaitNs = 0;
+
+        /// @var std::atomic<uint64_t> m_nRunNs
+        /// @brief The total run time of the timed tasks in nanoseconds.
+        std::atomic<uint64_t> m_nRunNs = 0;
+
+        /// @var std::array<std::atomic<uint64_t>, PoolHistogramBuckets> m_anWaitHistogram
+        /// @brief The histogram of the wait times of the timed tasks.
+        std::array<std::atomic<uint64_t>, PoolHistogramBuckets> m_anWaitHistogram{};
+
+        /// @var std::array<std::atomic<uint64_t>, PoolHistogramBuckets> m_anRunHistogram
+        /// @brief The histogram of the run times of the timed tasks.
+        std::array<std::atomic<uint64_t>, PoolHistogramBuckets> m_anRunHistogram{};
+
+        /// @var std::array<std::atomic<uint64_t>, TaskPriorityCount> m_anLaneTimedTasks
+        /// @brief The number of timed tasks per priority lane.
+        std::array<std::atomic<uint64_t>, TaskPriorityCount> m_anLaneTimedTasks{};
+
+        /// @var std::array<std::atomic<uint64_t>, TaskPriorityCount> m_anLaneWaitNs
+        /// @brief The total wait time of the timed tasks per priority lane in nanoseconds.
+        std::array<std::atomic<uint64_t>, TaskPriorityCount> m_anLaneWaitNs{};
+
+        /// @var std::array<std::array<std::atomic<uint64_t>, PoolHistogramBuckets>, TaskPriorityCount> m_aanLaneWaitHistogram
+        /// @brief The histograms of the wait times of the timed tasks per priority lane.
+        std::array<std::array<std::atomic<uint64_t>, PoolHistogramBuckets>, TaskPriorityCount> m_aanLaneWaitHistogram{};
+    };
+
+    /// @class Devel::Threading::CWorkerMetrics
+    /// @brief A snapshot of the counters of one worker, part of CThreadPoolMetrics.
+    class CWorkerMetrics {
+    public:
+        /// @brief Returns the fraction of the uptime the worker was not parked.
+        /// Spinning for tasks, see CThreadPool::setSpinCount(), counts as busy time.
+        /// @return The utilization between 0 and 1.
+        double utilization() const {
+            if (this->m_nUptimeNs == 0) {
+                return 0.0;
+            }
+
+            const uint64_t nIdleNs = std::min(this->m_nIdleNs, this->m_nUptimeNs);
+            return 1.0 - static_cast<double>(nIdleNs) / static_cast<double>(this->m_nUptimeNs);
+        }
+
+    public:
+        /// @var size_t m_nIndex
+        /// @brief The index of the worker inside the pool.
+        size_t m_nIndex = 0;
+
+        /// @var bool m_fIsRunning
+        /// @brief Whether the worker thread is running, retired workers keep their counters.
+        bool m_fIsRunning = false;
+
+        /// @var uint64_t m_nExecuted
+        /// @brief The number of tasks the worker has run, without the dropped ones.
+        uint64_t m_nExecuted = 0;
+
+        /// @var uint64_t m_nFailed
+        /// @brief The number of tasks which exited with an exception, they are counted as executed as well.
+        uint64_t m_nFailed = 0;
+
+        /// @var uint64_t m_nStolen
+        /// @brief The number of tasks the worker has stolen from other workers.
+        uint64_t m_nStolen = 0;
+
+        /// @var uint64_t m_nCancelled
+        /// @brief The number of tasks the worker dropped because their token was cancelled.
+        uint64_t m_nCancelled = 0;
+
+        /// @var uint64_t m_nExpired
+        /// @brief The number of tasks the worker dropped because their deadline had passed.
+        uint64_t m_nExpired = 0;
+
+        /// @var size_t m_nQueueDepth
+        /// @brief The number of tasks in the local deque of the worker.
+        size_t m_nQueueDepth = 0;
+
+        /// @var uint64_t m_nUptimeNs
+        /// @brief The time the worker thread was running in nanoseconds.
+        uint64_t m_nUptimeNs = 0;
+
+        /// @var uint64_t m_nIdleNs
+        /// @brief The time the worker was parked waiting for a task in nanoseconds.
+        uint64_t m_nIdleNs = 0;
+
+        /// @var uint64_t m_nTimedTasks
+        /// @brief The number of tasks recorded in the histograms.
+        uint64_t m_nTimedTasks = 0;
+
+        /// @var uint64_t m_nWaitNs
+        /// @brief The total wait time of the timed tasks in nanoseconds.
+        uint64_t m_nWaitNs = 0;
+
+        /// @var uint64_t m_nRunNs
+        /// @brief The total run time of the timed tasks in nanoseconds.
+        uint64_t m_nRunNs = 0;
+
+        /// @var PoolHistogram m_anWaitHistogram
+        /// @brief The histogram of the wait times, see PoolHistogramBuckets.
+        PoolHistogram m_anWaitHistogram{};
+
+        /// @var PoolHistogram m_anRunHistogram
+        /// @brief The histogram of the run times, see PoolHistogramBuckets.
+        PoolHistogram m_anRunHistogram{};
+
+        /// @var std::array<uint64_t, TaskPriorityCount> m_anLaneTimedTasks
+        /// @brief The number of timed tasks per priority lane.
+        std::array<uint64_t, TaskPriorityCount> m_anLaneTimedTasks{};
+
+        /// @var std::array<uint64_t, TaskPriorityCount> m_anLaneWaitNs
+        /// @brief The total wait time of the timed tasks per priority lane in nanoseconds.
+        std::array<uint64_t, TaskPriorityCount> m_anLaneWaitNs{};
+
+        /// @var std::array<PoolHistogram, TaskPriorityCount> m_aanLaneWaitHistogram
+        /// @brief The histograms of the wait times per priority lane.
+        std::array<PoolHistogram, TaskPriorityCount> m_aanLaneWaitHistogram{};
+    };
+
+    /// @class Devel::Threading::CThreadPoolMetrics
+    /// @brief A snapshot of the metrics of a CThreadPool, returned by CThreadPool::metrics().
+    ///
+    /// The counters grow monotonically for the lifetime of the pool, also across CThreadPool::stop() and
+    /// CThreadPool::execute(). A scraper computes rates from the difference of two snapshots.
+    class CThreadPoolMetrics {
+    public:
+        /// @brief Returns the number of tasks run by all workers, dropped tasks are not included.
+        /// @return The number of tasks.
+        uint64_t executedCount() const {
+            uint64_t nExecuted = 0;
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                nExecuted += oWorker.m_nExecuted;
+            }
+            return nExecuted;
+        }
+
+        /// @brief Returns the number of tasks which exited with an exception, they are included in executedCount().
+        /// Tasks added with addTask() must not throw, the exceptions are dropped by the workers.
+        /// @return The number of tasks.
+        uint64_t failedCount() const {
+            uint64_t nFailed = 0;
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                nFailed += oWorker.m_nFailed;
+            }
+            return nFailed;
+        }
+
+        /// @brief Returns the number of tasks stolen between workers.
+        /// @return The number of tasks.
+        uint64_t stolenCount() const {
+            uint64_t nStolen = 0;
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                nStolen += oWorker.m_nStolen;
+            }
+            return nStolen;
+        }
+
+        /// @brief Returns the number of tasks dropped because their token was cancelled.
+        /// @return The number of tasks.
+        uint64_t cancelledCount() const {
+            uint64_t nCancelled = 0;
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                nCancelled += oWorker.m_nCancelled;
+            }
+            return nCancelled;
+        }
+
+        /// @brief Returns the number of tasks dropped because their deadline had passed.
+        /// @return The number of tasks.
+        uint64_t expiredCount() const {
+            uint64_t nExpired = 0;
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                nExpired += oWorker.m_nExpired;
+            }
+            return nExpired;
+        }
+
+        /// @brief Returns the number of tasks dropped without running, see CCancellationToken.
+        /// Dropped tasks are not included in executedCount() and have no run time.
+        /// @return The number of tasks.
+        uint64_t droppedCount() const {
+            return this->cancelledCount() + this->expiredCount();
+        }
+
+        /// @brief Returns the number of queued tasks, in the shared queues and in the local deques.
+        /// @return The number of tasks.
+        size_t queueDepth() const {
+            size_t nDepth = this->m_nSharedQueueDepth;
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                nDepth += oWorker.m_nQueueDepth;
+            }
+            return nDepth;
+        }
+
+        /// @brief Returns the number of tasks queued in a priority lane.
+        /// @param i_ePriority The lane, the normal lane includes the local deques.
+        /// @return The number of tasks.
+        size_t queueDepth(const ETaskPriority i_ePriority) const {
+            size_t nDepth = this->m_anLaneQueueDepth[i_ePriority];
+            if (i_ePriority == ENormalPriority) {
+                for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                    nDepth += oWorker.m_nQueueDepth;
+                }
+            }
+            return nDepth;
+        }
+
+        /// @brief Returns the fraction of the summed uptime of all workers they were not parked.
+        /// @return The utilization between 0 and 1.
+        double utilization() const {
+            CWorkerMetrics oTotal;
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                oTotal.m_nUptimeNs += oWorker.m_nUptimeNs;
+                oTotal.m_nIdleNs += std::min(oWorker.m_nIdleNs, oWorker.m_nUptimeNs);
+            }
+            return oTotal.utilization();
+        }
+
+        /// @brief Returns the wait time histogram of all workers.
+        /// @return The merged histogram.
+        PoolHistogram waitHistogram() const {
+            PoolHistogram anHistogram{};
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                for (size_t i = 0; i < PoolHistogramBuckets; i++) {
+                    anHistogram[i] += oWorker.m_anWaitHistogram[i];
+                }
+            }
+            return anHistogram;
+        }
+
+        /// @brief Returns the wait time histogram of a priority lane of all workers.
+        /// @param i_ePriority The lane.
+        /// @return The merged histogram.
+        PoolHistogram waitHistogram(const ETaskPriority i_ePriority) const {
+            PoolHistogram anHistogram{};
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                for (size_t i = 0; i < PoolHistogramBuckets; i++) {
+                    anHistogram[i] += oWorker.m_aanLaneWaitHistogram[i_ePriority][i];
+                }
+            }
+            return anHistogram;
+        }
+
+        /// @brief Returns the mean wait time of the timed tasks of a priority lane.
+        /// @param i_ePriority The lane.
+        /// @return The mean wait time in nanoseconds, 0 if no task of the lane was timed.
+        uint64_t meanWait(const ETaskPriority i_ePriority) const {
+            uint64_t nTasks = 0;
+            uint64_t nWaitNs = 0;
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                nTasks += oWorker.m_anLaneTimedTasks[i_ePriority];
+                nWaitNs += oWorker.m_anLaneWaitNs[i_ePriority];
+            }
+            return nTasks ? nWaitNs / nTasks : 0;
+        }
+
+        /// @brief Returns the run time histogram of all workers.
+        /// @return The merged histogram.
+        PoolHistogram runHistogram() const {
+            PoolHistogram anHistogram{};
+            for (const CWorkerMetrics &oWorker: this->m_aoWorkers) {
+                for (size_t i = 0; i < PoolHistogramBuckets; i++) {
+                    anHistogram[i] += oWorker.m_anRunHistogram[i];
+                }
+            }
+            return anHistogram;
+        }
+
+        /// @brief Returns an upper bound of a percentile of a histogram.
+        /// @param i_anHistogram The histogram.
+        /// @param i_dPercentile The percentile between 0 and 100.
+        /// @return The upper limit of the bucket containing the percentile in nanoseconds, 0 if the histogram is empty.
+        static uint64_t percentile(const PoolHistogram &i_anHistogram, const double i_dPercentile) {
+            uint64_t nCount = 0;
+            for (const uint64_t nBucket: i_anHistogram) {
+                nCount += nBucket;
+            }
+            if (nCount == 0) {
+                return 0;
+            }
+
+            const double dRank = std::clamp(i_dPercentile, 0.0, 100.0) / 100.0 * static_cast<double>(nCount);
+            uint64_t nSeen = 0;
+            for (size_t i = 0; i < PoolHistogramBuckets; i++) {
+                nSeen += i_anHistogram[i];
+                if (nSeen != 0 && static_cast<double>(nSeen) >= dRank) {
+                    return i + 1 < PoolHistogramBuckets ? (uint64_t(1) << (i + 1)) - 1 : UINT64_MAX;
+                }
+            }
+            return UINT64_MAX;
+        }
+
+    public:
+        /// @var std::vector<CWorkerMetrics> m_aoWorkers
+        /// @brief The metrics of every worker slot, including retired workers.
+        std::vector<CWorkerMetrics> m_aoWorkers;
+
+        /// @var size_t m_nSharedQueueDepth
+        /// @brief The number of tasks in the shared queues, including the high and background lanes.
+        size_t m_nSharedQueueDepth = 0;
+
+        /// @var std::array<size_t, TaskPriorityCount> m_anLaneQueueDepth
+        /// @brief The number of tasks in the shared queues per priority lane, without the local deques.
+        std::array<size_t, TaskPriorityCount> m_anLaneQueueDepth{};
+
+        /// @var size_t m_nWorkerCount
+        /// @brief The number of running workers.
+        size_t m_nWorkerCount = 0;
+
+        /// @var size_t m_nIdleWorkers
+        /// @brief The number of workers parked waiting for a task.
+        size_t m_nIdleWorkers = 0;
+    };
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Core/Typedef.h"
+#include "IO/WriteStream/WriteStream.h"
+#include "Threading/InplaceTask/InplaceTask.h"
+#include "Threading/PoolAllocator/PoolAllocator.h"
+#include "Threading/ScratchArena/ScratchArena.h"
+#include "Threading/ThreadPool/ThreadPoolMetrics.h"
+#include "Threading/WorkStealingDeque/WorkStealingDeque.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @typedef ThreadPoolTaskFn
+    /// @brief The task type of CThreadPool, a move-only callable with a 64 byte inline buffer.
+    typedef CInplaceTask<64> ThreadPoolTaskFn;
+
+    class CThreadPool;
+
+    /// @class CWorkerLocalIndex
+    /// @brief Assigns every type used with CThreadPoolWorker::local() a slot index, shared by all workers.
+    class CWorkerLocalIndex {
+    public:
+        /// @brief Returns the slot index of a type.
+        /// @return The index, assigned on the first call for the type.
+        template<typename T>
+        static size_t of() {
+            static const size_t s_nIndex = CWorkerLocalIndex::next();
+            return s_nIndex;
+        }
+
+    private:
+        /// @brief Hands out the next free slot index.
+        /// @return The index.
+        static size_t next() {
+            static std::atomic<size_t> s_nNext = 0;
+            return s_nNext.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    /// @class CWorkerLocalDeleter
+    /// @brief Deletes a type-erased worker-local object.
+    class CWorkerLocalDeleter {
+    public:
+        /// @brief Deletes the object.
+        /// @param i_pObject The object.
+        void operator()(void *i_pObject) const {
+            this->m_fnDelete(i_pObject);
+        }
+
+    public:
+        /// @var void (*m_fnDelete)(void *)
+        /// @brief Deletes an object of the stored type.
+        void (*m_fnDelete)(void *) = nullptr;
+    };
+
+    /// @class CThreadPoolWorker
+    /// @brief The state of a single worker thread of a CThreadPool.
+    ///
+    /// Every worker owns a work-stealing deque. In CThreadPool::EWorkStealing mode, tasks submitted from
+    /// inside a worker are pushed to its own deque, and idle workers steal from the deques of random victims.
+    ///
+    /// Tasks reach the worker running them through CThreadPool::currentWorker(). The worker keeps state which
+    /// outlives a single task: typed worker-local objects, and a scratch stream and arena which are reset after
+    /// every task. Their memory stays with the worker, so tasks stop paying for allocations and do not contend
+    /// on the heap with the other workers.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     pool.addTask([]() {
+    ///         Devel::Threading::CThreadPoolWorker *worker = Devel::Threading::CThreadPool::currentWorker();
+    ///
+    ///         // Reused by every task on this worker, cleared when the task returns
+    ///         Devel::IO::CWriteStream &stream = worker->scratchStream();
+    ///         stream.push(header);
+    ///
+    ///         std::pmr::string name(&worker->scratchArena());
+    ///         name += prefix;
+    ///
+    ///         // One parser per worker, created on first use
+    ///         Parser &parser = worker->local<Parser>();
+    ///     });
+    /// @endcode
+    class CThreadPoolWorker {
+        friend class CThreadPool;
+
+    public:
+        /// @brief Constructs the state of a worker.
+        /// @param i_pPool The thread pool the worker belongs to.
+        /// @param i_nIndex The index of the worker inside the pool.
+        CThreadPoolWorker(CThreadPool *i_pPool, const size_t i_nIndex)
+                : m_pPool(i_pPool), m_nIndex(i_nIndex), m_nRandomState(0x9E3779B97F4A7C15ull * (i_nIndex + 1)),
+                  m_fIsRunning(false), m_nNode(0) {
+        }
+
+        /// @brief Deleted copy constructor.
+        CThreadPoolWorker(const CThreadPoolWorker &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CThreadPoolWorker &operator=(const CThreadPoolWorker &) = delete;
+
+        /// @brief Destructor, releases the tasks that are still queued in the local deque.
+        ~CThreadPoolWorker() {
+            ThreadPoolTaskFn *pTask = nullptr;
+            while (this->m_oDeque.pop(pTask)) {
+                CThreadPoolWorker::releaseTask(pTask);
+            }
+        }
+
+    public:
+        /// @brief Returns the thread pool the worker belongs to.
+        /// @return The thread pool.
+        CThreadPool *pool() const { return this->m_pPool; }
+
+        /// @brief Returns the index of the worker inside the pool.
+        /// @return The index.
+        size_t index() const { return this->m_nIndex; }
+
+        /// @brief Returns the NUMA node the worker is placed on.
+        /// @return The node index.
+        size_t node() const { return this->m_nNode; }
+
+        /// @brief Returns the CPUs the worker is pinned to.
+        /// @return The CPU numbers, empty if the worker is not pinned.
+        const std::vector<size_t> &cpus() const { return this->m_anCpus; }
+
+        /// @brief Returns the live counters of the worker, see CThreadPool::metrics() for a snapshot.
+        /// @return The counters.
+        const CWorkerCounters &counters() const { return this->m_oCounters; }
+
+    public:
+        /// @brief Returns the worker-local object of a type, it is default constructed on the first call.
+        /// The object lives as long as the worker and must only be used by tasks running on this worker.
+        /// @return The object.
+        template<typename T>
+        T &local() {
+            const size_t nIndex = CWorkerLocalIndex::of<T>();
+            if (nIndex >= this->m_apLocals.size()) {
+                this->m_apLocals.resize(nIndex + 1);
+            }
+
+            std::unique_ptr<void, CWorkerLocalDeleter> &pLocal = this->m_apLocals[nIndex];
+            if (!pLocal) {
+                pLocal = std::unique_ptr<void, CWorkerLocalDeleter>(new T(), CWorkerLocalDeleter{[](void *i_pObject) {
+                    delete static_cast<T *>(i_pObject);
+                }});
+            }
+
+            return *static_cast<T *>(pLocal.get());
+        }
+
+        /// @brief Returns the scratch stream of the worker. It is cleared when the current task returns,
+        /// its buffer is kept for the next task.
+        /// @return The stream.
+        IO::CWriteStream &scratchStream() {
+            this->m_fHasScratch = true;
+            return this->m_oScratchStream;
+        }
+
+        /// @brief Returns the scratch arena of the worker. It is reset when the current task returns,
+        /// its chunks are kept for the next task. Memory from the arena must not outlive the task.
+        /// @return The arena.
+        CScratchArena &scratchArena() {
+            this->m_fHasScratch = true;
+            return this->m_oScratchArena;
+        }
+
+    private:
+        /// @brief Moves a task into a node which can be stored in a local deque.
+        /// The node is taken from a pool allocator, so pushing to a local deque does not reach the global heap.
+        /// @param i_fnTask The task.
+        /// @return The node holding the task.
+        static ThreadPoolTaskFn *allocateTask(ThreadPoolTaskFn &&i_fnTask) {
+            return new(CPoolAllocator<ThreadPoolTaskFn>::allocate()) ThreadPoolTaskFn(std::move(i_fnTask));
+        }
+
+        /// @brief Destroys a node created by allocateTask().
+        /// @param i_pTask The node.
+        static void releaseTask(ThreadPoolTaskFn *i_pTask) {
+            i_pTask->~ThreadPoolTaskFn();
+            CPoolAllocator<ThreadPoolTaskFn>::deallocate(i_pTask);
+        }
+
+        /// @brief Clears the scratch stream and resets the scratch arena if the finished task used them.
+        void resetScratch() {
+            if (this->m_fHasScratch) {
+                this->m_oScratchStream.clear();
+                this->m_oScratchArena.reset();
+                this->m_fHasScratch = false;
+            }
+        }
+
+        /// @brief Returns the next value of the worker-local xorshift generator used to pick steal victims.
+        /// @return A pseudo random number.
+        uint64 nextRandom() {
+            this->m_nRandomState ^= this->m_nRandomState << 13;
+            this->m_nRandomState ^= this->m_nRandomState >> 7;
+            this->m_nRandomState ^= this->m_nRandomState << 17;
+            return this->m_nRandomState;
+        }
+
+    private:
+        /// @var CThreadPool *m_pPool
+        /// @brief The thread pool the worker belongs to.
+        CThreadPool *m_pPool;
+
+        /// @var size_t m_nIndex
+        /// @brief The index of the worker inside the pool.
+        size_t m_nIndex;
+
+        /// @var uint64 m_nRandomState
+        /// @brief The state of the xorshift generator used to pick steal victims.
+        uint64 m_nRandomState;
+
+        /// @var CWorkStealingDeque<ThreadPoolTaskFn *> m_oDeque
+        /// @brief The local task deque of the worker.
+        CWorkStealingDeque<ThreadPoolTaskFn *> m_oDeque;
+
+        /// @var std::thread m_oThread
+        /// @brief The thread running the worker.
+        std::thread m_oThread;
+
+        /// @var std::atomic<bool> m_fIsRunning
+        /// @brief Whether the worker thread is running, the slot of a retired worker is reused by the pool.
+        std::atomic<bool> m_fIsRunning;
+
+        /// @var size_t m_nNode
+        /// @brief The NUMA node the worker is placed on.
+        size_t m_nNode;
+
+        /// @var std::array<int64_t, TaskPriorityCount> m_anLaneCredits
+        /// @brief The credits of the priority lanes in CThreadPool::EWeightedFair mode.
+        std::array<int64_t, TaskPriorityCount> m_anLaneCredits{};
+
+        /// @var std::vector<size_t> m_anCpus
+        /// @brief The CPUs the worker is pinned to, empty if it is not pinned.
+        std::vector<size_t> m_anCpus;
+
+        /// @var std::vector<std::unique_ptr<void, CWorkerLocalDeleter>> m_apLocals
+        /// @brief The worker-local objects, indexed by CWorkerLocalIndex.
+        std::vector<std::unique_ptr<void, CWorkerLocalDeleter>> m_apLocals;
+
+        /// @var IO::CWriteStream m_oScratchStream
+        /// @brief The scratch stream, cleared after every task which used it.
+        IO::CWriteStream m_oScratchStream;
+
+        /// @var CScratchArena m_oScratchArena
+        /// @brief The scratch arena, reset after every task which used it.
+        CScratchArena m_oScratchArena;
+
+        /// @var bool m_fHasScratch
+        /// @brief Whether the current task has used the scratch stream or arena.
+        bool m_fHasScratch = false;
+
+        /// @var bool m_fHasDroppedTask
+        /// @brief Whether the current task was dropped by its token, it is then not counted as executed.
+        bool m_fHasDroppedTask = false;
+
+        /// @var CWorkerCounters m_oCounters
+        /// @brief The counters of the worker, kept when the worker retires and its slot is reused.
+        CWorkerCounters m_oCounters;
+    };
+}
@@ -1,7 +1,19 @@
 #pragma once
 
 #include "Core/Global.h"
+#include <string>
 #include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DEVEL_HAS_CPU_PAUSE
+#endif
 
 /// @namespace Devel::Threading::Utils
 /// @brief The namespace encapsulating threading related utility functions in the Devel framework.
@@ -12,7 +24,71 @@ namespace Devel::Threading::Utils {
     /// The execution of the thread is suspended, and no CPU time is consumed during the sleep period.
     ///
     /// @param i_nMilliseconds The number of milliseconds to sleep.
-    static void sleep(size_t i_nMilliseconds) {
+    inline void sleep(size_t i_nMilliseconds) {
         std::this_thread::sleep_for(std::chrono::milliseconds(i_nMilliseconds));
     }
-}
\ No newline at end of file
+
+    /// @brief Hints the processor that the calling thread is busy-waiting.
+    ///
+    /// This function should be called inside spin loops. On x86 it issues a `pause` instruction,
+    /// which lowers the power consumption of the loop and frees resources for the sibling hyper-thread.
+    /// On other architectures it yields the remaining time slice of the thread.
+    inline void cpuRelax() {
+#ifdef DEVEL_HAS_CPU_PAUSE
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /// @brief Sets the name of the calling thread, as shown by tools like top, perf and gdb.
+    ///
+    /// Linux limits thread names to 15 characters, longer names are truncated.
+    ///
+    /// @param i_stName The name of the thread.
+    /// @return True if the name was set, false if it is not supported.
+    inline bool setCurrentThreadName(const std::string &i_stName) {
+#ifdef __linux__
+        return pthread_setname_np(pthread_self(), i_stName.substr(0, 15).c_str()) == 0;
+#else
+        return false;
+#endif
+    }
+
+    /// @brief Restricts the calling thread to a set of CPUs.
+    /// @param i_anCpus The CPU numbers the thread may run on.
+    /// @return True if the affinity was set, false if the set is empty, invalid or affinity is not supported.
+    inline bool setCurrentThreadAffinity(const std::vector<size_t> &i_anCpus) {
+#ifdef __linux__
+        cpu_set_t oSet;
+        CPU_ZERO(&oSet);
+        for (const size_t nCpu: i_anCpus) {
+            if (nCpu < CPU_SETSIZE) {
+                CPU_SET(nCpu, &oSet);
+            }
+        }
+
+        return CPU_COUNT(&oSet) != 0 && pthread_setaffinity_np(pthread_self(), sizeof(oSet), &oSet) == 0;
+#else
+        return false;
+#endif
+    }
+
+    /// @brief Returns the CPUs the calling thread may run on.
+    /// @return The CPU numbers, empty if affinity is not supported.
+    inline std::vector<size_t> currentThreadAffinity() {
+        std::vector<size_t> anCpus;
+#ifdef __linux__
+        cpu_set_t oSet;
+        CPU_ZERO(&oSet);
+        if (pthread_getaffinity_np(pthread_self(), sizeof(oSet), &oSet) == 0) {
+            for (size_t nCpu = 0; nCpu < CPU_SETSIZE; nCpu++) {
+                if (CPU_ISSET(nCpu, &oSet)) {
+                    anCpus.push_back(nCpu);
+                }
+            }
+        }
+#endif
+        return anCpus;
+    }
+}
@@ -0,0 +1,287 @@
+#include "TimerWheel.h"
+
+Devel::Threading::CTimerWheel::CTimerWheel(CThreadPool &i_oPool, const Duration i_oResolution)
+        : m_oPool(i_oPool),
+          m_oResolution(std::max<Duration>(i_oResolution, std::chrono::microseconds(1))),
+          m_oStart(std::chrono::steady_clock::now()), m_pFreeEntry(nullptr), m_nCurrentTick(0), m_nNextId(1),
+          m_nPendingCount(0), m_fIsExecuted(false) {
+}
+
+bool Devel::Threading::CTimerWheel::execute() {
+    std::lock_guard<std::mutex> oLock(this->m_oMutex);
+    if (this->m_fIsExecuted) {
+        return false;
+    }
+
+    this->m_fIsExecuted = true;
+    this->m_oThread = std::thread(&CTimerWheel::handleTimer, this);
+    return true;
+}
+
+void Devel::Threading::CTimerWheel::stop() {
+    {
+        std::lock_guard<std::mutex> oLock(this->m_oMutex);
+        if (!this->m_fIsExecuted) {
+            return;
+        }
+
+        this->m_fIsExecuted = false;
+    }
+    this->m_oCondition.notify_all();
+
+    if (this->m_oThread.joinable()) {
+        this->m_oThread.join();
+    }
+}
+
+bool Devel::Threading::CTimerWheel::cancel(const CTimerHandle &i_oHandle) {
+    std::lock_guard<std::mutex> oLock(this->m_oMutex);
+
+    CTimerEntry *pEntry = this->pendingEntry(i_oHandle);
+    if (!pEntry) {
+        return false;
+    }
+
+    CTimerWheel::unlink(pEntry);
+    this->release(pEntry);
+    return true;
+}
+
+bool Devel::Threading::CTimerWheel::reschedule(const CTimerHandle &i_oHandle, const Duration i_oDelay) {
+    const uint64 nExpiry = this->expiryOf(i_oDelay);
+    std::lock_guard<std::mutex> oLock(this->m_oMutex);
+
+    CTimerEntry *pEntry = this->pendingEntry(i_oHandle);
+    if (!pEntry) {
+        return false;
+    }
+
+    CTimerWheel::unlink(pEntry);
+    pEntry->m_nExpiry = nExpiry;
+    this->link(pEntry);
+    return true;
+}
+
+bool Devel::Threading::CTimerWheel::isPending(const CTimerHandle &i_oHandle) const {
+    std::lock_guard<std::mutex> oLock(this->m_oMutex);
+    return this->pendingEntry(i_oHandle) != nullptr;
+}
+
+Devel::Threading::CTimerHandle Devel::Threading::CTimerWheel::schedule(const Duration i_oDelay, const uint64 i_nPeriod,
+                                                                       ThreadPoolTaskFn &&i_fnTask,
+                                                                       std::shared_ptr<CPeriodicTask> i_pPeriodic) {
+    const uint64 nNow = this->currentTick();
+    const uint64 nExpiry = this->expiryOf(i_oDelay);
+    bool fWasEmpty = false;
+    CTimerHandle oHandle;
+
+    {
+        std::lock_guard<std::mutex> oLock(this->m_oMutex);
+
+        // An empty wheel skips the ticks it slept through, no slot has to be visited
+        if (this->m_nPendingCount == 0 && this->m_nCurrentTick < nNow) {
+            this->m_nCurrentTick = nNow;
+        }
+
+        CTimerEntry *pEntry = this->m_pFreeEntry;
+        if (pEntry) {
+            this->m_pFreeEntry = static_cast<CTimerEntry *>(pEntry->m_pNext);
+        } else {
+            pEntry = &this->m_aoEntries.emplace_back();
+        }
+
+        pEntry->m_nId = this->m_nNextId++;
+        pEntry->m_nExpiry = nExpiry;
+        pEntry->m_nPeriod = i_nPeriod;
+        pEntry->m_fnTask = std::move(i_fnTask);
+        pEntry->m_pPeriodic = std::move(i_pPeriodic);
+        this->link(pEntry);
+
+        fWasEmpty = (this->m_nPendingCount++ == 0);
+        oHandle = CTimerHandle(pEntry, pEntry->m_nId);
+    }
+
+    // The timer thread only sleeps without a timeout while the wheel is empty
+    if (fWasEmpty) {
+        this->m_oCondition.notify_one();
+    }
+
+    return oHandle;
+}
+
+uint64 Devel::Threading::CTimerWheel::toTicks(const Duration i_oDuration) const {
+    if (i_oDuration <= Duration::zero()) {
+        return 0;
+    }
+
+    return static_cast<uint64>((i_oDuration + this->m_oResolution - Duration(1)) / this->m_oResolution);
+}
+
+uint64 Devel::Threading::CTimerWheel::expiryOf(const Duration i_oDelay) const {
+    // Rounding the deadline up to the next tick boundary makes sure a timer never fires early
+    return this->toTicks(std::chrono::steady_clock::now() - this->m_oStart + std::max(i_oDelay, Duration::zero()));
+}
+
+uint64 Devel::Threading::CTimerWheel::currentTick() const {
+    return static_cast<uint64>((std::chrono::steady_clock::now() - this->m_oStart) / this->m_oResolution);
+}
+
+Devel::Threading::CTimerWheel::CTimerEntry *Devel::Threading::CTimerWheel::pendingEntry(
+        const CTimerHandle &i_oHandle) const {
+    // Entries are never freed while the wheel lives, a reused entry carries a different id
+    CTimerEntry *pEntry = static_cast<CTimerEntry *>(i_oHandle.m_pEntry);
+    return (pEntry && i_oHandle.m_nId != 0 && pEntry->m_nId == i_oHandle.m_nId) ? pEntry : nullptr;
+}
+
+void Devel::Threading::CTimerWheel::link(CTimerEntry *i_pEntry) {
+    // A timer due before the current tick fires with it
+    const uint64 nExpiry = std::max(i_pEntry->m_nExpiry, this->m_nCurrentTick);
+
+    // The timer goes to the lowest level in which its expiry and the current tick only differ in the slot bits
+    CTimerLink *pSlot = &this->m_oOverflow;
+    for (size_t nLevel = 0; nLevel < LevelCount; nLevel++) {
+        const size_t nShift = SlotBits * (nLevel + 1);
+        if ((nExpiry >> nShift) == (this->m_nCurrentTick >> nShift)) {
+            pSlot = &this->m_aaoSlots[nLevel][(nExpiry >> (SlotBits * nLevel)) & (SlotCount - 1)];
+            break;
+        }
+    }
+
+    i_pEntry->m_pPrev = pSlot->m_pPrev;
+    i_pEntry->m_pNext = pSlot;
+    pSlot->m_pPrev->m_pNext = i_pEntry;
+    pSlot->m_pPrev = i_pEntry;
+}
+
+void Devel::Threading::CTimerWheel::unlink(CTimerLink *i_pLink) {
+    i_pLink->m_pPrev->m_pNext = i_pLink->m_pNext;
+    i_pLink->m_pNext->m_pPrev = i_pLink->m_pPrev;
+    i_pLink->m_pPrev = i_pLink;
+    i_pLink->m_pNext = i_pLink;
+}
+
+void Devel::Threading::CTimerWheel::cascade(CTimerLink &i_oSlot) {
+    // Detach the list first, entries may be linked into the same slot again
+    CTimerLink oList;
+    if (i_oSlot.m_pNext == &i_oSlot) {
+        return;
+    }
+
+    oList.m_pNext = i_oSlot.m_pNext;
+    oList.m_pPrev = i_oSlot.m_pPrev;
+    oList.m_pNext->m_pPrev = &oList;
+    oList.m_pPrev->m_pNext = &oList;
+    i_oSlot.m_pNext = &i_oSlot;
+    i_oSlot.m_pPrev = &i_oSlot;
+
+    while (oList.m_pNext != &oList) {
+        CTimerEntry *pEntry = static_cast<CTimerEntry *>(oList.m_pNext);
+        CTimerWheel::unlink(pEntry);
+        this->link(pEntry);
+    }
+}
+
+void Devel::Threading::CTimerWheel::advance(std::vector<ThreadPoolTaskFn> &i_afnOutTasks) {
+    const uint64 nTick = this->m_nCurrentTick;
+
+    // When a level wraps around, the next slot of the level above is spread over the levels below,
+    // starting at the highest level so its timers can move down several levels at once
+    if ((nTick & (SlotCount - 1)) == 0) {
+        size_t nLevel = 1;
+        while (nLevel < LevelCount && ((nTick >> (SlotBits * nLevel)) & (SlotCount - 1)) == 0) {
+            nLevel++;
+        }
+        if (nLevel == LevelCount) {
+            this->cascade(this->m_oOverflow);
+            nLevel--;
+        }
+        for (; nLevel >= 1; nLevel--) {
+            this->cascade(this->m_aaoSlots[nLevel][(nTick >> (SlotBits * nLevel)) & (SlotCount - 1)]);
+        }
+    }
+
+    CTimerLink &oSlot = this->m_aaoSlots[0][nTick & (SlotCount - 1)];
+    while (oSlot.m_pNext != &oSlot) {
+        CTimerEntry *pEntry = static_cast<CTimerEntry *>(oSlot.m_pNext);
+        CTimerWheel::unlink(pEntry);
+
+        if (!pEntry->m_pPeriodic) {
+            i_afnOutTasks.emplace_back(std::move(pEntry->m_fnTask));
+            this->release(pEntry);
+            continue;
+        }
+
+        // A run which is still busy skips this period
+        i_afnOutTasks.emplace_back([pPeriodic = pEntry->m_pPeriodic]() {
+            if (!pPeriodic->m_fIsRunning.exchange(true, std::memory_order_acquire)) {
+                try {
+                    pPeriodic->m_fnTask();
+                } catch (...) {}
+                pPeriodic->m_fIsRunning.store(false, std::memory_order_release);
+            }
+        });
+
+        pEntry->m_nExpiry = nTick + pEntry->m_nPeriod;
+        this->link(pEntry);
+    }
+
+    this->m_nCurrentTick = nTick + 1;
+}
+
+void Devel::Threading::CTimerWheel::release(CTimerEntry *i_pEntry) {
+    i_pEntry->m_nId = 0;
+    i_pEntry->m_fnTask = nullptr;
+    i_pEntry->m_pPeriodic.reset();
+
+    i_pEntry->m_pNext = this->m_pFreeEntry;
+    this->m_pFreeEntry = i_pEntry;
+    this->m_nPendingCount--;
+}
+
+void Devel::Threading::CTimerWheel::dropPending() {
+    while (this->m_nPendingCount != 0) {
+        std::vector<ThreadPoolTaskFn> afnTasks;
+        {
+            std::lock_guard<std::mutex> oLock(this->m_oMutex);
+            for (CTimerEntry &oEntry: this->m_aoEntries) {
+                if (oEntry.m_nId != 0) {
+                    CTimerWheel::unlink(&oEntry);
+                    afnTasks.emplace_back(std::move(oEntry.m_fnTask));
+                    this->release(&oEntry);
+                }
+            }
+        }
+
+        // Destroyed without the lock, a dropped sleep resumes its coroutine right here
+        afnTasks.clear();
+    }
+}
+
+void Devel::Threading::CTimerWheel::handleTimer() {
+    std::vector<ThreadPoolTaskFn> afnTasks;
+    std::unique_lock<std::mutex> oLock(this->m_oMutex);
+
+    while (this->m_fIsExecuted) {
+        if (this->m_nPendingCount == 0) {
+            this->m_oCondition.wait(oLock, [this]() { return this->m_nPendingCount != 0 || !this->m_fIsExecuted; });
+            continue;
+        }
+
+        const uint64 nNow = this->currentTick();
+        while (this->m_nCurrentTick <= nNow) {
+            this->advance(afnTasks);
+        }
+
+        if (!afnTasks.empty()) {
+            oLock.unlock();
+            for (ThreadPoolTaskFn &fnTask: afnTasks) {
+                this->m_oPool.addTask(std::move(fnTask));
+            }
+            afnTasks.clear();
+            oLock.lock();
+            continue;
+        }
+
+        this->m_oCondition.wait_until(oLock, this->m_oStart + this->m_oResolution * this->m_nCurrentTick);
+    }
+}
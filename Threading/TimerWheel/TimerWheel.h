@@ -0,0 +1,463 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Core/Exceptions.h"
+#include "Threading/ThreadPool/ThreadPool.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    class CTimerWheel;
+
+    /// @class Devel::Threading::CTimerHandle
+    /// @brief Identifies a timer scheduled on a CTimerWheel, used to cancel or reschedule it.
+    ///
+    /// A handle stays safe to use after its timer has fired or was cancelled, the wheel then ignores it.
+    class CTimerHandle {
+        friend class CTimerWheel;
+
+    public:
+        /// @brief Constructs a handle which refers to no timer.
+        CTimerHandle()
+                : m_pEntry(nullptr), m_nId(0) {
+        }
+
+    public:
+        /// @brief Checks if the handle was returned by a schedule call.
+        /// Use CTimerWheel::isPending() to check if the timer is still waiting.
+        /// @return True if the handle refers to a timer.
+        bool isValid() const { return this->m_nId != 0; }
+
+    private:
+        /// @brief Constructs a handle of a timer.
+        /// @param i_pEntry The timer entry.
+        /// @param i_nId The id the entry had when the timer was scheduled.
+        CTimerHandle(void *i_pEntry, const uint64 i_nId)
+                : m_pEntry(i_pEntry), m_nId(i_nId) {
+        }
+
+    private:
+        /// @var void *m_pEntry
+        /// @brief The timer entry, owned by the wheel and reused for later timers.
+        void *m_pEntry;
+
+        /// @var uint64 m_nId
+        /// @brief The id of the timer, the entry no longer belongs to it once its id differs.
+        uint64 m_nId;
+    };
+
+    /// @class Devel::Threading::CTimerWheel
+    /// @brief A hierarchical timing wheel that hands delayed and periodic tasks to a CThreadPool.
+    ///
+    /// Timers are kept in four levels of 256 slots, level n covers 256^(n+1) ticks. A timer is stored in the
+    /// lowest level whose range still contains its expiry, and is moved down a level whenever the wheel reaches
+    /// its slot. Timers beyond 2^32 ticks wait in an overflow list. Scheduling, cancelling and rescheduling are
+    /// O(1), the timer entries are recycled, so millions of pending timeouts cost no allocation per timer.
+    ///
+    /// A single timer thread advances the wheel once per tick and adds the due tasks to the thread pool, it sleeps
+    /// while no timer is pending. Timers fire at the first tick boundary after their delay, never earlier.
+    ///
+    /// A periodic task is never run twice at the same time: if the previous run is still busy when the timer
+    /// fires again, the period is skipped. Cancelling a periodic timer stops further runs, a running one completes.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CThreadPool pool(4);
+    ///     Devel::Threading::CTimerWheel timers(pool);
+    ///     pool.execute();
+    ///     timers.execute();
+    ///
+    ///     Devel::Threading::CTimerHandle timeout = timers.scheduleAfter(std::chrono::seconds(30), [&]() {
+    ///         connection.close();
+    ///     });
+    ///     timers.scheduleEvery(std::chrono::seconds(1), []() { flushStatistics(); });
+    ///
+    ///     // Activity on the connection restarts the timeout
+    ///     timers.reschedule(timeout, std::chrono::seconds(30));
+    /// @endcode
+    class CTimerWheel {
+    public:
+        /// @typedef Duration
+        /// @brief The duration type of delays and periods.
+        typedef std::chrono::steady_clock::duration Duration;
+
+        /// @var static constexpr size_t LevelCount
+        /// @brief The number of levels of the wheel.
+        static constexpr size_t LevelCount = 4;
+
+        /// @var static constexpr size_t SlotBits
+        /// @brief The number of tick bits covered by one level.
+        static constexpr size_t SlotBits = 8;
+
+        /// @var static constexpr size_t SlotCount
+        /// @brief The number of slots of one level.
+        static constexpr size_t SlotCount = size_t(1) << SlotBits;
+
+        /// @class CSleepAwaiter
+        /// @brief The awaitable returned by sleepFor(), it resumes the awaiting coroutine on the pool after a delay.
+        class CSleepAwaiter {
+        private:
+            /// @class CResumer
+            /// @brief The timer task of a sleeping coroutine.
+            /// A resumer which is destroyed without having run, because the wheel was destroyed or the pool dropped
+            /// it, resumes the coroutine cancelled, so the coroutine unwinds and its frames are released.
+            class CResumer {
+            public:
+                /// @brief Constructs the resumer.
+                /// @param i_pAwaiter The awaiter in the frame of the coroutine.
+                /// @param i_hCoroutine The suspended coroutine.
+                CResumer(CSleepAwaiter *i_pAwaiter, const std::coroutine_handle<> i_hCoroutine)
+                        : m_pAwaiter(i_pAwaiter), m_hCoroutine(i_hCoroutine) {
+                }
+
+                /// @brief Move constructor, the coroutine is resumed by the new resumer.
+                /// @param i_oOther The resumer to take the coroutine from.
+                CResumer(CResumer &&i_oOther) noexcept
+                        : m_pAwaiter(i_oOther.m_pAwaiter), m_hCoroutine(std::exchange(i_oOther.m_hCoroutine, nullptr)) {
+                }
+
+                /// @brief Deleted copy constructor.
+                CResumer(const CResumer &) = delete;
+
+                /// @brief Destructor, resumes a coroutine which was not resumed as cancelled.
+                ~CResumer() {
+                    if (this->m_hCoroutine) {
+                        this->m_pAwaiter->m_fIsCancelled = true;
+                        std::exchange(this->m_hCoroutine, nullptr).resume();
+                    }
+                }
+
+            public:
+                /// @brief Resumes the coroutine after its delay.
+                void operator()() {
+                    std::exchange(this->m_hCoroutine, nullptr).resume();
+                }
+
+            private:
+                /// @var CSleepAwaiter *m_pAwaiter
+                /// @brief The awaiter in the frame of the coroutine.
+                CSleepAwaiter *m_pAwaiter;
+
+                /// @var std::coroutine_handle<> m_hCoroutine
+                /// @brief The suspended coroutine, nullptr once it was resumed.
+                std::coroutine_handle<> m_hCoroutine;
+            };
+
+        public:
+            /// @brief Constructs the awaitable.
+            /// @param i_pWheel The timer wheel.
+            /// @param i_oDelay The delay.
+            CSleepAwaiter(CTimerWheel *i_pWheel, const Duration i_oDelay)
+                    : m_pWheel(i_pWheel), m_oDelay(i_oDelay), m_fIsCancelled(false) {
+            }
+
+        public:
+            /// @brief A delay which is not positive does not suspend.
+            /// @return True if the coroutine continues immediately.
+            bool await_ready() const noexcept { return this->m_oDelay <= Duration::zero(); }
+
+            /// @brief Schedules the resumption of the coroutine as a timer.
+            /// @param i_hCoroutine The suspended coroutine.
+            void await_suspend(std::coroutine_handle<> i_hCoroutine) {
+                this->m_pWheel->scheduleAfter(this->m_oDelay, CResumer(this, i_hCoroutine));
+            }
+
+            /// @brief Called on a pool worker when the coroutine resumes.
+            /// @throws TaskCancelledException if the sleep was dropped before its delay passed.
+            void await_resume() const {
+                if (this->m_fIsCancelled) {
+                    throw TaskCancelledException;
+                }
+            }
+
+        private:
+            /// @var CTimerWheel *m_pWheel
+            /// @brief The timer wheel.
+            CTimerWheel *m_pWheel;
+
+            /// @var Duration m_oDelay
+            /// @brief The delay.
+            Duration m_oDelay;
+
+            /// @var bool m_fIsCancelled
+            /// @brief Whether the sleep was dropped before its delay passed.
+            bool m_fIsCancelled;
+        };
+
+    private:
+        /// @class CTimerLink
+        /// @brief The links of an intrusive doubly linked slot list.
+        class CTimerLink {
+        public:
+            /// @var CTimerLink *m_pPrev
+            /// @brief The previous element of the list.
+            CTimerLink *m_pPrev = this;
+
+            /// @var CTimerLink *m_pNext
+            /// @brief The next element of the list.
+            CTimerLink *m_pNext = this;
+        };
+
+        /// @class CPeriodicTask
+        /// @brief The task of a periodic timer, shared by all its runs.
+        class CPeriodicTask {
+        public:
+            /// @brief Constructs the periodic task.
+            /// @param i_fnTask The task.
+            explicit CPeriodicTask(ThreadPoolTaskFn &&i_fnTask)
+                    : m_fnTask(std::move(i_fnTask)), m_fIsRunning(false) {
+            }
+
+        public:
+            /// @var ThreadPoolTaskFn m_fnTask
+            /// @brief The task.
+            ThreadPoolTaskFn m_fnTask;
+
+            /// @var std::atomic<bool> m_fIsRunning
+            /// @brief Whether a run is in progress.
+            std::atomic<bool> m_fIsRunning;
+        };
+
+        /// @class CTimerEntry
+        /// @brief A scheduled timer, linked into a slot of the wheel.
+        class CTimerEntry : public CTimerLink {
+        public:
+            /// @var uint64 m_nId
+            /// @brief The id of the timer, 0 while the entry is free.
+            uint64 m_nId = 0;
+
+            /// @var uint64 m_nExpiry
+            /// @brief The tick at which the timer fires.
+            uint64 m_nExpiry = 0;
+
+            /// @var uint64 m_nPeriod
+            /// @brief The period in ticks, 0 for a one-shot timer.
+            uint64 m_nPeriod = 0;
+
+            /// @var ThreadPoolTaskFn m_fnTask
+            /// @brief The task of a one-shot timer.
+            ThreadPoolTaskFn m_fnTask;
+
+            /// @var std::shared_ptr<CPeriodicTask> m_pPeriodic
+            /// @brief The task of a periodic timer.
+            std::shared_ptr<CPeriodicTask> m_pPeriodic;
+        };
+
+    public:
+        /// @brief Constructs a timer wheel which hands due tasks to a thread pool.
+        /// The clock of the wheel starts at construction, timers may be scheduled before execute().
+        /// @param i_oPool The thread pool running the tasks.
+        /// @param i_oResolution The duration of a tick, at least one microsecond.
+        explicit CTimerWheel(CThreadPool &i_oPool, Duration i_oResolution = std::chrono::milliseconds(1));
+
+        /// @brief Destructor, stops the timer thread. Pending timers are dropped.
+        /// Pending sleeps are resumed on the destroying thread and throw TaskCancelledException, see sleepFor().
+        ~CTimerWheel() {
+            this->stop();
+            this->dropPending();
+        }
+
+        /// @brief Deleted copy constructor.
+        CTimerWheel(const CTimerWheel &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CTimerWheel &operator=(const CTimerWheel &) = delete;
+
+    public:
+        /// @brief Starts the timer thread.
+        /// @return True if the thread was started, false if it is already running.
+        bool execute();
+
+        /// @brief Stops the timer thread. Pending timers are kept and fire after the next execute().
+        void stop();
+
+    public:
+        /// @brief Schedules a task to run once after a delay.
+        /// @param i_oDelay The delay.
+        /// @param i_fnTask The task, it must fit into a ThreadPoolTaskFn.
+        /// @return The handle of the timer.
+        template<typename F>
+        CTimerHandle scheduleAfter(const Duration i_oDelay, F &&i_fnTask) {
+            return this->schedule(i_oDelay, 0, ThreadPoolTaskFn(std::forward<F>(i_fnTask)), nullptr);
+        }
+
+        /// @brief Schedules a task to run repeatedly, the first run is one period from now.
+        /// @param i_oPeriod The period, at least one tick.
+        /// @param i_fnTask The task, it must fit into a ThreadPoolTaskFn.
+        /// @return The handle of the timer.
+        template<typename F>
+        CTimerHandle scheduleEvery(const Duration i_oPeriod, F &&i_fnTask) {
+            return this->schedule(i_oPeriod, std::max<uint64>(this->toTicks(i_oPeriod), 1), nullptr,
+                                  std::make_shared<CPeriodicTask>(ThreadPoolTaskFn(std::forward<F>(i_fnTask))));
+        }
+
+        /// @brief Returns an awaitable which suspends the awaiting coroutine for a delay without blocking a thread.
+        /// The coroutine resumes on a worker of the thread pool. If the wheel is destroyed or the pool drops the
+        /// timer task before the delay passed, the coroutine resumes on that thread and co_await throws
+        /// TaskCancelledException, so it unwinds and its frame is released instead of leaking.
+        /// Such a coroutine must not sleep on the wheel again.
+        /// @code{.cpp}
+        ///     co_await timers.sleepFor(std::chrono::milliseconds(100));
+        /// @endcode
+        /// @param i_oDelay The delay.
+        /// @return The awaitable.
+        CSleepAwaiter sleepFor(const Duration i_oDelay) {
+            return CSleepAwaiter(this, i_oDelay);
+        }
+
+        /// @brief Cancels a timer.
+        /// @param i_oHandle The handle of the timer.
+        /// @return True if the timer was pending and is cancelled, false if it already fired or was cancelled.
+        bool cancel(const CTimerHandle &i_oHandle);
+
+        /// @brief Moves the expiry of a pending timer to a delay from now, e.g. to restart an idle timeout.
+        /// The period of a periodic timer is not changed.
+        /// @param i_oHandle The handle of the timer.
+        /// @param i_oDelay The new delay.
+        /// @return True if the timer was pending and is rescheduled, false otherwise.
+        bool reschedule(const CTimerHandle &i_oHandle, Duration i_oDelay);
+
+        /// @brief Checks if a timer is still waiting to fire.
+        /// Periodic timers stay pending until they are cancelled.
+        /// @param i_oHandle The handle of the timer.
+        /// @return True if the timer is pending.
+        bool isPending(const CTimerHandle &i_oHandle) const;
+
+    public:
+        /// @brief Returns the number of pending timers.
+        /// @return The number of timers.
+        size_t pendingCount() const { return this->m_nPendingCount; }
+
+        /// @brief Returns the duration of a tick.
+        /// @return The resolution.
+        Duration resolution() const { return this->m_oResolution; }
+
+        /// @brief Checks if the timer thread is running.
+        /// @return True if the timer thread is running.
+        bool isExecuted() const { return this->m_fIsExecuted; }
+
+    private:
+        /// @brief Schedules a timer.
+        /// @param i_oDelay The delay until the first run.
+        /// @param i_nPeriod The period in ticks, 0 for a one-shot timer.
+        /// @param i_fnTask The task of a one-shot timer.
+        /// @param i_pPeriodic The task of a periodic timer.
+        /// @return The handle of the timer.
+        CTimerHandle schedule(Duration i_oDelay, uint64 i_nPeriod, ThreadPoolTaskFn &&i_fnTask,
+                              std::shared_ptr<CPeriodicTask> i_pPeriodic);
+
+        /// @brief Converts a duration to ticks, rounded up.
+        /// @param i_oDuration The duration.
+        /// @return The number of ticks.
+        uint64 toTicks(Duration i_oDuration) const;
+
+        /// @brief Returns the first tick at or after a delay from now.
+        /// @param i_oDelay The delay.
+        /// @return The tick.
+        uint64 expiryOf(Duration i_oDelay) const;
+
+        /// @brief Returns the tick of the current time.
+        /// @return The number of ticks since construction.
+        uint64 currentTick() const;
+
+        /// @brief Returns the entry of a pending timer. Must be called with the mutex held.
+        /// @param i_oHandle The handle of the timer.
+        /// @return The entry, nullptr if the timer is not pending.
+        CTimerEntry *pendingEntry(const CTimerHandle &i_oHandle) const;
+
+        /// @brief Links an entry into the slot of its expiry. Must be called with the mutex held.
+        /// @param i_pEntry The entry.
+        void link(CTimerEntry *i_pEntry);
+
+        /// @brief Unlinks an entry from its slot.
+        /// @param i_pLink The entry.
+        static void unlink(CTimerLink *i_pLink);
+
+        /// @brief Moves the entries of a slot to the slots of their expiry relative to the current tick.
+        /// @param i_oSlot The slot.
+        void cascade(CTimerLink &i_oSlot);
+
+        /// @brief Processes the current tick and advances the wheel by one tick.
+        /// @param i_afnOutTasks Receives the tasks due at the tick.
+        void advance(std::vector<ThreadPoolTaskFn> &i_afnOutTasks);
+
+        /// @brief Returns an entry to the free list. Must be called with the mutex held.
+        /// @param i_pEntry The unlinked entry.
+        void release(CTimerEntry *i_pEntry);
+
+        /// @brief Drops all pending timers, the tasks are destroyed without running.
+        /// Dropped sleeps resume cancelled, the wheel is drained until they scheduled no new timer.
+        void dropPending();
+
+        /// @brief The timer thread.
+        void handleTimer();
+
+    private:
+        /// @var CThreadPool &m_oPool
+        /// @brief The thread pool running the tasks.
+        CThreadPool &m_oPool;
+
+        /// @var Duration m_oResolution
+        /// @brief The duration of a tick.
+        Duration m_oResolution;
+
+        /// @var std::chrono::steady_clock::time_point m_oStart
+        /// @brief The time of tick 0.
+        std::chrono::steady_clock::time_point m_oStart;
+
+        /// @var CTimerLink m_aaoSlots[LevelCount][SlotCount]
+        /// @brief The slot lists of all levels.
+        CTimerLink m_aaoSlots[LevelCount][SlotCount];
+
+        /// @var CTimerLink m_oOverflow
+        /// @brief The timers beyond the range of the highest level.
+        CTimerLink m_oOverflow;
+
+        /// @var std::deque<CTimerEntry> m_aoEntries
+        /// @brief The storage of all entries, the addresses stay stable so handles can refer to them.
+        std::deque<CTimerEntry> m_aoEntries;
+
+        /// @var CTimerEntry *m_pFreeEntry
+        /// @brief The first free entry, free entries are chained through m_pNext.
+        CTimerEntry *m_pFreeEntry;
+
+        /// @var uint64 m_nCurrentTick
+        /// @brief The next tick to be processed.
+        uint64 m_nCurrentTick;
+
+        /// @var uint64 m_nNextId
+        /// @brief The id of the next timer.
+        uint64 m_nNextId;
+
+        /// @var std::atomic<size_t> m_nPendingCount
+        /// @brief The number of pending timers.
+        std::atomic<size_t> m_nPendingCount;
+
+        /// @var mutable std::mutex m_oMutex
+        /// @brief The mutex protecting the wheel.
+        mutable std::mutex m_oMutex;
+
+        /// @var std::condition_variable m_oCondition
+        /// @brief Wakes up the timer thread when the first timer is scheduled or the wheel is stopped.
+        std::condition_variable m_oCondition;
+
+        /// @var std::thread m_oThread
+        /// @brief The timer thread.
+        std::thread m_oThread;
+
+        /// @var std::atomic<bool> m_fIsExecuted
+        /// @brief Whether the timer thread is running.
+        std::atomic<bool> m_fIsExecuted;
+    };
+}
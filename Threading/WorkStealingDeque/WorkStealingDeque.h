@@ -0,0 +1,221 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <type_traits>
+
+#include "Core/Typedef.h"
+
+/// @namespace Devel::Threading
+/// @brief The namespace encapsulating threading related classes and functions in the Devel framework.
+namespace Devel::Threading {
+    /// @class Devel::Threading::CWorkStealingDeque<T>
+    /// @brief A lock-free work-stealing deque (Chase-Lev).
+    ///
+    /// The deque has a single owner thread which pushes and pops elements at the bottom (LIFO),
+    /// while any number of other threads can steal elements from the top (FIFO).
+    /// The underlying ring buffer grows on demand; retired buffers are kept alive until the deque
+    /// is destroyed, because a concurrent thief might still read from them.
+    ///
+    /// @tparam T The type of elements stored in the deque. It must be trivially copyable, usually a pointer.
+    ///
+    /// <b>Example</b>
+    ///
+    /// @code{.cpp}
+    ///     Devel::Threading::CWorkStealingDeque<int *> deque;
+    ///
+    ///     // Owner thread
+    ///     deque.push(new int(1));
+    ///     int *pValue = nullptr;
+    ///     if (deque.pop(pValue)) {
+    ///         delete pValue;
+    ///     }
+    ///
+    ///     // Any other thread
+    ///     if (deque.steal(pValue)) {
+    ///         delete pValue;
+    ///     }
+    /// @endcode
+    template<typename T>
+    class CWorkStealingDeque {
+        static_assert(std::is_trivially_copyable_v<T>, "CWorkStealingDeque requires a trivially copyable type");
+
+    private:
+        /// @class CArray
+        /// @brief A power of two sized ring buffer used as storage of the deque.
+        class CArray {
+        public:
+            /// @brief Constructs a ring buffer with the given capacity.
+            /// @param i_nCapacity The capacity, must be a power of two.
+            explicit CArray(const int64 i_nCapacity)
+                    : m_nCapacity(i_nCapacity), m_nMask(i_nCapacity - 1),
+                      m_atData(new std::atomic<T>[static_cast<size_t>(i_nCapacity)]) {
+            }
+
+        public:
+            /// @brief Returns the capacity of the ring buffer.
+            /// @return The capacity.
+            int64 capacity() const { return this->m_nCapacity; }
+
+            /// @brief Stores an element at the given logical index.
+            /// @param i_nIndex The logical index.
+            /// @param i_tValue The element.
+            void put(const int64 i_nIndex, const T i_tValue) {
+                this->m_atData[i_nIndex & this->m_nMask].store(i_tValue, std::memory_order_relaxed);
+            }
+
+            /// @brief Loads the element at the given logical index.
+            /// @param i_nIndex The logical index.
+            /// @return The element.
+            T get(const int64 i_nIndex) const {
+                return this->m_atData[i_nIndex & this->m_nMask].load(std::memory_order_relaxed);
+            }
+
+            /// @brief Creates a ring buffer of twice the capacity containing the elements in [i_nTop, i_nBottom).
+            /// @param i_nBottom The bottom index.
+            /// @param i_nTop The top index.
+            /// @return The new ring buffer.
+            CArray *grow(const int64 i_nBottom, const int64 i_nTop) const {
+                auto *pArray = new CArray(this->m_nCapacity * 2);
+                for (int64 i = i_nTop; i != i_nBottom; i++) {
+                    pArray->put(i, this->get(i));
+                }
+
+                return pArray;
+            }
+
+        private:
+            /// @var int64 m_nCapacity
+            /// @brief The capacity of the ring buffer.
+            int64 m_nCapacity;
+
+            /// @var int64 m_nMask
+            /// @brief The mask used to map a logical index into the ring buffer.
+            int64 m_nMask;
+
+            /// @var std::unique_ptr<std::atomic<T>[]> m_atData
+            /// @brief The elements of the ring buffer.
+            std::unique_ptr<std::atomic<T>[]> m_atData;
+        };
+
+    public:
+        /// @brief Constructs an empty deque.
+        /// @param i_nCapacity The initial capacity, must be a power of two.
+        explicit CWorkStealingDeque(const int64 i_nCapacity = 256)
+                : m_nTop(0), m_nBottom(0) {
+            this->m_apArrays.emplace_back(new CArray(i_nCapacity));
+            this->m_pArray.store(this->m_apArrays.back().get(), std::memory_order_relaxed);
+        }
+
+        /// @brief Deleted copy constructor.
+        CWorkStealingDeque(const CWorkStealingDeque &) = delete;
+
+        /// @brief Deleted copy assignment operator.
+        CWorkStealingDeque &operator=(const CWorkStealingDeque &) = delete;
+
+        /// @brief Default destructor.
+        ~CWorkStealingDeque() = default;
+
+    public:
+        /// @brief Pushes an element at the bottom of the deque. Must only be called by the owner thread.
+        /// @param i_tValue The element to push.
+        void push(const T i_tValue) {
+            const int64 nBottom = this->m_nBottom.load(std::memory_order_relaxed);
+            const int64 nTop = this->m_nTop.load(std::memory_order_acquire);
+            CArray *pArray = this->m_pArray.load(std::memory_order_relaxed);
+
+            if (nBottom - nTop > pArray->capacity() - 1) {
+                pArray = pArray->grow(nBottom, nTop);
+                this->m_apArrays.emplace_back(pArray);
+                this->m_pArray.store(pArray, std::memory_order_release);
+            }
+
+            pArray->put(nBottom, i_tValue);
+            std::atomic_thread_fence(std::memory_order_release);
+            this->m_nBottom.store(nBottom + 1, std::memory_order_relaxed);
+        }
+
+        /// @brief Pops the most recently pushed element. Must only be called by the owner thread.
+        /// @param i_tOutValue Receives the element on success.
+        /// @return True if an element was popped, false if the deque is empty.
+        bool pop(T &i_tOutValue) {
+            const int64 nBottom = this->m_nBottom.load(std::memory_order_relaxed) - 1;
+            CArray *pArray = this->m_pArray.load(std::memory_order_relaxed);
+            this->m_nBottom.store(nBottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64 nTop = this->m_nTop.load(std::memory_order_relaxed);
+
+            if (nTop > nBottom) {
+                this->m_nBottom.store(nBottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            i_tOutValue = pArray->get(nBottom);
+            if (nTop == nBottom) {
+                // Last element, race against thieves for it
+                const bool fWon = this->m_nTop.compare_exchange_strong(nTop, nTop + 1, std::memory_order_seq_cst,
+                                                                       std::memory_order_relaxed);
+                this->m_nBottom.store(nBottom + 1, std::memory_order_relaxed);
+                return fWon;
+            }
+
+            return true;
+        }
+
+        /// @brief Steals the oldest element of the deque. Can be called by any thread.
+        /// @param i_tOutValue Receives the element on success.
+        /// @return True if an element was stolen, false if the deque is empty or the steal lost a race.
+        bool steal(T &i_tOutValue) {
+            int64 nTop = this->m_nTop.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64 nBottom = this->m_nBottom.load(std::memory_order_acquire);
+
+            if (nTop >= nBottom) {
+                return false;
+            }
+
+            CArray *pArray = this->m_pArray.load(std::memory_order_acquire);
+            const T tValue = pArray->get(nTop);
+            if (!this->m_nTop.compare_exchange_strong(nTop, nTop + 1, std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed)) {
+                return false;
+            }
+
+            i_tOutValue = tValue;
+            return true;
+        }
+
+    public:
+        /// @brief Returns an approximation of the number of elements in the deque.
+        /// @return The number of elements.
+        size_t size() const {
+            const int64 nBottom = this->m_nBottom.load(std::memory_order_relaxed);
+            const int64 nTop = this->m_nTop.load(std::memory_order_relaxed);
+            return static_cast<size_t>(nBottom > nTop ? nBottom - nTop : 0);
+        }
+
+        /// @brief Checks if the deque is (approximately) empty.
+        /// @return True if the deque is empty, false otherwise.
+        bool isEmpty() const {
+            return this->size() == 0;
+        }
+
+    private:
+        /// @var std::atomic<int64> m_nTop
+        /// @brief The index thieves steal from.
+        alignas(64) std::atomic<int64> m_nTop;
+
+        /// @var std::atomic<int64> m_nBottom
+        /// @brief The index the owner pushes to and pops from.
+        alignas(64) std::atomic<int64> m_nBottom;
+
+        /// @var std::atomic<CArray *> m_pArray
+        /// @brief The current ring buffer.
+        std::atomic<CArray *> m_pArray;
+
+        /// @var std::vector<std::unique_ptr<CArray>> m_apArrays
+        /// @brief All ring buffers ever used by the deque, kept alive for concurrent thieves.
+        std::vector<std::unique_ptr<CArray>> m_apArrays;
+    };
+}
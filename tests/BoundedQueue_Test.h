@@ -0,0 +1,184 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Devel::Threading;
+
+TEST_CASE( "BOUNDED_QUEUE_FIFO", "[BOUNDEDQUEUE_TEST]" ) {
+    CBoundedQueue<std::string, 4> oQueue;
+    REQUIRE( oQueue.isEmpty() );
+    REQUIRE( oQueue.capacity() == 4 );
+
+    REQUIRE( oQueue.tryEnqueue(std::string("a")) );
+    REQUIRE( oQueue.tryEnqueue(std::string("b")) );
+    REQUIRE( oQueue.tryEnqueue(std::string("c")) );
+    REQUIRE( oQueue.tryEnqueue(std::string("d")) );
+    REQUIRE_FALSE( oQueue.tryEnqueue(std::string("e")) );
+    REQUIRE( oQueue.size() == 4 );
+
+    std::string sValue;
+    REQUIRE( oQueue.tryDequeue(sValue) );
+    REQUIRE( sValue == "a" );
+    REQUIRE( oQueue.dequeue() == "b" );
+
+    oQueue.clear();
+    REQUIRE( oQueue.isEmpty() );
+    REQUIRE_FALSE( oQueue.tryDequeue(sValue) );
+}
+
+TEST_CASE( "BOUNDED_QUEUE_MPMC", "[BOUNDEDQUEUE_TEST]" ) {
+    CBoundedQueue<size_t, 64> oQueue;
+    std::atomic<size_t> nSum = 0;
+    std::vector<std::thread> aoThreads;
+
+    for (size_t i = 0; i < 4; i++) {
+        aoThreads.emplace_back([&oQueue]() {
+            for (size_t j = 1; j <= 10000; j++) {
+                oQueue.enqueue(j);
+            }
+        });
+        aoThreads.emplace_back([&oQueue, &nSum]() {
+            for (size_t j = 0; j < 10000; j++) {
+                nSum += oQueue.dequeue();
+            }
+        });
+    }
+
+    for (std::thread &oThread: aoThreads) {
+        oThread.join();
+    }
+
+    REQUIRE( nSum == 4 * (10000 * 10001 / 2) );
+    REQUIRE( oQueue.isEmpty() );
+}
+
+TEST_CASE( "THREADPOOL_BOUNDED_QUEUE", "[BOUNDEDQUEUE_TEST]" ) {
+    CThreadPool oPool(2);
+    std::atomic<size_t> nCounter = 0;
+
+    for (size_t i = 0; i < 10; i++) {
+        oPool.addTask([&nCounter]() { nCounter++; });
+    }
+
+    oPool.setQueueType(CThreadPool::EBoundedQueue);
+    REQUIRE( oPool.queueType() == CThreadPool::EBoundedQueue );
+    oPool.execute();
+
+    for (size_t i = 0; i < 2 * CThreadPool::BoundedQueueCapacity; i++) {
+        oPool.addTask([&nCounter]() { nCounter++; });
+    }
+
+    // Tasks added by workers run inline once the queue is full
+    oPool.addTask([&oPool, &nCounter]() {
+        for (size_t i = 0; i < 2 * CThreadPool::BoundedQueueCapacity; i++) {
+            oPool.addTask([&nCounter]() { nCounter++; });
+        }
+    });
+
+    const size_t nExpected = 10 + 4 * CThreadPool::BoundedQueueCapacity;
+    Devel::CTimer oTimer(true);
+    while (nCounter != nExpected && !oTimer.hasExpired(5000)) {
+        std::this_thread::yield();
+    }
+    REQUIRE( nCounter == nExpected );
+}
+
+TEST_CASE( "THREADPOOL_BOUNDED_QUEUE_NOT_RUNNING", "[BOUNDEDQUEUE_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.setQueueType(CThreadPool::EBoundedQueue);
+    std::atomic<size_t> nCounter = 0;
+
+    // Nothing drains the queue before execute(), the tasks which do not fit run on the caller
+    for (size_t i = 0; i < CThreadPool::BoundedQueueCapacity + 10; i++) {
+        oPool.addTask([&nCounter]() { nCounter++; });
+    }
+    REQUIRE( nCounter == 10 );
+
+    oPool.execute();
+    oPool.waitIdle();
+    REQUIRE( nCounter == CThreadPool::BoundedQueueCapacity + 10 );
+
+    // Nor after stop()
+    oPool.stop();
+    for (size_t i = 0; i < CThreadPool::BoundedQueueCapacity + 10; i++) {
+        oPool.addTask([&nCounter]() { nCounter++; });
+    }
+    REQUIRE( nCounter == CThreadPool::BoundedQueueCapacity + 20 );
+}
+
+TEST_CASE( "THREADPOOL_BOUNDED_QUEUE_INLINE_METRICS", "[BOUNDEDQUEUE_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.setQueueType(CThreadPool::EBoundedQueue);
+    oPool.execute();
+
+    // The only worker fills the queue, the tasks after that run inline and are counted like queued ones
+    const size_t nCount = CThreadPool::BoundedQueueCapacity + 100;
+    oPool.addTask([&oPool, nCount]() {
+        for (size_t i = 0; i < nCount; i++) {
+            oPool.addTask([i]() {
+                if (i % 2 == 0) {
+                    throw std::runtime_error("task failed");
+                }
+            });
+        }
+    });
+    oPool.waitIdle();
+
+    const CThreadPoolMetrics oMetrics = oPool.metrics();
+    REQUIRE( oMetrics.executedCount() == nCount + 1 );
+    REQUIRE( oMetrics.failedCount() == nCount / 2 );
+}
+
+TEST_CASE( "BOUNDED_QUEUE_VS_SAFE_QUEUE", "[.][BOUNDEDQUEUE_BENCHMARK]" ) {
+    constexpr size_t nOperations = 100000;
+
+    BENCHMARK("CSafeQueue 2 producers 2 consumers") {
+        CSafeQueue<size_t> oQueue;
+        std::vector<std::thread> aoThreads;
+        for (size_t i = 0; i < 2; i++) {
+            aoThreads.emplace_back([&oQueue]() {
+                for (size_t j = 0; j < nOperations; j++) {
+                    oQueue.enqueue(j);
+                }
+            });
+            aoThreads.emplace_back([&oQueue]() {
+                for (size_t j = 0; j < nOperations;) {
+                    try {
+                        oQueue.dequeue();
+                        j++;
+                    } catch (const std::range_error &) {}
+                }
+            });
+        }
+        for (std::thread &oThread: aoThreads) {
+            oThread.join();
+        }
+    };
+
+    BENCHMARK("CBoundedQueue 2 producers 2 consumers") {
+        CBoundedQueue<size_t, 1024> oQueue;
+        std::vector<std::thread> aoThreads;
+        for (size_t i = 0; i < 2; i++) {
+            aoThreads.emplace_back([&oQueue]() {
+                for (size_t j = 0; j < nOperations; j++) {
+                    oQueue.enqueue(j);
+                }
+            });
+            aoThreads.emplace_back([&oQueue]() {
+                for (size_t j = 0; j < nOperations; j++) {
+                    oQueue.dequeue();
+                }
+            });
+        }
+        for (std::thread &oThread: aoThreads) {
+            oThread.join();
+        }
+    };
+}
@@ -0,0 +1,187 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace Devel;
+using namespace Devel::Threading;
+
+TEST_CASE( "CANCELLATION_TOKEN_STATES", "[CANCELLATIONTOKEN_TEST]" ) {
+    CCancellationToken oNone;
+    REQUIRE_FALSE( oNone.canBeCancelled() );
+    REQUIRE_FALSE( oNone.isCancelled() );
+    REQUIRE_NOTHROW( oNone.throwIfCancelled() );
+
+    CCancellationToken oToken;
+    {
+        CCancellationSource oSource;
+        oToken = oSource.token();
+        CCancellationSource oCopy = oSource;
+        REQUIRE( oToken.canBeCancelled() );
+        REQUIRE_FALSE( oToken.isCancelled() );
+
+        oCopy.cancel();
+        REQUIRE( oSource.isCancelled() );
+    }
+
+    // The token outlives its source
+    REQUIRE( oToken.isCancelled() );
+    REQUIRE_FALSE( oToken.hasExpired() );
+    REQUIRE_THROWS_AS( oToken.throwIfCancelled(), std::runtime_error );
+
+    // Deadlines do not need a source, the earlier deadline wins
+    CCancellationToken oExpired = CCancellationToken::timeout(std::chrono::milliseconds(-1));
+    REQUIRE( oExpired.hasExpired() );
+    REQUIRE( oExpired.isCancelled() );
+
+    CCancellationToken oLater = CCancellationToken::timeout(std::chrono::hours(1));
+    REQUIRE_FALSE( oLater.isCancelled() );
+    REQUIRE( oLater.withTimeout(std::chrono::hours(2)).deadline() == oLater.deadline() );
+    REQUIRE( oLater.withDeadline(oExpired.deadline()).isCancelled() );
+
+    CCancellationSource oSource;
+    CCancellationToken oShort = oSource.token().withTimeout(std::chrono::milliseconds(5));
+    REQUIRE_FALSE( oShort.isCancelled() );
+    Utils::sleep(10);
+    REQUIRE( oShort.hasExpired() );
+    REQUIRE_FALSE( oSource.isCancelled() );
+}
+
+TEST_CASE( "CANCELLATION_DROPS_QUEUED_TASKS", "[CANCELLATIONTOKEN_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.execute();
+
+    std::atomic<bool> fStarted = false;
+    std::atomic<bool> fRelease = false;
+    oPool.addTask([&fStarted, &fRelease]() {
+        fStarted = true;
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+    while (!fStarted) {
+        std::this_thread::yield();
+    }
+
+    // Tasks queued behind the busy worker, a part of them is no longer wanted when the worker gets to them
+    CCancellationSource oSource;
+    std::atomic<size_t> nRun = 0;
+    for (size_t i = 0; i < 10; i++) {
+        oPool.addTask([&nRun]() { nRun++; }, oSource.token());
+        oPool.addTask([&nRun]() { nRun++; }, CCancellationToken::timeout(std::chrono::milliseconds(1)));
+        oPool.addTask([&nRun]() { nRun++; }, CCancellationToken::timeout(std::chrono::hours(1)));
+        oPool.addTask([&nRun]() { nRun++; }, CCancellationToken(), EHighPriority);
+    }
+    auto oCancelled = oPool.submit(oSource.token(), []() { return 1; });
+    auto oExpired = oPool.submit(CCancellationToken::timeout(std::chrono::milliseconds(1)), EHighPriority,
+                                 [](int a) { return a; }, 2);
+    auto oKept = oPool.submit(CCancellationToken::timeout(std::chrono::hours(1)), []() { return 3; });
+
+    oSource.cancel();
+    Utils::sleep(5);
+    fRelease = true;
+    oPool.waitIdle();
+
+    REQUIRE( nRun == 20 );
+    REQUIRE_THROWS_AS( oCancelled.get(), std::runtime_error );
+    REQUIRE_THROWS_AS( oExpired.get(), std::runtime_error );
+    REQUIRE( oKept.get() == 3 );
+
+    // The drop is recorded after the task returned, waitIdle() may return a moment before
+    CTimer oTimer(true);
+    while ((oPool.metrics().droppedCount() != 22 || oPool.metrics().executedCount() != 22) &&
+           !oTimer.hasExpired(5000));
+
+    const CThreadPoolMetrics oMetrics = oPool.metrics();
+    REQUIRE( oMetrics.cancelledCount() == 11 );
+    REQUIRE( oMetrics.expiredCount() == 11 );
+    REQUIRE( oMetrics.droppedCount() == 22 );
+    // The blocking task, the kept tasks and the kept submit(), dropped tasks are not executed
+    REQUIRE( oMetrics.executedCount() == 22 );
+
+    // A running task polls its token and stops early
+    CCancellationSource oStop;
+    std::atomic<bool> fIsRunning = false;
+    auto oLoop = oPool.submit(oStop.token(), [&fIsRunning](const CCancellationToken &i_oToken) {
+        fIsRunning = true;
+        size_t nIterations = 0;
+        while (true) {
+            i_oToken.throwIfCancelled();
+            nIterations++;
+            std::this_thread::yield();
+        }
+        return nIterations;
+    }, oStop.token());
+    while (!fIsRunning) {
+        std::this_thread::yield();
+    }
+    oStop.cancel();
+    REQUIRE_THROWS_AS( oLoop.get(), std::runtime_error );
+}
+
+TEST_CASE( "CANCELLATION_DROPS_INLINE_TASKS", "[CANCELLATIONTOKEN_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.setQueueType(CThreadPool::EBoundedQueue);
+    oPool.setTaskTiming(true);
+    oPool.execute();
+
+    // The tasks of a pool which is not running are run inline by the thread adding them once its queue is full
+    CThreadPool oStopped(1);
+    oStopped.setQueueType(CThreadPool::EBoundedQueue);
+
+    CCancellationSource oSource;
+    oSource.cancel();
+
+    // The only worker fills the queue with cancelled tasks, the ones after that are dropped inline
+    const size_t nCount = CThreadPool::BoundedQueueCapacity + 100;
+    std::atomic<size_t> nRun = 0;
+    oPool.addTask([&oPool, &oStopped, &oSource, &nRun, nCount]() {
+        for (size_t i = 0; i < nCount; i++) {
+            oPool.addTask([&nRun]() { nRun++; }, oSource.token());
+        }
+        for (size_t i = 0; i < CThreadPool::BoundedQueueCapacity + 10; i++) {
+            oStopped.addTask([&nRun]() { nRun++; }, oSource.token());
+        }
+    });
+    oPool.waitIdle();
+
+    // Only the enclosing task is executed and timed, the drops of the other pool are not counted here
+    const CThreadPoolMetrics oMetrics = oPool.metrics();
+    REQUIRE( nRun == 0 );
+    REQUIRE( oMetrics.executedCount() == 1 );
+    REQUIRE( oMetrics.cancelledCount() == nCount );
+    REQUIRE( oMetrics.m_aoWorkers[0].m_nTimedTasks == 1 );
+}
+
+TEST_CASE( "CANCELLED_BACKLOG", "[.][CANCELLATIONTOKEN_BENCHMARK]" ) {
+    CThreadPool oPool(std::thread::hardware_concurrency());
+    oPool.execute();
+
+    // A backlog of 2000 tasks whose client gave up before the pool got to them
+    const auto fnWork = []() {
+        for (size_t i = 0; i < 200; i++) {
+            Utils::cpuRelax();
+        }
+    };
+
+    BENCHMARK("run the backlog") {
+        for (size_t i = 0; i < 2000; i++) {
+            oPool.addTask(fnWork);
+        }
+        oPool.waitIdle();
+    };
+
+    BENCHMARK("drop the cancelled backlog") {
+        CCancellationSource oSource;
+        oSource.cancel();
+        for (size_t i = 0; i < 2000; i++) {
+            oPool.addTask(fnWork, oSource.token());
+        }
+        oPool.waitIdle();
+    };
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Devel::Threading;
+
+TEST_CASE( "CONCURRENT_HASH_MAP_BASIC", "[CONCURRENTHASHMAP_TEST]" ) {
+    CConcurrentHashMap<int, std::string> oMap;
+    REQUIRE( oMap.isEmpty() );
+
+    REQUIRE( oMap.insert(1, "one") );
+    REQUIRE_FALSE( oMap.insert(1, "uno") );
+    REQUIRE( oMap.find(1) == "one" );
+    REQUIRE_FALSE( oMap.insertOrAssign(1, "uno") );
+    REQUIRE( oMap.find(1) == "uno" );
+
+    REQUIRE( oMap.findOrInsert(2, []() { return std::string("two"); }) == "two" );
+    REQUIRE( oMap.findOrInsert(2, []() { return std::string("zwei"); }) == "two" );
+
+    REQUIRE( oMap.update(2, [](std::string &i_stValue) { i_stValue += "!"; }) );
+    REQUIRE_FALSE( oMap.update(3, [](std::string &) {}) );
+
+    std::string stValue;
+    REQUIRE( oMap.tryGet(2, stValue) );
+    REQUIRE( stValue == "two!" );
+    REQUIRE_FALSE( oMap.tryGet(3, stValue) );
+    REQUIRE_THROWS_AS( oMap.find(3), std::range_error );
+
+    REQUIRE( oMap.size() == 2 );
+    REQUIRE( oMap.erase(1) );
+    REQUIRE_FALSE( oMap.erase(1) );
+    REQUIRE_FALSE( oMap.contains(1) );
+    REQUIRE( oMap.contains(2) );
+
+    oMap.clear();
+    REQUIRE( oMap.isEmpty() );
+}
+
+TEST_CASE( "CONCURRENT_HASH_MAP_ITERATION", "[CONCURRENTHASHMAP_TEST]" ) {
+    CConcurrentHashMap<int, int> oMap;
+    oMap.reserve(1000);
+    for (int i = 0; i < 1000; i++) {
+        oMap.insert(i, i * 2);
+    }
+
+    size_t nCount = 0;
+    int64_t nSum = 0;
+    oMap.forEach([&](const int &i_nKey, const int &i_nValue) {
+        REQUIRE( i_nValue == i_nKey * 2 );
+        nCount++;
+        nSum += i_nValue;
+    });
+    REQUIRE( nCount == 1000 );
+    REQUIRE( nSum == 999000 );
+
+    size_t nShardTotal = 0;
+    oMap.forEachShard([&](const size_t i_nShard, const CConcurrentHashMap<int, int>::Map &i_aoMap) {
+        for (const auto &[nKey, nValue]: i_aoMap) {
+            REQUIRE( oMap.shardOf(nKey) == i_nShard );
+        }
+        nShardTotal += i_aoMap.size();
+    });
+    REQUIRE( nShardTotal == 1000 );
+
+    REQUIRE( oMap.eraseIf([](const int &i_nKey, const int &) { return i_nKey % 2 == 0; }) == 500 );
+    REQUIRE( oMap.size() == 500 );
+}
+
+TEST_CASE( "CONCURRENT_HASH_MAP_THREADS", "[CONCURRENTHASHMAP_TEST]" ) {
+    CConcurrentHashMap<int, int, std::hash<int>, CFutexMutex> oMap;
+
+    std::vector<std::thread> aoThreads;
+    for (int i = 0; i < 4; i++) {
+        aoThreads.emplace_back([&oMap]() {
+            for (int j = 0; j < 10000; j++) {
+                oMap.findOrInsert(j % 100, []() { return 0; });
+                oMap.update(j % 100, [](int &i_nValue) { i_nValue++; });
+            }
+        });
+    }
+    for (std::thread &oThread: aoThreads) {
+        oThread.join();
+    }
+
+    REQUIRE( oMap.size() == 100 );
+    for (int i = 0; i < 100; i++) {
+        REQUIRE( oMap.find(i) == 400 );
+    }
+}
+
+TEST_CASE( "CONCURRENT_HASH_MAP_VS_MUTEX_VECTOR", "[.][CONCURRENTHASHMAP_BENCHMARK]" ) {
+    constexpr int nEntries = 100000;
+    constexpr int nLookups = 1000;
+
+    CMutexVector<std::pair<int, int>> oVector;
+    CConcurrentHashMap<int, int> oMap;
+    oVector.reserve(nEntries);
+    oMap.reserve(nEntries);
+    for (int i = 0; i < nEntries; i++) {
+        oVector.push_back({i, i});
+        oMap.insert(i, i);
+    }
+
+    BENCHMARK("CMutexVector linear scan, 1000 lookups") {
+        int64_t nSum = 0;
+        for (int i = 0; i < nLookups; i++) {
+            const int nKey = (i * 7919) % nEntries;
+            nSum += oVector.find([nKey](const std::pair<int, int> &i_oEntry) { return i_oEntry.first == nKey; }).second;
+        }
+        return nSum;
+    };
+
+    BENCHMARK("CConcurrentHashMap, 1000 lookups") {
+        int64_t nSum = 0;
+        for (int i = 0; i < nLookups; i++) {
+            nSum += oMap.find((i * 7919) % nEntries);
+        }
+        return nSum;
+    };
+}
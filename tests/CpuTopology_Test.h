@@ -0,0 +1,51 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace Devel::Threading;
+
+TEST_CASE( "CPU_TOPOLOGY_PARSE_CPU_LIST", "[CPUTOPOLOGY_TEST]" ) {
+    REQUIRE( CCpuTopology::parseCpuList("0-3,8,10-11\n") == std::vector<size_t>{0, 1, 2, 3, 8, 10, 11} );
+    REQUIRE( CCpuTopology::parseCpuList("5") == std::vector<size_t>{5} );
+    REQUIRE( CCpuTopology::parseCpuList("2,1,1-2") == std::vector<size_t>{1, 2} );
+    REQUIRE( CCpuTopology::parseCpuList("").empty() );
+}
+
+TEST_CASE( "CPU_TOPOLOGY_READS_NODES", "[CPUTOPOLOGY_TEST]" ) {
+    const std::filesystem::path oRoot = std::filesystem::temp_directory_path() / "devel-cpu-topology-test";
+    std::filesystem::remove_all(oRoot);
+
+    // Two sockets with interleaved hyper-threads, node ids with a gap
+    for (const auto &[stNode, stList]: {std::pair<const char *, const char *>{"node0", "0-1,4-5"},
+                                        std::pair<const char *, const char *>{"node2", "2-3,6-7"}}) {
+        std::filesystem::create_directories(oRoot / stNode);
+        std::ofstream(oRoot / stNode / "cpulist") << stList << '\n';
+    }
+    std::filesystem::create_directories(oRoot / "power");
+
+    const CCpuTopology oTopology(oRoot.string());
+    REQUIRE( oTopology.nodeCount() == 2 );
+    REQUIRE( oTopology.cpuCount() == 8 );
+    REQUIRE( oTopology.cpusOfNode(1) == std::vector<size_t>{2, 3, 6, 7} );
+    REQUIRE( oTopology.nodeOfCpu(5) == 0 );
+    REQUIRE( oTopology.nodeOfCpu(6) == 1 );
+    REQUIRE( oTopology.nodeOfCpu(64) == 0 );
+    REQUIRE( oTopology.cpus() == std::vector<size_t>{0, 1, 4, 5, 2, 3, 6, 7} );
+    REQUIRE_THROWS_AS( oTopology.cpusOfNode(2), std::range_error );
+
+    std::filesystem::remove_all(oRoot);
+}
+
+TEST_CASE( "CPU_TOPOLOGY_FALLBACK", "[CPUTOPOLOGY_TEST]" ) {
+    const CCpuTopology oTopology("/nonexistent/devel/node");
+    REQUIRE( oTopology.nodeCount() == 1 );
+    REQUIRE( oTopology.cpuCount() >= 1 );
+
+    const CCpuTopology *pSystem = CCpuTopology::instance();
+    REQUIRE( pSystem->nodeCount() >= 1 );
+    REQUIRE( pSystem->currentNode() < pSystem->nodeCount() );
+}
@@ -5,6 +5,12 @@
 #include "IO/JsonDocument/JsonDocument.h"
 #include "Serializing/Serializing.h"
 
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
 static constexpr char k_szTestString[] = "{\n"
                                          "  \"glossary\": {\n"
                                          "    \"title\": \"example glossary\",\n"
@@ -200,3 +206,66 @@ TEST_CASE("SERIALIZE_JSON_DOCUMENT", "[IO_JSON_TEST]") {
 
 
 
+
+TEST_CASE("JSON_OBJECT_LOCKING", "[IO_JSON_TEST]") {
+    IO::CJsonObject oObject;
+
+    // The mutex is recursive, a caller holding it can still use the accessors
+    {
+        Threading::RecursiveLockGuard(oObject.mutex());
+        oObject["a"] = 1;
+        REQUIRE(oObject.find("a") != nullptr);
+        REQUIRE(oObject.getKeys().size() == 1);
+    }
+
+    // Four writers insert disjoint keys while a reader checks every key it sees, all start together
+    const int nWriters = 4;
+    const int nKeys = 20000;
+    std::atomic<bool> fStart = false;
+    std::vector<std::thread> aoThreads;
+    for (int nWriter = 0; nWriter < nWriters; nWriter++) {
+        aoThreads.emplace_back([&oObject, &fStart, nWriter, nWriters, nKeys]() {
+            while (!fStart) {
+                std::this_thread::yield();
+            }
+            for (int i = nWriter; i < nKeys; i += nWriters) {
+                oObject["key" + std::to_string(i)] = i;
+            }
+        });
+    }
+    size_t nMismatches = 0;
+    aoThreads.emplace_back([&oObject, &fStart, &nMismatches]() {
+        while (!fStart) {
+            std::this_thread::yield();
+        }
+        for (int i = 0; i < 20; i++) {
+            Threading::RecursiveLockGuard(oObject.mutex());
+            for (const std::string &stKey: oObject.getKeys()) {
+                // A key is inserted by operator[] before its value is assigned
+                IO::CJsonObject *pValue = oObject.find(stKey);
+                Threading::RecursiveLockGuard(pValue->mutex());
+                if (stKey != "a" && pValue->type() == IO::EJsonType::JTNumber &&
+                    stKey != "key" + std::to_string(pValue->toInt())) {
+                    nMismatches++;
+                }
+            }
+        }
+    });
+    fStart = true;
+    for (std::thread &oThread: aoThreads) {
+        oThread.join();
+    }
+    REQUIRE(nMismatches == 0);
+
+    // No insert is lost or duplicated and every value belongs to its key
+    const std::vector<std::string> astKeys = oObject.getKeys();
+    REQUIRE(astKeys.size() == nKeys + 1);
+    REQUIRE(std::set<std::string>(astKeys.begin(), astKeys.end()).size() == nKeys + 1);
+    REQUIRE(oObject.find("a")->toInt() == 1);
+    size_t nMissing = 0;
+    for (int i = 0; i < nKeys; i++) {
+        const IO::CJsonObject *pValue = oObject.find("key" + std::to_string(i));
+        nMissing += pValue == nullptr || pValue->toInt() != i ? 1 : 0;
+    }
+    REQUIRE(nMissing == 0);
+}
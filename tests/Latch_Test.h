@@ -0,0 +1,83 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Devel;
+using namespace Devel::Threading;
+
+TEST_CASE( "LATCH_COUNT_DOWN", "[LATCH_TEST]" ) {
+    CLatch oOpen(0);
+    REQUIRE( oOpen.tryWait() );
+    oOpen.wait();
+
+    CLatch oLatch(3);
+    REQUIRE_FALSE( oLatch.tryWait() );
+    oLatch.countDown();
+    REQUIRE( oLatch.count() == 2 );
+    oLatch.countDown(0);
+    REQUIRE( oLatch.count() == 2 );
+    oLatch.countDown(2);
+    REQUIRE( oLatch.count() == 0 );
+    REQUIRE( oLatch.tryWait() );
+    oLatch.wait();
+}
+
+TEST_CASE( "LATCH_RELEASES_WAITERS", "[LATCH_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    constexpr size_t nTasks = 200;
+    std::atomic<size_t> nCounter = 0;
+    CLatch oDone(nTasks);
+
+    for (size_t i = 0; i < nTasks; i++) {
+        oPool.addTask([&nCounter, &oDone]() {
+            nCounter++;
+            oDone.countDown();
+        });
+    }
+
+    // Several threads may wait on the same latch
+    std::vector<std::thread> aoWaiters;
+    std::atomic<size_t> nReleased = 0;
+    for (size_t i = 0; i < 3; i++) {
+        aoWaiters.emplace_back([&oDone, &nCounter, &nReleased]() {
+            oDone.wait();
+            if (nCounter == nTasks) {
+                nReleased++;
+            }
+        });
+    }
+
+    oDone.wait();
+    REQUIRE( nCounter == nTasks );
+    for (std::thread &oWaiter: aoWaiters) {
+        oWaiter.join();
+    }
+    REQUIRE( nReleased == 3 );
+
+    // Every thread arrives and continues once all have arrived
+    CLatch oStart(3);
+    std::atomic<size_t> nArrived = 0;
+    std::atomic<size_t> nEarly = 0;
+    std::vector<std::thread> aoThreads;
+    for (size_t i = 0; i < 2; i++) {
+        aoThreads.emplace_back([&]() {
+            nArrived++;
+            oStart.arriveAndWait();
+            if (nArrived != 3) {
+                nEarly++;
+            }
+        });
+    }
+    nArrived++;
+    oStart.arriveAndWait();
+    for (std::thread &oThread: aoThreads) {
+        oThread.join();
+    }
+    REQUIRE( nEarly == 0 );
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace Devel::Threading;
+
+template<typename TLock>
+static size_t lockPolicyIncrement(const size_t i_nThreads, const size_t i_nIterations) {
+    TLock oLock;
+    size_t nCounter = 0;
+
+    std::vector<std::thread> aoThreads;
+    for (size_t i = 0; i < i_nThreads; i++) {
+        aoThreads.emplace_back([&]() {
+            for (size_t j = 0; j < i_nIterations; j++) {
+                RecursiveLockGuard(oLock);
+                nCounter++;
+            }
+        });
+    }
+    for (std::thread &oThread: aoThreads) {
+        oThread.join();
+    }
+
+    return nCounter;
+}
+
+TEST_CASE( "LOCK_POLICY_MUTUAL_EXCLUSION", "[LOCKPOLICY_TEST]" ) {
+    REQUIRE( lockPolicyIncrement<CFutexMutex>(4, 20000) == 80000 );
+    REQUIRE( lockPolicyIncrement<CSpinLock>(4, 20000) == 80000 );
+    REQUIRE( lockPolicyIncrement<CNullLock>(1, 20000) == 20000 );
+}
+
+TEST_CASE( "LOCK_POLICY_TRY_LOCK", "[LOCKPOLICY_TEST]" ) {
+    CFutexMutex oFutex;
+    REQUIRE( oFutex.tryLock() );
+    REQUIRE_FALSE( oFutex.tryLock() );
+    oFutex.unlock();
+    REQUIRE( oFutex.tryLock() );
+    oFutex.unlock();
+
+    CSpinLock oSpinLock;
+    REQUIRE( oSpinLock.tryLock() );
+    REQUIRE_FALSE( oSpinLock.tryLock() );
+    oSpinLock.unlock();
+
+    CNullLock oNullLock;
+    REQUIRE( oNullLock.tryLock() );
+}
+
+TEST_CASE( "LOCK_POLICY_CONTAINERS", "[LOCKPOLICY_TEST]" ) {
+    CSafeQueue<int, CFutexMutex> oQueue;
+    oQueue.enqueueBulk(std::vector<int>{1, 2, 3});
+    REQUIRE( oQueue.size() == 3 );
+    REQUIRE( oQueue.dequeue() == 1 );
+    oQueue.clear();
+    REQUIRE( oQueue.isEmpty() );
+
+    CMutexVector<int, CSpinLock> oVector(std::vector<int>{1, 2, 3, 4});
+    REQUIRE( oVector.removeAll([](const int &n) { return n % 2 == 0; }) );
+    REQUIRE( oVector.toStdVector() == std::vector<int>{1, 3} );
+
+    CMutexVector<int, CNullLock> oUnlocked(std::vector<int>{1, 2});
+    REQUIRE( oUnlocked.contains(2) );
+}
+
+TEST_CASE( "LOCK_POLICY_CONTENDED_COUNTER", "[.][LOCKPOLICY_BENCHMARK]" ) {
+    constexpr size_t nOperations = 100000;
+
+    for (const size_t nThreads: {1, 4}) {
+        BENCHMARK("CMutex, " + std::to_string(nThreads) + " threads") {
+            return lockPolicyIncrement<CMutex>(nThreads, nOperations);
+        };
+
+        BENCHMARK("CFutexMutex, " + std::to_string(nThreads) + " threads") {
+            return lockPolicyIncrement<CFutexMutex>(nThreads, nOperations);
+        };
+
+        BENCHMARK("CSpinLock, " + std::to_string(nThreads) + " threads") {
+            return lockPolicyIncrement<CSpinLock>(nThreads, nOperations);
+        };
+    }
+
+    BENCHMARK("CNullLock, 1 thread") {
+        return lockPolicyIncrement<CNullLock>(1, nOperations);
+    };
+}
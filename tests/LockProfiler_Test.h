@@ -0,0 +1,135 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace Devel::Threading;
+
+TEST_CASE( "LOCK_PROFILER_REPORT", "[LOCKPROFILER_TEST]" ) {
+    CLockProfiler *pProfiler = CLockProfiler::instance();
+    pProfiler->reset();
+
+    CFutexMutex oMutex;
+    oMutex.setName("profiled futex");
+    std::vector<std::thread> aoThreads;
+    for (size_t i = 0; i < 4; i++) {
+        aoThreads.emplace_back([&oMutex]() {
+            for (size_t j = 0; j < 1000; j++) {
+                RecursiveLockGuard(oMutex);
+                std::this_thread::yield();
+            }
+            for (size_t j = 0; j < 500; j++) {
+                RecursiveLockGuard(oMutex);
+            }
+        });
+    }
+    for (std::thread &oThread: aoThreads) {
+        oThread.join();
+    }
+
+    const std::vector<CLockReport> aoReports = pProfiler->report();
+    std::ostringstream oStream;
+    pProfiler->dump(oStream, 5);
+
+    if constexpr (CLockProfiler::isEnabled()) {
+        const auto it = std::find_if(aoReports.begin(), aoReports.end(), [](const CLockReport &i_oReport) {
+            return i_oReport.m_stName == "profiled futex";
+        });
+
+        REQUIRE( it != aoReports.end() );
+        REQUIRE( it->m_nAcquisitions == 6000 );
+        REQUIRE( it->m_nContended <= it->m_nAcquisitions );
+
+        uint64_t nHoldSamples = 0;
+        for (const uint64_t nCount: it->m_anHoldHistogram) {
+            nHoldSamples += nCount;
+        }
+        REQUIRE( nHoldSamples == 6000 );
+
+        // Both guards are reported as call sites of the lock
+        REQUIRE( it->m_aoSites.size() == 2 );
+        uint64_t nSiteAcquisitions = 0;
+        for (const CLockSiteReport &oSite: it->m_aoSites) {
+            REQUIRE( oSite.m_stSite.find("LockProfiler_Test.h:") != std::string::npos );
+            REQUIRE( (oSite.m_nAcquisitions == 4000 || oSite.m_nAcquisitions == 2000) );
+            nSiteAcquisitions += oSite.m_nAcquisitions;
+        }
+        REQUIRE( nSiteAcquisitions == 6000 );
+        REQUIRE( oStream.str().find("profiled futex") != std::string::npos );
+        REQUIRE( oStream.str().find("LockProfiler_Test.h:") != std::string::npos );
+    } else {
+        REQUIRE( aoReports.empty() );
+        REQUIRE( oStream.str().find("disabled") != std::string::npos );
+    }
+}
+
+TEST_CASE( "LOCK_PROFILER_PER_LOCK", "[LOCKPROFILER_TEST]" ) {
+    CLockProfiler *pProfiler = CLockProfiler::instance();
+    pProfiler->reset();
+
+    // Two queues share the guards inside SafeQueue.h but are reported as separate locks
+    CSafeQueue<int> oInput;
+    CSafeQueue<int> oOutput;
+    oInput.mutex().setName("input queue");
+    oOutput.mutex().setName("output queue");
+
+    for (int i = 0; i < 100; i++) {
+        oInput.enqueue(i);
+    }
+    for (int i = 0; i < 10; i++) {
+        oOutput.enqueue(i);
+    }
+
+    {
+        // A destroyed lock is still reported under its name
+        CMutex oScoped;
+        oScoped.setName("scoped mutex");
+        RecursiveLockGuard(oScoped);
+    }
+
+    const std::vector<CLockReport> aoReports = pProfiler->report();
+    const auto fnFind = [&aoReports](const std::string &i_stName) {
+        return std::find_if(aoReports.begin(), aoReports.end(), [&i_stName](const CLockReport &i_oReport) {
+            return i_oReport.m_stName == i_stName;
+        });
+    };
+
+    if constexpr (CLockProfiler::isEnabled()) {
+        const auto itInput = fnFind("input queue");
+        const auto itOutput = fnFind("output queue");
+        const auto itScoped = fnFind("scoped mutex");
+
+        REQUIRE( itInput != aoReports.end() );
+        REQUIRE( itOutput != aoReports.end() );
+        REQUIRE( itScoped != aoReports.end() );
+        REQUIRE( itInput->m_nAcquisitions == 100 );
+        REQUIRE( itOutput->m_nAcquisitions == 10 );
+        REQUIRE( itScoped->m_nAcquisitions == 1 );
+        REQUIRE( itInput->m_aoSites.size() == 1 );
+        REQUIRE( itInput->m_aoSites.front().m_stSite.find("SafeQueue.h:") != std::string::npos );
+
+        // Unnamed locks are reported after their first call site
+        CSpinLock oUnnamed;
+        {
+            RecursiveLockGuard(oUnnamed);
+        }
+        const std::vector<CLockReport> aoUnnamed = pProfiler->report();
+        REQUIRE( std::any_of(aoUnnamed.begin(), aoUnnamed.end(), [](const CLockReport &i_oReport) {
+            return i_oReport.m_stName.find("LockProfiler_Test.h:") != std::string::npos &&
+                   i_oReport.m_stName.find('#') != std::string::npos;
+        }) );
+    } else {
+        REQUIRE( fnFind("input queue") == aoReports.end() );
+    }
+}
+
+TEST_CASE( "LOCK_PROFILER_HISTOGRAM_BUCKETS", "[LOCKPROFILER_TEST]" ) {
+    REQUIRE( CLockSite::bucket(0) == 0 );
+    REQUIRE( CLockSite::bucket(1) == 0 );
+    REQUIRE( CLockSite::bucket(1024) == 10 );
+    REQUIRE( CLockSite::bucket(~0ull) == LockHistogramBuckets - 1 );
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Devel::Threading;
+
+TEST_CASE( "MUTEX_VECTOR_BASIC", "[MUTEXVECTOR_TEST]" ) {
+    CMutexVector<int> oVector(std::vector<int>{1, 2, 3, 4, 5, 6});
+
+    REQUIRE( oVector.find([](const int &n) { return n > 3; }) == 4 );
+    REQUIRE( oVector.findIndex([](const int &n) { return n == 6; }) == 5 );
+    REQUIRE( oVector.contains(2) );
+
+    REQUIRE( oVector.removeAll([](const int &n) { return n % 2 == 0; }) );
+    REQUIRE( oVector.toStdVector() == std::vector<int>{1, 3, 5} );
+    REQUIRE( oVector.take([](const int &n) { return n == 3; }) == 3 );
+    REQUIRE( oVector.size() == 2 );
+    REQUIRE_FALSE( oVector.removeAt(2) );
+}
+
+TEST_CASE( "MUTEX_VECTOR_SHARED_MUTEX", "[MUTEXVECTOR_TEST]" ) {
+    CMutexVector<int, CSharedMutex> oVector(std::vector<int>{1, 2, 3, 4, 5, 6});
+
+    // Nested operations must not lock the non-recursive mutex twice
+    REQUIRE( oVector.removeAll([](const int &n) { return n % 2 == 0; }) );
+    REQUIRE( oVector.takeAll([](const int &n) { return n > 1; }) == std::vector<int>{3, 5} );
+    REQUIRE( oVector.remove(1) );
+    REQUIRE( oVector.isEmpty() );
+
+    oVector = std::vector<int>{7, 8, 9};
+    CMutexVector<int, CSharedMutex> oCopy(oVector);
+    oCopy = oCopy;
+    REQUIRE( oCopy.toStdVector() == std::vector<int>{7, 8, 9} );
+
+    CMutexVector<int, CSharedMutex> oMoved(std::move(oCopy));
+    REQUIRE( oMoved.size() == 3 );
+    REQUIRE( oCopy.isEmpty() );
+}
+
+TEST_CASE( "MUTEX_VECTOR_CONCURRENT_READERS", "[MUTEXVECTOR_TEST]" ) {
+    CSharedMutex oMutex;
+    std::atomic<size_t> nInside = 0;
+    std::atomic<size_t> nMaxInside = 0;
+
+    std::vector<std::thread> aoThreads;
+    for (size_t i = 0; i < 4; i++) {
+        aoThreads.emplace_back([&]() {
+            SharedLockGuard(oMutex);
+            const size_t nCurrent = ++nInside;
+            size_t nMax = nMaxInside;
+            while (nCurrent > nMax && !nMaxInside.compare_exchange_weak(nMax, nCurrent)) {}
+
+            Devel::CTimer oTimer(true);
+            while (nMaxInside < 2 && !oTimer.hasExpired(1000)) {
+                std::this_thread::yield();
+            }
+            --nInside;
+        });
+    }
+    for (std::thread &oThread: aoThreads) {
+        oThread.join();
+    }
+
+    REQUIRE( nMaxInside >= 2 );
+}
+
+TEST_CASE( "MUTEX_VECTOR_TEMPLATE_PREDICATES", "[MUTEXVECTOR_TEST]" ) {
+    CMutexVector<int> oVector(std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8});
+
+    REQUIRE( oVector.countIf([](const int &n) { return n > 4; }) == 4 );
+    REQUIRE( oVector.findIf([](const int &n) { return n > 4; }) == 5 );
+    REQUIRE_THROWS_AS( oVector.findIf([](const int &n) { return n > 8; }), std::range_error );
+
+    REQUIRE( oVector.removeIf([](const int &n) { return n % 2 == 0; }) == 4 );
+    REQUIRE( oVector.toStdVector() == std::vector<int>{1, 3, 5, 7} );
+
+    oVector.transformInPlace([](int &n) { n *= 10; });
+    oVector.transformInPlace([](const int &n) { return n + 1; });
+    REQUIRE( oVector.toStdVector() == std::vector<int>{11, 31, 51, 71} );
+
+    int nSum = 0;
+    oVector.forEach([&nSum](const int &n) { nSum += n; });
+    REQUIRE( nSum == 164 );
+
+    REQUIRE( oVector.takeAll([](const int &n) { return n > 40; }) == std::vector<int>{51, 71} );
+    REQUIRE( oVector.toStdVector() == std::vector<int>{11, 31} );
+}
+
+TEST_CASE( "MUTEX_VECTOR_BATCH_PUSH_BACK", "[MUTEXVECTOR_TEST]" ) {
+    CMutexVector<std::string> oVector;
+
+    oVector.push_back(std::vector<std::string>{"a", "b"});
+    const std::array<std::string, 2> astValues = {"c", "d"};
+    oVector.push_back(astValues);
+    oVector.push_back(std::string("e"));
+    REQUIRE( oVector.size() == 5 );
+
+    CMutexVector<std::string> oOther(std::vector<std::string>{"f"});
+    oVector.push_back(oOther);
+    oVector.push_back(std::move(oOther));
+    REQUIRE( oVector.toStdVector() == std::vector<std::string>{"a", "b", "c", "d", "e", "f", "f"} );
+    REQUIRE( oOther.isEmpty() );
+}
+
+template<typename TLock>
+static void mutexVectorReadHeavyMix(CMutexVector<int, TLock> &i_oVector, const size_t i_nThreads) {
+    constexpr size_t nOperations = 20000;
+
+    std::vector<std::thread> aoThreads;
+    for (size_t i = 0; i < i_nThreads; i++) {
+        aoThreads.emplace_back([&i_oVector, i]() {
+            for (size_t j = 0; j < nOperations; j++) {
+                // 95% reads, 5% writes
+                if ((j + i) % 20 == 0) {
+                    i_oVector.push_back(static_cast<int>(j));
+                    i_oVector.removeAt(0);
+                } else {
+                    i_oVector.contains(static_cast<int>(j));
+                }
+            }
+        });
+    }
+    for (std::thread &oThread: aoThreads) {
+        oThread.join();
+    }
+}
+
+TEST_CASE( "MUTEX_VECTOR_READ_HEAVY", "[.][MUTEXVECTOR_BENCHMARK]" ) {
+    std::vector<int> anValues(256);
+    for (size_t i = 0; i < anValues.size(); i++) {
+        anValues[i] = static_cast<int>(i) * 1000;
+    }
+
+    for (const size_t nThreads: {1, 4, 8}) {
+        CMutexVector<int> oRecursive(anValues);
+        BENCHMARK("CMutex, " + std::to_string(nThreads) + " threads") {
+            mutexVectorReadHeavyMix(oRecursive, nThreads);
+        };
+
+        CMutexVector<int, CSharedMutex> oShared(anValues);
+        BENCHMARK("CSharedMutex, " + std::to_string(nThreads) + " threads") {
+            mutexVectorReadHeavyMix(oShared, nThreads);
+        };
+    }
+}
+
+TEST_CASE( "MUTEX_VECTOR_BULK_REMOVE", "[.][MUTEXVECTOR_BENCHMARK]" ) {
+    std::vector<int> anValues(1000000);
+    for (size_t i = 0; i < anValues.size(); i++) {
+        anValues[i] = static_cast<int>(i);
+    }
+
+    BENCHMARK_ADVANCED("removeIf 100k of 1M")(Catch::Benchmark::Chronometer oMeter) {
+        CMutexVector<int> oVector(anValues);
+        oMeter.measure([&oVector]() { return oVector.removeIf([](const int &n) { return n % 10 == 0; }); });
+    };
+
+    BENCHMARK_ADVANCED("push_back range 1M")(Catch::Benchmark::Chronometer oMeter) {
+        CMutexVector<int> oVector;
+        oMeter.measure([&]() { oVector.push_back(anValues); });
+    };
+}
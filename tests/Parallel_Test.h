@@ -0,0 +1,89 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <numeric>
+#include <vector>
+
+using namespace Devel::Threading;
+
+TEST_CASE( "PARALLEL_FOR_VISITS_EVERY_INDEX", "[PARALLEL_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    std::vector<int> anValues(100000, 0);
+    Parallel::parallelFor(oPool, 0, anValues.size(), 0, [&](size_t i) { anValues[i] += static_cast<int>(i % 7); });
+
+    bool fAllVisited = true;
+    for (size_t i = 0; i < anValues.size(); i++) {
+        fAllVisited &= (anValues[i] == static_cast<int>(i % 7));
+    }
+    REQUIRE( fAllVisited );
+}
+
+TEST_CASE( "PARALLEL_REDUCE_SUMS", "[PARALLEL_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    const uint64 nSum = Parallel::parallelReduce(oPool, 0, 1000001, 1000, uint64(0),
+                                                 [](size_t i) { return uint64(i); }, std::plus<uint64>());
+    REQUIRE( nSum == 500000500000ull );
+    REQUIRE( Parallel::parallelReduce(oPool, 5, 5, 0, 7, [](size_t) { return 1; }, std::plus<int>()) == 7 );
+}
+
+TEST_CASE( "PARALLEL_TRANSFORM_AND_SORT", "[PARALLEL_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    std::vector<int> anInput(200000);
+    std::iota(anInput.begin(), anInput.end(), 0);
+    std::vector<int> anOutput(anInput.size());
+
+    Parallel::parallelTransform(oPool, anInput.begin(), anInput.end(), anOutput.begin(), 0,
+                                [](int n) { return (n * 7919) % 200003; });
+    Parallel::parallelSort(oPool, anOutput.begin(), anOutput.end());
+    REQUIRE( std::is_sorted(anOutput.begin(), anOutput.end()) );
+
+    Parallel::parallelSort(oPool, anOutput.begin(), anOutput.end(), std::greater<>());
+    REQUIRE( std::is_sorted(anOutput.begin(), anOutput.end(), std::greater<>()) );
+}
+
+TEST_CASE( "PARALLEL_PROPAGATES_EXCEPTION", "[PARALLEL_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.execute();
+
+    REQUIRE_THROWS_AS( Parallel::parallelFor(oPool, 0, 1000, 1, [](size_t i) {
+        if (i == 500) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error );
+}
+
+TEST_CASE( "PARALLEL_NESTED_IN_POOL_TASK", "[PARALLEL_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.execute();
+
+    auto oFuture = oPool.submit([&oPool]() {
+        return Parallel::parallelReduce(oPool, 0, 10000, 10, 0, [](size_t) { return 1; }, std::plus<int>());
+    });
+    REQUIRE( oFuture.get() == 10000 );
+}
+
+TEST_CASE( "PARALLEL_VECTOR_VARIANTS", "[PARALLEL_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    std::vector<int> anValues(100000);
+    std::iota(anValues.begin(), anValues.end(), 0);
+    anValues[90000] = 12;
+
+    size_t nIndex = 0;
+    REQUIRE( Parallel::isDataInVector(oPool, anValues, 12, &nIndex) );
+    REQUIRE( nIndex == 12 );
+    REQUIRE_FALSE( Parallel::isDataInVector(oPool, anValues, -1) );
+
+    CMutexVector<int> oVector(std::move(anValues));
+    std::vector<int> anEven = Parallel::findAll(oPool, oVector, [](const int &n) { return n % 2 == 0; });
+    REQUIRE( anEven.size() == 50000 );
+    REQUIRE( std::is_sorted(anEven.begin(), anEven.begin() + 45000) );
+}
@@ -0,0 +1,224 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Devel;
+using namespace Devel::Threading;
+
+TEST_CASE( "PIPELINE_ORDERED_STAGES", "[PIPELINE_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    std::vector<int> anResults;
+    auto pPipeline = CPipelineBuilder<std::string>(oPool)
+            .stage([](const std::string &i_stLine) { return std::stoi(i_stLine); },
+                   CPipelineStageOptions().setName("parse").setParallelism(4).setBatchSize(8))
+            .stage([](const int i_nValue) -> std::optional<int> {
+                if (i_nValue % 3 == 0) {
+                    return std::nullopt;
+                }
+                return i_nValue * 2;
+            }, CPipelineStageOptions().setName("filter").setParallelism(3).setBatchSize(5).setCapacity(32))
+            .sink([&anResults](const int i_nValue) { anResults.push_back(i_nValue); },
+                  CPipelineStageOptions().setName("collect"));
+
+    for (int i = 0; i < 1000; i++) {
+        REQUIRE( pPipeline->push(std::to_string(i)) );
+    }
+    pPipeline->close();
+    pPipeline->wait();
+
+    REQUIRE( pPipeline->isFinished() );
+    REQUIRE_FALSE( pPipeline->push("1") );
+
+    // Parallel ordered stages keep the input order
+    std::vector<int> anExpected;
+    for (int i = 0; i < 1000; i++) {
+        if (i % 3 != 0) {
+            anExpected.push_back(i * 2);
+        }
+    }
+    REQUIRE( anResults == anExpected );
+
+    const std::vector<CPipelineStageMetrics> aoMetrics = pPipeline->metrics();
+    REQUIRE( aoMetrics.size() == 3 );
+    REQUIRE( aoMetrics[0].m_stName == "parse" );
+    REQUIRE( aoMetrics[0].m_nProcessed == 1000 );
+    REQUIRE( aoMetrics[0].m_nEmitted == 1000 );
+    REQUIRE( aoMetrics[0].m_nBatches >= 125 );
+    REQUIRE( aoMetrics[1].m_nProcessed == 1000 );
+    REQUIRE( aoMetrics[1].m_nEmitted == anExpected.size() );
+    REQUIRE( aoMetrics[2].m_nProcessed == anExpected.size() );
+    REQUIRE( aoMetrics[2].m_nEmitted == 0 );
+    for (const CPipelineStageMetrics &oStage: aoMetrics) {
+        REQUIRE( oStage.m_nQueueDepth == 0 );
+        REQUIRE( oStage.m_nActiveTasks == 0 );
+        REQUIRE( oStage.throughput() > 0 );
+    }
+}
+
+TEST_CASE( "PIPELINE_BACKPRESSURE", "[PIPELINE_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    // A slow sink stalls the stages before it, at most capacity plus running batches are between push and sink
+    const size_t nCapacity = 8;
+    const size_t nBatchSize = 4;
+    std::atomic<size_t> nPushed = 0;
+    std::atomic<size_t> nConsumed = 0;
+    std::atomic<size_t> nMaxInFlight = 0;
+
+    auto pPipeline = CPipelineBuilder<size_t>(oPool)
+            .stage([](const size_t i_nValue) { return i_nValue + 1; },
+                   CPipelineStageOptions().setParallelism(2).setCapacity(nCapacity).setBatchSize(nBatchSize)
+                           .setOrder(CPipelineStageOptions::EUnordered))
+            .sink([&nConsumed](size_t) {
+                Utils::sleep(1);
+                nConsumed++;
+            }, CPipelineStageOptions().setCapacity(nCapacity).setBatchSize(nBatchSize));
+
+    for (size_t i = 0; i < 200; i++) {
+        pPipeline->push(i);
+        nPushed++;
+        nMaxInFlight = std::max<size_t>(nMaxInFlight, nPushed - nConsumed);
+    }
+    pPipeline->close();
+    pPipeline->wait();
+
+    REQUIRE( nConsumed == 200 );
+    // Two channels, the running batches of the first stage reserve room in the second channel
+    REQUIRE( nMaxInFlight <= 2 * nCapacity + nBatchSize + 1 );
+
+    // tryPush() fails instead of blocking on a full channel
+    std::atomic<bool> fRelease = false;
+    auto pStalled = CPipelineBuilder<int>(oPool)
+            .sink([&fRelease](int) {
+                while (!fRelease) {
+                    std::this_thread::yield();
+                }
+            }, CPipelineStageOptions().setCapacity(2).setBatchSize(1));
+
+    size_t nAccepted = 0;
+    for (int i = 0; i < 10; i++) {
+        int nValue = i;
+        nAccepted += pStalled->tryPush(std::move(nValue)) ? 1 : 0;
+    }
+    REQUIRE( nAccepted <= 3 );
+    fRelease = true;
+    pStalled->close();
+    pStalled->wait();
+    REQUIRE( pStalled->metrics()[0].m_nProcessed == nAccepted );
+}
+
+TEST_CASE( "PIPELINE_PUSH_FROM_WORKER", "[PIPELINE_TEST]" ) {
+    // The only worker pushes, the batches of the sink are queued behind it and can not make room
+    CThreadPool oPool(1);
+    oPool.execute();
+
+    std::atomic<size_t> nConsumed = 0;
+    auto pPipeline = CPipelineBuilder<size_t>(oPool)
+            .sink([&nConsumed](size_t) { nConsumed++; }, CPipelineStageOptions().setCapacity(2).setBatchSize(1));
+
+    auto oAccepted = oPool.submit([&pPipeline]() {
+        size_t nAccepted = 0;
+        while (nAccepted < 100 && pPipeline->push(nAccepted)) {
+            nAccepted++;
+        }
+        return nAccepted;
+    });
+
+    // push() returns false on the full channel instead of blocking the worker
+    const size_t nAccepted = oAccepted.get();
+    REQUIRE( nAccepted > 0 );
+    REQUIRE( nAccepted < 100 );
+
+    // Outside of the pool it blocks until the sink has made room
+    for (size_t i = nAccepted; i < 100; i++) {
+        REQUIRE( pPipeline->push(i) );
+    }
+    pPipeline->close();
+    pPipeline->wait();
+    REQUIRE( nConsumed == 100 );
+}
+
+TEST_CASE( "PIPELINE_UNORDERED_AND_EXCEPTION", "[PIPELINE_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    std::mutex oMutex;
+    size_t nSum = 0;
+    auto pPipeline = CPipelineBuilder<size_t>(oPool)
+            .stage([](const size_t i_nValue) { return i_nValue * i_nValue; },
+                   CPipelineStageOptions().setParallelism(4).setOrder(CPipelineStageOptions::EUnordered))
+            .sink([&oMutex, &nSum](const size_t i_nValue) {
+                std::lock_guard<std::mutex> oLock(oMutex);
+                nSum += i_nValue;
+            }, CPipelineStageOptions().setBatchSize(64));
+
+    for (size_t i = 0; i < 500; i++) {
+        pPipeline->push(i);
+    }
+    pPipeline->close();
+    REQUIRE_NOTHROW( pPipeline->wait() );
+    REQUIRE( nSum == 499 * 500 * 999 / 6 );
+
+    // The first exception of a stage is rethrown by wait(), later items are dropped
+    std::atomic<size_t> nSunk = 0;
+    auto pFailing = CPipelineBuilder<int>(oPool)
+            .stage([](const int i_nValue) {
+                if (i_nValue == 10) {
+                    throw std::runtime_error("bad item");
+                }
+                return i_nValue;
+            }, CPipelineStageOptions().setBatchSize(1).setCapacity(4))
+            .sink([&nSunk](int) { nSunk++; });
+
+    bool fIsAccepted = true;
+    for (int i = 0; i < 10000 && fIsAccepted; i++) {
+        fIsAccepted = pFailing->push(i);
+    }
+    REQUIRE_FALSE( fIsAccepted );
+    REQUIRE( pFailing->hasFailed() );
+    pFailing->close();
+    REQUIRE_THROWS_AS( pFailing->wait(), std::runtime_error );
+    REQUIRE( nSunk <= 10 );
+}
+
+TEST_CASE( "PIPELINE_BATCHING", "[.][PIPELINE_BENCHMARK]" ) {
+    CThreadPool oPool(std::thread::hardware_concurrency());
+    oPool.execute();
+
+    // Cheap stages, the per item hand-off dominates without batching
+    const auto fnRun = [&oPool](const size_t i_nBatchSize) {
+        std::atomic<size_t> nSum = 0;
+        auto pPipeline = CPipelineBuilder<size_t>(oPool)
+                .stage([](const size_t i_nValue) { return i_nValue ^ 0x5bd1e995; },
+                       CPipelineStageOptions().setParallelism(2).setBatchSize(i_nBatchSize))
+                .sink([&nSum](const size_t i_nValue) { nSum.fetch_add(i_nValue, std::memory_order_relaxed); },
+                      CPipelineStageOptions().setBatchSize(i_nBatchSize));
+
+        for (size_t i = 0; i < 20000; i++) {
+            pPipeline->push(i);
+        }
+        pPipeline->close();
+        pPipeline->wait();
+        return nSum.load();
+    };
+
+    BENCHMARK("batch size 1") {
+        return fnRun(1);
+    };
+
+    BENCHMARK("batch size 64") {
+        return fnRun(64);
+    };
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <vector>
+
+using namespace Devel::Threading;
+
+template<typename Q>
+concept HasFront = requires(Q &i_oQueue) { i_oQueue.front(); };
+
+TEST_CASE( "SAFE_QUEUE_TRY_DEQUEUE", "[SAFEQUEUE_TEST]" ) {
+    CSafeQueue<std::unique_ptr<int>> oQueue;
+    std::unique_ptr<int> pValue;
+
+    REQUIRE_FALSE( oQueue.tryDequeue(pValue) );
+
+    oQueue.enqueue(std::make_unique<int>(1));
+    oQueue.enqueue(std::make_unique<int>(2));
+
+    REQUIRE( oQueue.tryDequeue(pValue) );
+    REQUIRE( *pValue == 1 );
+    REQUIRE( oQueue.tryDequeue(pValue) );
+    REQUIRE( *pValue == 2 );
+    REQUIRE_FALSE( oQueue.tryDequeue(pValue) );
+    REQUIRE( oQueue.isEmpty() );
+
+    // front() would leave a moved-from element behind, move-only elements are only taken by dequeueing
+    STATIC_REQUIRE_FALSE( HasFront<CSafeQueue<std::unique_ptr<int>>> );
+
+    CSafeQueue<int> oCopyable;
+    oCopyable.enqueue(3);
+    REQUIRE( oCopyable.front() == 3 );
+    REQUIRE( oCopyable.dequeue() == 3 );
+}
+
+TEST_CASE( "SAFE_QUEUE_BULK", "[SAFEQUEUE_TEST]" ) {
+    CSafeQueue<int> oQueue;
+    const std::vector<int> anValues = {1, 2, 3, 4, 5};
+
+    oQueue.enqueueBulk(anValues);
+    REQUIRE( oQueue.size() == 5 );
+
+    std::vector<int> anOut;
+    REQUIRE( oQueue.dequeueBulk(std::back_inserter(anOut), 3) == 3 );
+    REQUIRE( anOut == std::vector<int>{1, 2, 3} );
+
+    REQUIRE( oQueue.dequeueBulk(std::back_inserter(anOut), 10) == 2 );
+    REQUIRE( anOut == anValues );
+    REQUIRE( oQueue.dequeueBulk(std::back_inserter(anOut), 10) == 0 );
+}
+
+TEST_CASE( "SAFE_QUEUE_SWAP_ALL_AND_CLEAR", "[SAFEQUEUE_TEST]" ) {
+    CSafeQueue<int> oQueue;
+    oQueue.enqueueBulk(std::vector<int>{1, 2, 3});
+
+    std::queue<int> aDrained;
+    oQueue.swapAll(aDrained);
+    REQUIRE( aDrained.size() == 3 );
+    REQUIRE( aDrained.front() == 1 );
+    REQUIRE( oQueue.isEmpty() );
+
+    oQueue.enqueue(4);
+    oQueue.clear();
+    REQUIRE( oQueue.isEmpty() );
+    REQUIRE_THROWS_AS( oQueue.dequeue(), std::range_error );
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace Devel;
+using namespace Devel::Threading;
+
+TEST_CASE( "SCRATCH_ARENA_ALLOCATE_AND_RESET", "[SCRATCHARENA_TEST]" ) {
+    CScratchArena oArena;
+    REQUIRE( oArena.capacity() == 0 );
+
+    int *pValue = oArena.make<int>(42);
+    REQUIRE( *pValue == 42 );
+    REQUIRE( oArena.capacity() == CScratchArena::ChunkSize );
+
+    // Alignment is honoured, also beyond the default new alignment
+    void *pAligned = oArena.allocate(10, 256);
+    REQUIRE( reinterpret_cast<uintptr_t>(pAligned) % 256 == 0 );
+
+    // Requests larger than a chunk get a chunk of their own
+    void *pLarge = oArena.allocate(CScratchArena::ChunkSize * 2, 64);
+    REQUIRE( reinterpret_cast<uintptr_t>(pLarge) % 64 == 0 );
+    const size_t nCapacity = oArena.capacity();
+    REQUIRE( nCapacity >= CScratchArena::ChunkSize * 3 );
+
+    // After a reset the same memory is handed out again without growing
+    oArena.reset();
+    REQUIRE( oArena.usedSize() == 0 );
+    REQUIRE( oArena.make<int>(7) == pValue );
+    REQUIRE( oArena.allocate(10, 256) == pAligned );
+    REQUIRE( oArena.allocate(CScratchArena::ChunkSize * 2, 64) == pLarge );
+    REQUIRE( oArena.capacity() == nCapacity );
+
+    {
+        std::pmr::vector<std::pmr::string> astNames(&oArena);
+        for (size_t i = 0; i < 1000; i++) {
+            astNames.emplace_back("a string which does not fit the small string buffer " + std::to_string(i));
+        }
+        REQUIRE( astNames[999].ends_with("999") );
+        REQUIRE( oArena.usedSize() > 0 );
+    }
+
+    oArena.release();
+    REQUIRE( oArena.capacity() == 0 );
+}
+
+TEST_CASE( "SCRATCH_ARENA_VS_HEAP", "[.][SCRATCHARENA_BENCHMARK]" ) {
+    CThreadPool oPool(std::thread::hardware_concurrency());
+    oPool.execute();
+    constexpr size_t nTasks = 10000;
+    std::atomic<size_t> nBytes = 0;
+
+    BENCHMARK("tasks with heap temporaries") {
+        for (size_t i = 0; i < nTasks; i++) {
+            oPool.addTask([&nBytes, i]() {
+                IO::CWriteStream oStream;
+                std::vector<std::string> astParts;
+                for (size_t j = 0; j < 16; j++) {
+                    astParts.emplace_back("part of a larger message " + std::to_string(i + j));
+                    oStream.push(astParts.back());
+                }
+                nBytes.fetch_add(oStream.size(), std::memory_order_relaxed);
+            });
+        }
+        oPool.waitIdle();
+        return nBytes.load();
+    };
+
+    BENCHMARK("tasks with worker scratch buffers") {
+        for (size_t i = 0; i < nTasks; i++) {
+            oPool.addTask([&nBytes, i]() {
+                CThreadPoolWorker *pWorker = CThreadPool::currentWorker();
+                IO::CWriteStream &oStream = pWorker->scratchStream();
+                std::pmr::vector<std::pmr::string> astParts(&pWorker->scratchArena());
+                for (size_t j = 0; j < 16; j++) {
+                    astParts.emplace_back("part of a larger message ");
+                    astParts.back() += std::to_string(i + j);
+                    oStream.push(astParts.back().c_str(), astParts.back().size() + 1);
+                }
+                nBytes.fetch_add(oStream.size(), std::memory_order_relaxed);
+            });
+        }
+        oPool.waitIdle();
+        return nBytes.load();
+    };
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Devel::Threading;
+
+TEST_CASE( "SNAPSHOT_VECTOR_BASIC", "[SNAPSHOTVECTOR_TEST]" ) {
+    CSnapshotVector<int> oVector(std::vector<int>{1, 2, 3});
+    CSnapshotVector<int>::Snapshot pOld = oVector.snapshot();
+
+    oVector.push_back(4);
+    oVector.push_back(std::vector<int>{5, 6});
+    REQUIRE( oVector.size() == 6 );
+
+    // A snapshot never changes once taken
+    REQUIRE( *pOld == std::vector<int>{1, 2, 3} );
+
+    REQUIRE( oVector.removeAll([](const int &n) { return n % 2 == 0; }) );
+    REQUIRE( oVector.toStdVector() == std::vector<int>{1, 3, 5} );
+    REQUIRE( oVector.find([](const int &n) { return n > 1; }) == 3 );
+    REQUIRE( oVector.findAll([](const int &n) { return n > 1; }) == std::vector<int>{3, 5} );
+    REQUIRE( oVector.contains(5) );
+    REQUIRE( oVector.at(0) == 1 );
+    REQUIRE_THROWS( oVector.at(3) );
+
+    REQUIRE( oVector.removeAt(0) );
+    REQUIRE_FALSE( oVector.removeAt(5) );
+
+    oVector.clear();
+    REQUIRE( oVector.isEmpty() );
+
+    CMutexVector<int> oMutexVector(std::vector<int>{7, 8});
+    CSnapshotVector<int> oFromMutexVector(oMutexVector);
+    REQUIRE( oFromMutexVector.size() == 2 );
+}
+
+TEST_CASE( "SNAPSHOT_VECTOR_CONCURRENT_READERS", "[SNAPSHOTVECTOR_TEST]" ) {
+    CSnapshotVector<int> oVector;
+    std::atomic<bool> fIsRunning = true;
+    std::atomic<size_t> nInconsistent = 0;
+
+    std::vector<std::thread> aoReaders;
+    for (size_t i = 0; i < 3; i++) {
+        aoReaders.emplace_back([&]() {
+            while (fIsRunning) {
+                // Every published version is 0, 1, ..., n - 1
+                const CSnapshotVector<int>::Snapshot pVersion = oVector.snapshot();
+                for (size_t j = 0; j < pVersion->size(); j++) {
+                    if ((*pVersion)[j] != static_cast<int>(j)) {
+                        nInconsistent++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 500; i++) {
+        oVector.push_back(i);
+    }
+    fIsRunning = false;
+
+    for (std::thread &oThread: aoReaders) {
+        oThread.join();
+    }
+
+    REQUIRE( nInconsistent == 0 );
+    REQUIRE( oVector.size() == 500 );
+}
+
+TEST_CASE( "SNAPSHOT_VECTOR_VS_MUTEX_VECTOR", "[.][SNAPSHOTVECTOR_BENCHMARK]" ) {
+    std::vector<int> anValues(1000);
+    for (size_t i = 0; i < anValues.size(); i++) {
+        anValues[i] = static_cast<int>(i);
+    }
+
+    CMutexVector<int> oMutexVector(anValues);
+    CSnapshotVector<int> oSnapshotVector(anValues);
+    std::atomic<int64_t> nSink = 0;
+
+    BENCHMARK("CMutexVector locked iteration, 4 threads") {
+        std::vector<std::thread> aoThreads;
+        for (size_t i = 0; i < 4; i++) {
+            aoThreads.emplace_back([&]() {
+                for (size_t j = 0; j < 1000; j++) {
+                    MutexVectorLockGuard(oMutexVector);
+                    int64_t nSum = 0;
+                    for (const int &n: oMutexVector) {
+                        nSum += n;
+                    }
+                    nSink += nSum;
+                }
+            });
+        }
+        for (std::thread &oThread: aoThreads) {
+            oThread.join();
+        }
+    };
+
+    BENCHMARK("CSnapshotVector snapshot iteration, 4 threads") {
+        std::vector<std::thread> aoThreads;
+        for (size_t i = 0; i < 4; i++) {
+            aoThreads.emplace_back([&]() {
+                for (size_t j = 0; j < 1000; j++) {
+                    int64_t nSum = 0;
+                    for (const int &n: *oSnapshotVector.snapshot()) {
+                        nSum += n;
+                    }
+                    nSink += nSum;
+                }
+            });
+        }
+        for (std::thread &oThread: aoThreads) {
+            oThread.join();
+        }
+    };
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Devel::Threading;
+
+TEST_CASE( "SPSC_QUEUE_PUSH_POP", "[SPSCQUEUE_TEST]" ) {
+    CSpscQueue<std::string> oQueue(3);
+    REQUIRE( oQueue.capacity() == 4 );
+    REQUIRE( oQueue.isEmpty() );
+
+    REQUIRE( oQueue.tryPush(std::string("a")) );
+    REQUIRE( oQueue.tryEmplace(3, 'b') );
+    REQUIRE( oQueue.size() == 2 );
+
+    std::string *pFront = oQueue.peek();
+    REQUIRE( pFront != nullptr );
+    REQUIRE( *pFront == "a" );
+    oQueue.commit();
+
+    std::string sValue;
+    REQUIRE( oQueue.tryPop(sValue) );
+    REQUIRE( sValue == "bbb" );
+    REQUIRE_FALSE( oQueue.tryPop(sValue) );
+    REQUIRE( oQueue.peek() == nullptr );
+}
+
+TEST_CASE( "SPSC_QUEUE_BULK", "[SPSCQUEUE_TEST]" ) {
+    CSpscQueue<int> oQueue(8);
+    std::vector<int> anInput = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    REQUIRE( oQueue.pushBulk(anInput.begin(), anInput.size()) == 8 );
+    REQUIRE_FALSE( oQueue.tryPush(11) );
+
+    std::vector<int> anOutput;
+    REQUIRE( oQueue.popBulk(std::back_inserter(anOutput), 5) == 5 );
+    REQUIRE( oQueue.pushBulk(anInput.begin() + 8, 2) == 2 );
+    REQUIRE( oQueue.popBulk(std::back_inserter(anOutput), 100) == 5 );
+    REQUIRE( anOutput == anInput );
+}
+
+TEST_CASE( "SPSC_QUEUE_TWO_THREADS", "[SPSCQUEUE_TEST]" ) {
+    CSpscQueue<size_t> oQueue(64);
+    constexpr size_t nCount = 100000;
+    size_t nSum = 0;
+
+    std::thread oConsumer([&oQueue, &nSum]() {
+        size_t nValue;
+        for (size_t i = 0; i < nCount;) {
+            if (oQueue.tryPop(nValue)) {
+                nSum += nValue;
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (size_t i = 1; i <= nCount;) {
+        if (oQueue.tryPush(i)) {
+            i++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    oConsumer.join();
+    REQUIRE( nSum == nCount * (nCount + 1) / 2 );
+}
+
+TEST_CASE( "SPSC_QUEUE_THROUGHPUT_AND_LATENCY", "[.][SPSCQUEUE_BENCHMARK]" ) {
+    constexpr size_t nCount = 1000000;
+
+    BENCHMARK("CSpscQueue throughput, 1M elements") {
+        CSpscQueue<size_t> oQueue(4096);
+        std::thread oConsumer([&oQueue]() {
+            size_t anBatch[64];
+            for (size_t i = 0; i < nCount;) {
+                i += oQueue.popBulk(anBatch, 64);
+            }
+        });
+        for (size_t i = 0; i < nCount;) {
+            i += oQueue.tryPush(i) ? 1 : 0;
+        }
+        oConsumer.join();
+    };
+
+    BENCHMARK("CSafeQueue throughput, 1M elements") {
+        CSafeQueue<size_t> oQueue;
+        std::thread oConsumer([&oQueue]() {
+            for (size_t i = 0; i < nCount;) {
+                try {
+                    oQueue.dequeue();
+                    i++;
+                } catch (const std::range_error &) {}
+            }
+        });
+        for (size_t i = 0; i < nCount; i++) {
+            oQueue.enqueue(i);
+        }
+        oConsumer.join();
+    };
+
+    BENCHMARK("CSpscQueue round trip latency, 10k ping-pongs") {
+        CSpscQueue<size_t> oPing(16), oPong(16);
+        std::thread oEcho([&]() {
+            size_t nValue;
+            for (size_t i = 0; i < 10000; i++) {
+                while (!oPing.tryPop(nValue));
+                while (!oPong.tryPush(nValue));
+            }
+        });
+        size_t nValue;
+        for (size_t i = 0; i < 10000; i++) {
+            while (!oPing.tryPush(i));
+            while (!oPong.tryPop(nValue));
+        }
+        oEcho.join();
+    };
+}
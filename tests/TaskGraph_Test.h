@@ -0,0 +1,171 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Devel;
+using namespace Devel::Threading;
+
+TEST_CASE( "TASK_GRAPH_RUNS_IN_DEPENDENCY_ORDER", "[TASKGRAPH_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    std::atomic<size_t> nStep = 0;
+    std::atomic<size_t> nA = 0, nB = 0, nC = 0, nD = 0;
+
+    CTaskGraph oGraph;
+    CGraphTask oA = oGraph.emplace([&]() { nA = ++nStep; });
+    CGraphTask oB = oGraph.emplace([&]() { nB = ++nStep; });
+    CGraphTask oC = oGraph.emplace([&]() { nC = ++nStep; });
+    CGraphTask oD = oGraph.emplace([&]() { nD = ++nStep; });
+
+    oA.precede(oB, oC);
+    oD.succeed(oB, oC);
+    REQUIRE( oGraph.size() == 4 );
+    REQUIRE( oA.successorCount() == 2 );
+    REQUIRE( oD.dependencyCount() == 2 );
+
+    // The same graph runs again without rebuilding it
+    for (size_t i = 0; i < 100; i++) {
+        nStep = 0;
+        oGraph.run(oPool);
+        REQUIRE( nStep == 4 );
+        REQUIRE( nA == 1 );
+        REQUIRE( nB > nA );
+        REQUIRE( nC > nA );
+        REQUIRE( nD == 4 );
+    }
+    REQUIRE_FALSE( oGraph.isRunning() );
+
+    CTaskGraph oEmpty;
+    oEmpty.run(oPool);
+    REQUIRE( oEmpty.empty() );
+}
+
+TEST_CASE( "TASK_GRAPH_WIDE_AND_DEEP", "[TASKGRAPH_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    // Layers of nodes where every node depends on two nodes of the layer above
+    constexpr size_t nWidth = 64;
+    constexpr size_t nDepth = 32;
+    std::vector<std::atomic<size_t>> anValues(nWidth * nDepth);
+    std::vector<CGraphTask> aoTasks;
+
+    CTaskGraph oGraph;
+    for (size_t nLayer = 0; nLayer < nDepth; nLayer++) {
+        for (size_t i = 0; i < nWidth; i++) {
+            const size_t nIndex = nLayer * nWidth + i;
+            aoTasks.push_back(oGraph.emplace([&anValues, nIndex, nLayer, i]() {
+                size_t nValue = 1;
+                if (nLayer > 0) {
+                    nValue = anValues[nIndex - nWidth].load() +
+                             anValues[(nLayer - 1) * nWidth + (i + 1) % nWidth].load();
+                }
+                anValues[nIndex] = nValue;
+            }));
+
+            if (nLayer > 0) {
+                aoTasks[nIndex].succeed(aoTasks[nIndex - nWidth], aoTasks[(nLayer - 1) * nWidth + (i + 1) % nWidth]);
+            }
+        }
+    }
+
+    for (size_t nRun = 0; nRun < 5; nRun++) {
+        for (std::atomic<size_t> &nValue: anValues) {
+            nValue = 0;
+        }
+        oGraph.run(oPool);
+
+        // Every node of a layer sums up to 2^layer
+        for (size_t i = 0; i < nWidth; i++) {
+            REQUIRE( anValues[(nDepth - 1) * nWidth + i] == (size_t(1) << (nDepth - 1)) );
+        }
+    }
+}
+
+TEST_CASE( "TASK_GRAPH_EXCEPTIONS_AND_CYCLES", "[TASKGRAPH_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.execute();
+
+    std::atomic<size_t> nRuns = 0;
+    CTaskGraph oGraph;
+    CGraphTask oFirst = oGraph.emplace([&]() { nRuns++; });
+    CGraphTask oThrows = oGraph.emplace([]() { throw std::runtime_error("failed"); });
+    CGraphTask oSkipped = oGraph.emplace([&]() { nRuns++; });
+    oFirst.precede(oThrows);
+    oThrows.precede(oSkipped);
+
+    REQUIRE_THROWS_AS( oGraph.run(oPool), std::runtime_error );
+    REQUIRE( nRuns == 1 );
+    REQUIRE_FALSE( oGraph.isRunning() );
+
+    // A failed run does not affect the next one
+    REQUIRE_THROWS_AS( oGraph.run(oPool), std::runtime_error );
+    REQUIRE( nRuns == 2 );
+
+    oSkipped.precede(oFirst);
+    REQUIRE_THROWS_AS( oGraph.run(oPool), std::logic_error );
+    REQUIRE( nRuns == 2 );
+
+    oGraph.clear();
+    REQUIRE( oGraph.empty() );
+    std::atomic<bool> fRelease = false;
+    oGraph.emplace([&]() {
+        while (!fRelease);
+        nRuns++;
+    });
+    oGraph.dispatch(oPool);
+    REQUIRE( oGraph.isRunning() );
+    REQUIRE_THROWS_AS( oGraph.dispatch(oPool), std::logic_error );
+    fRelease = true;
+    oGraph.wait();
+    REQUIRE( nRuns == 3 );
+}
+
+TEST_CASE( "TASK_GRAPH_REUSE", "[.][TASKGRAPH_BENCHMARK]" ) {
+    CThreadPool oPool(std::thread::hardware_concurrency());
+    oPool.execute();
+
+    // A fork-join chain of 1000 stages with 8 parallel nodes each
+    constexpr size_t nStages = 1000;
+    constexpr size_t nFanOut = 8;
+    std::atomic<size_t> nCounter = 0;
+
+    CTaskGraph oGraph;
+    CGraphTask oJoin = oGraph.emplace([]() {});
+    for (size_t nStage = 0; nStage < nStages; nStage++) {
+        CGraphTask oNextJoin = oGraph.emplace([]() {});
+        for (size_t i = 0; i < nFanOut; i++) {
+            CGraphTask oTask = oGraph.emplace([&nCounter]() { nCounter.fetch_add(1, std::memory_order_relaxed); });
+            oJoin.precede(oTask);
+            oTask.precede(oNextJoin);
+        }
+        oJoin = oNextJoin;
+    }
+
+    BENCHMARK("run a reused graph of 9000 nodes") {
+        oGraph.run(oPool);
+        return nCounter.load();
+    };
+
+    BENCHMARK("build and run the same graph") {
+        CTaskGraph oFresh;
+        CGraphTask oFreshJoin = oFresh.emplace([]() {});
+        for (size_t nStage = 0; nStage < nStages; nStage++) {
+            CGraphTask oNextJoin = oFresh.emplace([]() {});
+            for (size_t i = 0; i < nFanOut; i++) {
+                CGraphTask oTask = oFresh.emplace([&nCounter]() { nCounter.fetch_add(1, std::memory_order_relaxed); });
+                oFreshJoin.precede(oTask);
+                oTask.precede(oNextJoin);
+            }
+            oFreshJoin = oNextJoin;
+        }
+        oFresh.run(oPool);
+        return nCounter.load();
+    };
+}
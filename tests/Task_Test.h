@@ -0,0 +1,242 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Devel;
+using namespace Devel::Threading;
+
+static CTask<int> taskAnswer() {
+    co_return 42;
+}
+
+static CTask<int> taskOnPool(CThreadPool &i_oPool, const int i_nValue, std::thread::id &i_oOutThread) {
+    co_await i_oPool.schedule();
+    i_oOutThread = std::this_thread::get_id();
+    co_return i_nValue * 2;
+}
+
+static CTask<std::string> taskChain(CThreadPool &i_oPool) {
+    std::thread::id oThread;
+    const int nFirst = co_await taskAnswer();
+    const int nSecond = co_await taskOnPool(i_oPool, nFirst, oThread);
+    co_return std::to_string(nSecond);
+}
+
+static CTask<void> taskThrows(CThreadPool &i_oPool) {
+    co_await i_oPool.schedule();
+    throw std::runtime_error("failed");
+}
+
+TEST_CASE( "TASK_AWAIT_AND_SCHEDULE", "[TASK_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.execute();
+
+    REQUIRE( syncWait(taskAnswer()) == 42 );
+    REQUIRE( syncWait(taskChain(oPool)) == "84" );
+
+    std::thread::id oThread;
+    REQUIRE( syncWait(taskOnPool(oPool, 1, oThread)) == 2 );
+    REQUIRE( oThread != std::this_thread::get_id() );
+
+    REQUIRE_THROWS_AS( syncWait(taskThrows(oPool)), std::runtime_error );
+
+    CTask<int> oTask = taskAnswer();
+    REQUIRE( oTask.isValid() );
+    REQUIRE_FALSE( oTask.isReady() );
+}
+
+static CTask<int> taskSleep(CThreadPool &i_oPool, CTimerWheel &i_oTimers, const int i_nMilliseconds) {
+    co_await i_oPool.schedule();
+    co_await i_oTimers.sleepFor(std::chrono::milliseconds(i_nMilliseconds));
+    co_return i_nMilliseconds;
+}
+
+static CTask<int> taskSleepInOrder(CThreadPool &i_oPool, CTimerWheel &i_oTimers, const int i_nMilliseconds,
+                                   std::mutex &i_oMutex, std::vector<int> &i_anFinished) {
+    const int nMilliseconds = co_await taskSleep(i_oPool, i_oTimers, i_nMilliseconds);
+    {
+        std::lock_guard<std::mutex> oLock(i_oMutex);
+        i_anFinished.push_back(nMilliseconds);
+    }
+    co_return nMilliseconds;
+}
+
+static CTask<int> taskSleepCounted(CThreadPool &i_oPool, CTimerWheel &i_oTimers, const int i_nMilliseconds,
+                                   std::atomic<size_t> &i_nCompleted, CLatch &i_oDone) {
+    const int nMilliseconds = co_await taskSleep(i_oPool, i_oTimers, i_nMilliseconds);
+    i_nCompleted++;
+    i_oDone.countDown();
+    co_return nMilliseconds;
+}
+
+TEST_CASE( "TASK_SLEEP_ON_TIMER_WHEEL", "[TASK_TEST]" ) {
+    CThreadPool oPool(1);
+    CTimerWheel oTimers(oPool);
+    oPool.execute();
+    oTimers.execute();
+
+    const auto oStart = std::chrono::steady_clock::now();
+    REQUIRE( syncWait(taskSleep(oPool, oTimers, 20)) == 20 );
+    REQUIRE( std::chrono::steady_clock::now() - oStart >= std::chrono::milliseconds(20) );
+
+    // Sleeping coroutines do not block the single worker, so the shorter sleeps started later finish first
+    std::mutex oMutex;
+    std::vector<int> anFinished;
+    std::vector<CTask<int>> aoTasks;
+    for (int i = 0; i < 10; i++) {
+        aoTasks.push_back(taskSleepInOrder(oPool, oTimers, 20 * (10 - i), oMutex, anFinished));
+    }
+
+    REQUIRE( syncWait(whenAll(std::move(aoTasks))).size() == 10 );
+    REQUIRE( anFinished == std::vector<int>({20, 40, 60, 80, 100, 120, 140, 160, 180, 200}) );
+}
+
+static CTask<void> taskCount(CThreadPool &i_oPool, std::atomic<size_t> &i_nCounter) {
+    co_await i_oPool.schedule();
+    i_nCounter++;
+}
+
+TEST_CASE( "TASK_WHEN_ALL", "[TASK_TEST]" ) {
+    CThreadPool oPool(4);
+    oPool.execute();
+
+    std::thread::id oFirst;
+    std::thread::id oSecond;
+    const std::tuple<int, int, int> oResults = syncWait(whenAll(taskOnPool(oPool, 1, oFirst),
+                                                                taskOnPool(oPool, 2, oSecond), taskAnswer()));
+    REQUIRE( oResults == std::tuple<int, int, int>(2, 4, 42) );
+
+    std::atomic<size_t> nCounter = 0;
+    std::vector<CTask<void>> aoTasks;
+    for (size_t i = 0; i < 100; i++) {
+        aoTasks.push_back(taskCount(oPool, nCounter));
+    }
+    syncWait(whenAll(std::move(aoTasks)));
+    REQUIRE( nCounter == 100 );
+
+    std::vector<CTask<void>> aoFailing;
+    aoFailing.push_back(taskCount(oPool, nCounter));
+    aoFailing.push_back(taskThrows(oPool));
+    REQUIRE_THROWS_AS( syncWait(whenAll(std::move(aoFailing))), std::runtime_error );
+    REQUIRE( nCounter == 101 );
+
+    REQUIRE( syncWait(whenAll(std::vector<CTask<int>>())).empty() );
+}
+
+TEST_CASE( "TASK_WHEN_ANY", "[TASK_TEST]" ) {
+    CThreadPool oPool(2);
+    CTimerWheel oTimers(oPool);
+    oPool.execute();
+    oTimers.execute();
+
+    std::atomic<size_t> nCompleted = 0;
+    CLatch oDone(3);
+    std::vector<CTask<int>> aoTasks;
+    aoTasks.push_back(taskSleepCounted(oPool, oTimers, 200, nCompleted, oDone));
+    aoTasks.push_back(taskSleepCounted(oPool, oTimers, 5, nCompleted, oDone));
+    aoTasks.push_back(taskSleepCounted(oPool, oTimers, 100, nCompleted, oDone));
+
+    const std::pair<size_t, int> oFirst = syncWait(whenAny(std::move(aoTasks)));
+    REQUIRE( oFirst.first == 1 );
+    REQUIRE( oFirst.second == 5 );
+
+    // The slower tasks still complete, their frames are released by the pool task resuming them
+    oDone.wait();
+    oPool.waitIdle();
+    REQUIRE( nCompleted == 3 );
+
+    // No task could ever complete, so whenAny() refuses to wait
+    REQUIRE_THROWS_AS( syncWait(whenAny(std::vector<CTask<int>>())), std::invalid_argument );
+}
+
+static CTask<void> taskSleepLong(CTimerWheel &i_oTimers, std::shared_ptr<int> i_pAlive,
+                                 std::atomic<size_t> &i_nCancelled) {
+    try {
+        co_await i_oTimers.sleepFor(std::chrono::hours(1));
+    } catch (const std::runtime_error &) {
+        i_nCancelled++;
+        throw;
+    }
+}
+
+TEST_CASE( "TASK_SLEEP_DROPPED_WITH_WHEEL", "[TASK_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.execute();
+    auto pTimers = std::make_unique<CTimerWheel>(oPool);
+    pTimers->execute();
+
+    // Every frame holds a reference, the count drops back once the frames are released
+    auto pAlive = std::make_shared<int>(0);
+    std::atomic<size_t> nCancelled = 0;
+    std::atomic<bool> fHasThrown = false;
+    std::thread oWaiter([&pTimers, &pAlive, &nCancelled, &fHasThrown]() {
+        std::vector<CTask<void>> aoTasks;
+        for (size_t i = 0; i < 3; i++) {
+            aoTasks.push_back(taskSleepLong(*pTimers, pAlive, nCancelled));
+        }
+
+        try {
+            syncWait(whenAll(std::move(aoTasks)));
+        } catch (const std::runtime_error &) {
+            fHasThrown = true;
+        }
+    });
+    while (pTimers->pendingCount() != 3) {
+        std::this_thread::yield();
+    }
+
+    // The wheel goes away before the sleeps end, the coroutines unwind instead of leaking their frames
+    pTimers.reset();
+    oWaiter.join();
+    REQUIRE( fHasThrown );
+    REQUIRE( nCancelled == 3 );
+    REQUIRE( pAlive.use_count() == 1 );
+}
+
+static CTask<int> taskLeaf(const int i_nValue) {
+    co_return i_nValue;
+}
+
+static CTask<int64_t> taskSum(const int i_nCount) {
+    int64_t nSum = 0;
+    for (int i = 0; i < i_nCount; i++) {
+        nSum += co_await taskLeaf(i);
+    }
+    co_return nSum;
+}
+
+TEST_CASE( "TASK_VS_SUBMIT", "[.][TASK_BENCHMARK]" ) {
+    CThreadPool oPool(2);
+    oPool.execute();
+
+    BENCHMARK("10000 awaited coroutines") {
+        return syncWait(taskSum(10000));
+    };
+
+    BENCHMARK("10000 pool round trips with co_await schedule()") {
+        std::thread::id oThread;
+        int64_t nSum = 0;
+        for (int i = 0; i < 10000; i++) {
+            nSum += syncWait(taskOnPool(oPool, i, oThread));
+        }
+        return nSum;
+    };
+
+    BENCHMARK("10000 pool round trips with submit()") {
+        int64_t nSum = 0;
+        for (int i = 0; i < 10000; i++) {
+            nSum += oPool.submit([i]() { return i * 2; }).get();
+        }
+        return nSum;
+    };
+}
@@ -0,0 +1,866 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Devel;
+using namespace Devel::Threading;
+
+TEST_CASE( "EXECUTE_AND_STOP", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2);
+    REQUIRE( oPool.execute() == CThreadPool::ESuccess );
+    REQUIRE( oPool.execute() == CThreadPool::EAlreadyExecuted );
+    REQUIRE( oPool.isExecuted() );
+
+    oPool.stop();
+    REQUIRE( oPool.isExecuted() == false );
+}
+
+TEST_CASE( "RUNS_ALL_TASKS", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(4);
+    std::atomic<size_t> nCounter = 0;
+    oPool.execute();
+
+    for (size_t i = 0; i < 1000; i++) {
+        oPool.addTask([&nCounter]() { nCounter++; });
+    }
+
+    CTimer oTimer(true);
+    while (nCounter != 1000 && !oTimer.hasExpired(5000));
+    REQUIRE( nCounter == 1000 );
+}
+
+TEST_CASE( "IDLE_WORKER_WAKES_UP_ON_TASK", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    std::promise<void> oDone;
+    oPool.execute();
+    Utils::sleep(20);
+
+    // The latency is measured by IDLE_WORKER_WAKEUP_LATENCY, only the wakeup itself is required here
+    oPool.addTask([&oDone]() { oDone.set_value(); });
+    REQUIRE( oDone.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready );
+}
+
+TEST_CASE( "SPIN_BEFORE_PARK", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2);
+    std::atomic<size_t> nCounter = 0;
+    oPool.setSpinCount(1000);
+    REQUIRE( oPool.spinCount() == 1000 );
+    oPool.execute();
+
+    for (size_t i = 0; i < 100; i++) {
+        oPool.addTask([&nCounter]() { nCounter++; });
+    }
+
+    CTimer oTimer(true);
+    while (nCounter != 100 && !oTimer.hasExpired(5000));
+    REQUIRE( nCounter == 100 );
+}
+
+TEST_CASE( "WORK_STEALING_RUNS_NESTED_TASKS", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(4, CThreadPool::EWorkStealing);
+    std::atomic<size_t> nCounter = 0;
+    REQUIRE( oPool.mode() == CThreadPool::EWorkStealing );
+    oPool.execute();
+
+    for (size_t i = 0; i < 10; i++) {
+        oPool.addTask([&oPool, &nCounter]() {
+            for (size_t j = 0; j < 100; j++) {
+                oPool.addTask([&nCounter]() { nCounter++; });
+            }
+        });
+    }
+
+    CTimer oTimer(true);
+    while (nCounter != 1000 && !oTimer.hasExpired(5000));
+    REQUIRE( nCounter == 1000 );
+}
+
+TEST_CASE( "WORK_STEALING_KEEPS_TASKS_ON_STOP", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2, CThreadPool::EWorkStealing);
+    std::atomic<size_t> nCounter = 0;
+    std::atomic<bool> fRelease = false;
+    oPool.execute();
+
+    oPool.addTask([&]() {
+        for (size_t j = 0; j < 100; j++) {
+            oPool.addTask([&nCounter]() { nCounter++; });
+        }
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+
+    Utils::sleep(10);
+    std::thread oStopper([&oPool]() { oPool.stop(false); });
+    fRelease = true;
+    oStopper.join();
+
+    oPool.execute();
+    CTimer oTimer(true);
+    while (nCounter != 100 && !oTimer.hasExpired(5000));
+    REQUIRE( nCounter == 100 );
+}
+
+TEST_CASE( "RESIZE_KEEPS_QUEUED_TASKS", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(4, CThreadPool::EWorkStealing);
+    std::atomic<size_t> nCounter = 0;
+    std::atomic<bool> fRelease = false;
+    oPool.execute();
+
+    // The tasks wait in the local deque of a worker which is asked to retire
+    oPool.addTask([&]() {
+        for (size_t j = 0; j < 200; j++) {
+            oPool.addTask([&nCounter]() { nCounter++; });
+        }
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+
+    Utils::sleep(10);
+    oPool.resize(1);
+    fRelease = true;
+
+    CTimer oTimer(true);
+    while ((nCounter != 200 || oPool.activeWorkerCount() != 1) && !oTimer.hasExpired(5000));
+    REQUIRE( nCounter == 200 );
+    REQUIRE( oPool.workerCount() == 1 );
+    REQUIRE( oPool.activeWorkerCount() == 1 );
+
+    oPool.resize(3);
+    REQUIRE( oPool.activeWorkerCount() == 3 );
+    for (size_t i = 0; i < 100; i++) {
+        oPool.addTask([&nCounter]() { nCounter++; });
+    }
+
+    oTimer.start();
+    while (nCounter != 300 && !oTimer.hasExpired(5000));
+    REQUIRE( nCounter == 300 );
+}
+
+TEST_CASE( "ELASTIC_GROWS_AND_SHRINKS", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    std::atomic<size_t> nRunning = 0;
+    std::atomic<bool> fRelease = false;
+    oPool.setWorkerLimits(1, 4);
+    oPool.setGrowLatency(std::chrono::milliseconds(1));
+    oPool.setIdleTimeout(std::chrono::milliseconds(50));
+    REQUIRE( oPool.isElastic() );
+    oPool.execute();
+
+    // Every task blocks its worker, so the queued ones are only picked up by new workers
+    for (size_t i = 0; i < 6; i++) {
+        oPool.addTask([&]() {
+            nRunning++;
+            while (!fRelease) {
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    CTimer oTimer(true);
+    while (nRunning != 4 && !oTimer.hasExpired(5000));
+    REQUIRE( nRunning == 4 );
+    REQUIRE( oPool.workerCount() == 4 );
+    REQUIRE( oPool.activeWorkerCount() == 4 );
+
+    fRelease = true;
+    oTimer.start();
+    while (oPool.activeWorkerCount() != 1 && !oTimer.hasExpired(5000));
+    REQUIRE( nRunning == 6 );
+    REQUIRE( oPool.workerCount() == 1 );
+    REQUIRE( oPool.activeWorkerCount() == 1 );
+}
+
+TEST_CASE( "ELASTIC_GROWS_ON_QUEUE_LATENCY", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    std::atomic<size_t> nDone = 0;
+    oPool.setWorkerLimits(1, 4);
+    oPool.setGrowLatency(std::chrono::milliseconds(5));
+    oPool.setIdleTimeout(std::chrono::seconds(5));
+    oPool.execute();
+
+    // The worker picks up a task every millisecond, but the tasks at the end of the queue wait far longer
+    for (size_t i = 0; i < 400; i++) {
+        oPool.addTask([&nDone]() {
+            Utils::sleep(1);
+            nDone++;
+        });
+    }
+
+    size_t nMaxWorkers = 1;
+    CTimer oTimer(true);
+    while (nDone != 400 && !oTimer.hasExpired(10000)) {
+        nMaxWorkers = std::max(nMaxWorkers, oPool.activeWorkerCount());
+        Utils::sleep(1);
+    }
+
+    REQUIRE( nDone == 400 );
+    REQUIRE( nMaxWorkers > 1 );
+}
+
+TEST_CASE( "WORKER_PLACEMENT", "[THREADPOOL_TEST]" ) {
+    const std::vector<size_t> anAllowed = Utils::currentThreadAffinity();
+    const std::vector<size_t> anCpus = anAllowed.empty() ? std::vector<size_t>{} : std::vector<size_t>{anAllowed.front()};
+
+    CThreadPool oPool(2);
+    oPool.setAffinity(CThreadPool::EPinToCore, anCpus);
+    oPool.setThreadName("devel-test");
+    oPool.setNodeLocalQueues(true);
+    REQUIRE( oPool.affinity() == CThreadPool::EPinToCore );
+    REQUIRE( oPool.hasNodeLocalQueues() );
+    oPool.execute();
+
+    CTaskFuture<std::vector<size_t>> oAffinity = oPool.submit([]() { return Utils::currentThreadAffinity(); });
+    REQUIRE( oAffinity.get() == anCpus );
+
+#ifdef __linux__
+    CTaskFuture<std::string> oName = oPool.submit([]() {
+        char szName[16] = {};
+        pthread_getname_np(pthread_self(), szName, sizeof(szName));
+        return std::string(szName);
+    });
+    REQUIRE( oName.get().rfind("devel-test-", 0) == 0 );
+#endif
+
+    std::atomic<size_t> nCounter = 0;
+    for (size_t i = 0; i < 1000; i++) {
+        oPool.addTask([&nCounter]() { nCounter++; });
+    }
+
+    CTimer oTimer(true);
+    while (nCounter != 1000 && !oTimer.hasExpired(5000));
+    REQUIRE( nCounter == 1000 );
+
+    oPool.stop();
+    oPool.setNodeLocalQueues(false);
+    REQUIRE_FALSE( oPool.hasNodeLocalQueues() );
+}
+
+TEST_CASE( "POOL_METRICS", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.setMode(CThreadPool::EWorkStealing);
+    oPool.execute();
+
+    // Let both workers park once, so there is idle time to report
+    Utils::sleep(20);
+
+    std::atomic<size_t> nCounter = 0;
+    for (size_t i = 0; i < 64; i++) {
+        oPool.addTask([&oPool, &nCounter]() {
+            for (size_t j = 0; j < 16; j++) {
+                oPool.addTask([&nCounter]() { nCounter++; });
+            }
+        });
+    }
+
+    CTimer oTimer(true);
+    while (oPool.metrics().executedCount() != 64 * 17 && !oTimer.hasExpired(5000));
+
+    const CThreadPoolMetrics oMetrics = oPool.metrics();
+    REQUIRE( nCounter == 64 * 16 );
+    REQUIRE( oMetrics.executedCount() == 64 * 17 );
+    REQUIRE( oMetrics.m_aoWorkers.size() == 2 );
+    REQUIRE( oMetrics.m_nWorkerCount == 2 );
+    REQUIRE( oMetrics.queueDepth() == 0 );
+    REQUIRE( oMetrics.stolenCount() <= oMetrics.executedCount() );
+    REQUIRE( oMetrics.utilization() >= 0.0 );
+    REQUIRE( oMetrics.utilization() < 1.0 );
+    for (const CWorkerMetrics &oWorker: oMetrics.m_aoWorkers) {
+        REQUIRE( oWorker.m_fIsRunning );
+        REQUIRE( oWorker.m_nIdleNs > 0 );
+        REQUIRE( oWorker.m_nUptimeNs >= oWorker.m_nIdleNs );
+    }
+
+    // Without task timing the histograms stay empty
+    REQUIRE( CThreadPoolMetrics::percentile(oMetrics.runHistogram(), 50) == 0 );
+    REQUIRE( oMetrics.m_aoWorkers[0].m_nTimedTasks == 0 );
+
+    // The worker slots and their counters outlive stop()
+    oPool.stop();
+    const CThreadPoolMetrics oStopped = oPool.metrics();
+    REQUIRE( oStopped.m_aoWorkers.size() == 2 );
+    REQUIRE( oStopped.executedCount() == 64 * 17 );
+    for (const CWorkerMetrics &oWorker: oStopped.m_aoWorkers) {
+        REQUIRE_FALSE( oWorker.m_fIsRunning );
+    }
+
+    oPool.execute();
+    REQUIRE( oPool.metrics().m_aoWorkers.size() == 2 );
+}
+
+TEST_CASE( "POOL_METRICS_FAILED_TASKS", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.execute();
+
+    // The exceptions are dropped by the worker, but counted
+    for (size_t i = 0; i < 10; i++) {
+        oPool.addTask([i]() {
+            if (i % 2 == 0) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    oPool.waitIdle();
+
+    CTimer oTimer(true);
+    while (oPool.metrics().executedCount() != 10 && !oTimer.hasExpired(5000));
+
+    const CThreadPoolMetrics oMetrics = oPool.metrics();
+    REQUIRE( oMetrics.executedCount() == 10 );
+    REQUIRE( oMetrics.failedCount() == 5 );
+    REQUIRE( oMetrics.droppedCount() == 0 );
+}
+
+TEST_CASE( "POOL_METRICS_TASK_TIMING", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.setTaskTiming(true);
+    REQUIRE( oPool.hasTaskTiming() );
+
+    // Tasks queued before execute() wait at least until the pool starts
+    for (size_t i = 0; i < 10; i++) {
+        oPool.addTask([]() { Utils::sleep(2); });
+    }
+    Utils::sleep(10);
+    oPool.execute();
+
+    auto oFuture = oPool.submit([]() { return 42; });
+    REQUIRE( oFuture.get() == 42 );
+
+    CTimer oTimer(true);
+    while (oPool.metrics().m_aoWorkers[0].m_nTimedTasks != 11 && !oTimer.hasExpired(5000));
+
+    const CThreadPoolMetrics oMetrics = oPool.metrics();
+    const CWorkerMetrics &oWorker = oMetrics.m_aoWorkers[0];
+    REQUIRE( oWorker.m_nTimedTasks == 11 );
+    REQUIRE( oWorker.m_nWaitNs >= 10 * 10000000ull );
+    REQUIRE( oWorker.m_nRunNs >= 10 * 2000000ull );
+
+    // Half of the tasks slept for 2ms, so the median run time lies in the 2ms bucket or above
+    REQUIRE( CThreadPoolMetrics::percentile(oMetrics.runHistogram(), 50) >= 2000000 );
+    REQUIRE( CThreadPoolMetrics::percentile(oMetrics.waitHistogram(), 100) >= 10000000 );
+
+    uint64_t nCount = 0;
+    for (const uint64_t nBucket: oMetrics.waitHistogram()) {
+        nCount += nBucket;
+    }
+    REQUIRE( nCount == 11 );
+
+    // Task timing can be switched off on a running pool
+    oPool.setTaskTiming(false);
+    oPool.submit([]() {}).get();
+    Utils::sleep(10);
+    REQUIRE( oPool.metrics().m_aoWorkers[0].m_nTimedTasks == 11 );
+}
+
+TEST_CASE( "WAIT_IDLE_AND_DRAIN", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.setMode(CThreadPool::EWorkStealing);
+    oPool.waitIdle();
+    oPool.execute();
+    oPool.waitIdle();
+
+    // Nested tasks are added while the outer ones run, waitIdle() covers them too
+    std::atomic<size_t> nCounter = 0;
+    for (size_t i = 0; i < 32; i++) {
+        oPool.addTask([&oPool, &nCounter]() {
+            Utils::sleep(1);
+            for (size_t j = 0; j < 8; j++) {
+                oPool.addTask([&nCounter]() { nCounter++; });
+            }
+        });
+    }
+    oPool.waitIdle();
+    REQUIRE( nCounter == 32 * 8 );
+    REQUIRE( oPool.outstandingTaskCount() == 0 );
+
+    // A drained pool has run everything before it stops
+    for (size_t i = 0; i < 100; i++) {
+        oPool.addTask([&nCounter]() {
+            std::this_thread::yield();
+            nCounter++;
+        });
+    }
+    oPool.drainAndStop();
+    REQUIRE_FALSE( oPool.isExecuted() );
+    REQUIRE( nCounter == 32 * 8 + 100 );
+
+    // Tasks added to a stopped pool run on the next execute()
+    oPool.addTask([&nCounter]() { nCounter++; });
+    REQUIRE( oPool.outstandingTaskCount() == 1 );
+    oPool.execute();
+    oPool.waitIdle();
+    REQUIRE( nCounter == 32 * 8 + 101 );
+
+    // A waiter on another thread is released by the last task
+    std::atomic<bool> fRelease = false;
+    oPool.addTask([&fRelease]() {
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+    std::atomic<bool> fIsIdle = false;
+    std::thread oWaiter([&oPool, &fIsIdle]() {
+        oPool.waitIdle();
+        fIsIdle = true;
+    });
+    Utils::sleep(10);
+    REQUIRE_FALSE( fIsIdle );
+    fRelease = true;
+    oWaiter.join();
+    REQUIRE( fIsIdle );
+}
+
+TEST_CASE( "STOP_RELEASES_DROPPED_TASKS", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    std::atomic<bool> fRelease = false;
+    oPool.execute();
+
+    oPool.addTask([&fRelease]() {
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+    for (size_t i = 0; i < 10; i++) {
+        oPool.addTask([]() {});
+    }
+    REQUIRE( oPool.outstandingTaskCount() == 11 );
+
+    // A thread waiting for the pool to become idle is released when the pool is stopped
+    std::thread oWaiter([&oPool]() { oPool.waitIdle(); });
+    std::thread oStopper([&oPool]() { oPool.stop(); });
+    Utils::sleep(10);
+    fRelease = true;
+    oStopper.join();
+    oWaiter.join();
+
+    REQUIRE( oPool.outstandingTaskCount() == 0 );
+}
+
+TEST_CASE( "STOP_WHILE_TASK_RESIZES", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2);
+    std::atomic<bool> fHasStarted = false;
+    std::atomic<bool> fIsStopping = false;
+    std::atomic<bool> fHasResized = false;
+    oPool.execute();
+
+    // The task resizes the pool while stop() waits for it, stop() must not hold the resize mutex meanwhile
+    oPool.addTask([&]() {
+        fHasStarted = true;
+        while (!fIsStopping) {
+            std::this_thread::yield();
+        }
+        Utils::sleep(10);
+        oPool.resize(4);
+        oPool.metrics();
+        fHasResized = true;
+    });
+    while (!fHasStarted) {
+        std::this_thread::yield();
+    }
+
+    std::thread oStopper([&]() {
+        fIsStopping = true;
+        oPool.stop();
+    });
+    oStopper.join();
+
+    REQUIRE( fHasResized );
+    REQUIRE( oPool.isExecuted() == false );
+}
+
+/// @brief A worker-local object counting the tasks of its worker.
+struct CWorkerTaskCount {
+    size_t m_nTasks = 0;
+};
+
+TEST_CASE( "WORKER_LOCAL_STORAGE", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.execute();
+    REQUIRE( CThreadPool::currentWorker() == nullptr );
+
+    constexpr size_t nTasks = 200;
+    std::atomic<size_t> nReused = 0;
+    std::atomic<size_t> nDirty = 0;
+
+    for (size_t i = 0; i < nTasks; i++) {
+        oPool.addTask([&, i]() {
+            CThreadPoolWorker *pWorker = CThreadPool::currentWorker();
+            pWorker->local<CWorkerTaskCount>().m_nTasks++;
+
+            // The scratch buffers start empty in every task, but keep their memory
+            IO::CWriteStream &oStream = pWorker->scratchStream();
+            CScratchArena &oArena = pWorker->scratchArena();
+            if (oStream.size() != 0 || oArena.usedSize() != 0) {
+                nDirty++;
+            }
+            if (oStream.allocatedSize() != 0) {
+                nReused++;
+            }
+
+            oStream.push(std::string(64, 'x'));
+            std::pmr::string stName(&oArena);
+            stName = "task-" + std::to_string(i) + std::string(100, 'y');
+        });
+    }
+    oPool.waitIdle();
+
+    // Every worker summed up its own tasks without synchronization
+    std::atomic<size_t> nCounted = 0;
+    CLatch oDone(2);
+    std::atomic<bool> fRelease = false;
+    for (size_t i = 0; i < 2; i++) {
+        oPool.addTask([&]() {
+            nCounted += CThreadPool::currentWorker()->local<CWorkerTaskCount>().m_nTasks;
+            oDone.countDown();
+            // Keep the worker busy, so the other worker has to run the second task
+            while (!fRelease) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    oDone.wait();
+    fRelease = true;
+
+    REQUIRE( nCounted == nTasks );
+    REQUIRE( nDirty == 0 );
+    REQUIRE( nReused >= nTasks - 2 );
+}
+
+TEST_CASE( "PRIORITY_LANES_STRICT", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    REQUIRE( oPool.lanePolicy() == CThreadPool::EStrictPriority );
+    oPool.execute();
+
+    // Only the single worker writes the order, waitIdle() publishes it
+    std::vector<ETaskPriority> aeOrder;
+    std::atomic<bool> fRelease = false;
+    oPool.addTask([&fRelease]() {
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+    for (const ETaskPriority ePriority: {EBackgroundPriority, ENormalPriority, EHighPriority}) {
+        for (size_t i = 0; i < 20; i++) {
+            oPool.addTask([&aeOrder, ePriority]() { aeOrder.push_back(ePriority); }, ePriority);
+        }
+    }
+    fRelease = true;
+    oPool.waitIdle();
+
+    REQUIRE( aeOrder.size() == 60 );
+    for (size_t i = 0; i < aeOrder.size(); i++) {
+        REQUIRE( aeOrder[i] == static_cast<ETaskPriority>(i / 20) );
+    }
+
+    REQUIRE( oPool.submit(EHighPriority, [](int a) { return a * 2; }, 21).get() == 42 );
+    REQUIRE( oPool.submit([](int a) { return a * 2; }, 4).get() == 8 );
+}
+
+TEST_CASE( "PRIORITY_LANES_WEIGHTED_FAIR", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.setLanePolicy(CThreadPool::EWeightedFair);
+    oPool.setLaneWeights(4, 2, 1);
+    oPool.execute();
+
+    std::vector<ETaskPriority> aeOrder;
+    std::atomic<bool> fRelease = false;
+    oPool.addTask([&fRelease]() {
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+    for (const ETaskPriority ePriority: {EHighPriority, ENormalPriority, EBackgroundPriority}) {
+        for (size_t i = 0; i < 50; i++) {
+            oPool.addTask([&aeOrder, ePriority]() { aeOrder.push_back(ePriority); }, ePriority);
+        }
+    }
+    fRelease = true;
+    oPool.waitIdle();
+
+    // While all lanes are busy the tasks are shared out 4:2:1, the background lane is not starved
+    REQUIRE( aeOrder.size() == 150 );
+    std::array<size_t, TaskPriorityCount> anCount{};
+    for (size_t i = 0; i < 70; i++) {
+        anCount[aeOrder[i]]++;
+    }
+    REQUIRE( anCount[EHighPriority] >= 38 );
+    REQUIRE( anCount[EHighPriority] <= 42 );
+    REQUIRE( anCount[ENormalPriority] >= 18 );
+    REQUIRE( anCount[EBackgroundPriority] >= 8 );
+}
+
+TEST_CASE( "PRIORITY_LANES_RESERVED_WORKER", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.setReservedWorkers(1);
+    REQUIRE( oPool.reservedWorkers() == 1 );
+    oPool.execute();
+
+    // The only unreserved worker is kept busy by bulk work
+    std::atomic<bool> fStarted = false;
+    std::atomic<bool> fRelease = false;
+    std::atomic<size_t> nNormal = 0;
+    oPool.addTask([&fStarted, &fRelease]() {
+        fStarted = true;
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+    while (!fStarted) {
+        std::this_thread::yield();
+    }
+    for (size_t i = 0; i < 10; i++) {
+        oPool.addTask([&nNormal]() { nNormal++; });
+    }
+
+    // The reserved worker runs the high task right away and leaves the normal tasks alone
+    auto oFuture = oPool.submit(EHighPriority, []() { return CThreadPool::currentWorker()->index(); });
+    REQUIRE( oFuture.get() == 0 );
+    REQUIRE( nNormal == 0 );
+
+    fRelease = true;
+    oPool.waitIdle();
+    REQUIRE( nNormal == 10 );
+
+    // A pool never reserves its last worker
+    CThreadPool oSingle(1);
+    oSingle.setReservedWorkers(1);
+    oSingle.execute();
+    REQUIRE( oSingle.submit([]() { return 1; }).get() == 1 );
+}
+
+TEST_CASE( "PRIORITY_LANE_METRICS", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.setTaskTiming(true);
+    oPool.execute();
+
+    std::atomic<bool> fStarted = false;
+    std::atomic<bool> fRelease = false;
+    oPool.addTask([&fStarted, &fRelease]() {
+        fStarted = true;
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+    while (!fStarted) {
+        std::this_thread::yield();
+    }
+
+    // The background tasks are queued first and run last, so they wait longer
+    for (size_t i = 0; i < 5; i++) {
+        oPool.addTask([]() {}, EBackgroundPriority);
+    }
+    Utils::sleep(5);
+    for (size_t i = 0; i < 3; i++) {
+        oPool.addTask([]() {}, EHighPriority);
+    }
+
+    CThreadPoolMetrics oMetrics = oPool.metrics();
+    REQUIRE( oMetrics.queueDepth(EHighPriority) == 3 );
+    REQUIRE( oMetrics.queueDepth(EBackgroundPriority) == 5 );
+    REQUIRE( oMetrics.queueDepth(ENormalPriority) == 0 );
+    REQUIRE( oMetrics.queueDepth() == 8 );
+
+    fRelease = true;
+    oPool.waitIdle();
+
+    // The last task is recorded after it finished, waitIdle() may return a moment before
+    CTimer oTimer(true);
+    while (oPool.metrics().m_aoWorkers[0].m_nTimedTasks != 9 && !oTimer.hasExpired(5000));
+
+    oMetrics = oPool.metrics();
+    const CWorkerMetrics &oWorker = oMetrics.m_aoWorkers[0];
+    REQUIRE( oWorker.m_anLaneTimedTasks[EHighPriority] == 3 );
+    REQUIRE( oWorker.m_anLaneTimedTasks[ENormalPriority] == 1 );
+    REQUIRE( oWorker.m_anLaneTimedTasks[EBackgroundPriority] == 5 );
+    REQUIRE( oMetrics.meanWait(EBackgroundPriority) >= 5000000 );
+    REQUIRE( oMetrics.meanWait(EBackgroundPriority) > oMetrics.meanWait(EHighPriority) );
+
+    uint64_t nCount = 0;
+    for (const uint64_t nBucket: oMetrics.waitHistogram(EHighPriority)) {
+        nCount += nBucket;
+    }
+    REQUIRE( nCount == 3 );
+    REQUIRE( oMetrics.queueDepth() == 0 );
+}
+
+/// @brief Runs a fan-out workload on the pool: 64 root tasks each spawning 64 leaf tasks from inside the pool.
+static void runFanOut(CThreadPool &i_oPool) {
+    std::atomic<size_t> nCounter = 0;
+
+    for (size_t i = 0; i < 64; i++) {
+        i_oPool.addTask([&i_oPool, &nCounter]() {
+            for (size_t j = 0; j < 64; j++) {
+                i_oPool.addTask([&nCounter]() { nCounter++; });
+            }
+        });
+    }
+
+    while (nCounter != 64 * 64) {
+        std::this_thread::yield();
+    }
+}
+
+TEST_CASE( "IDLE_WORKER_WAKEUP_LATENCY", "[.][THREADPOOL_BENCHMARK]" ) {
+    // Without a spin phase the worker parks right after every task
+    CThreadPool oPool(1);
+    oPool.setSpinCount(0);
+    oPool.execute();
+
+    BENCHMARK_ADVANCED("wake a parked worker")(Catch::Benchmark::Chronometer oMeter) {
+        Utils::sleep(20);
+        oMeter.measure([&oPool]() {
+            std::atomic<bool> fDone = false;
+            oPool.addTask([&fDone]() { fDone = true; });
+            while (!fDone) {
+                std::this_thread::yield();
+            }
+        });
+    };
+}
+
+TEST_CASE( "SHARED_QUEUE_VS_WORK_STEALING", "[.][THREADPOOL_BENCHMARK]" ) {
+    for (const size_t nThreads: {1, 4, 16, 64}) {
+        CThreadPool oShared(nThreads, CThreadPool::ESharedQueue);
+        CThreadPool oStealing(nThreads, CThreadPool::EWorkStealing);
+        oShared.execute();
+        oStealing.execute();
+
+        BENCHMARK("SharedQueue " + std::to_string(nThreads) + " threads") {
+            return runFanOut(oShared);
+        };
+
+        BENCHMARK("WorkStealing " + std::to_string(nThreads) + " threads") {
+            return runFanOut(oStealing);
+        };
+    }
+}
+
+TEST_CASE( "PRIORITY_LANE_LATENCY", "[.][THREADPOOL_BENCHMARK]" ) {
+    CThreadPool oPool(std::thread::hardware_concurrency());
+    oPool.execute();
+
+    // Adds a backlog of 2000 batch tasks and waits for a control task added behind it
+    const auto fnRun = [&oPool](const ETaskPriority i_eBatch, const ETaskPriority i_eControl) {
+        for (size_t i = 0; i < 2000; i++) {
+            oPool.addTask([]() {
+                for (size_t j = 0; j < 200; j++) {
+                    Utils::cpuRelax();
+                }
+            }, i_eBatch);
+        }
+        return oPool.submit(i_eControl, []() { return 1; }).get();
+    };
+
+    BENCHMARK_ADVANCED("control task in the same lane")(Catch::Benchmark::Chronometer oMeter) {
+        oPool.waitIdle();
+        oMeter.measure([&fnRun]() { return fnRun(ENormalPriority, ENormalPriority); });
+    };
+
+    BENCHMARK_ADVANCED("control task in the high lane")(Catch::Benchmark::Chronometer oMeter) {
+        oPool.waitIdle();
+        oMeter.measure([&fnRun]() { return fnRun(EBackgroundPriority, EHighPriority); });
+    };
+}
+
+TEST_CASE( "SUBMIT_RETURNS_RESULT", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.execute();
+
+    CTaskFuture<int> oFuture = oPool.submit([](int a, int b) { return a + b; }, 1, 2);
+    REQUIRE( oFuture.isValid() );
+    REQUIRE( oFuture.get() == 3 );
+    REQUIRE( oFuture.isValid() == false );
+
+    CTaskFuture<void> oVoidFuture = oPool.submit([]() {});
+    oVoidFuture.wait();
+    REQUIRE( oVoidFuture.isReady() );
+}
+
+TEST_CASE( "SUBMIT_PROPAGATES_EXCEPTION", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.execute();
+
+    auto oFuture = oPool.submit([]() -> int { throw std::runtime_error("failed"); });
+    REQUIRE_THROWS_AS( oFuture.get(), std::runtime_error );
+
+    auto oChained = oPool.submit([]() -> int { throw std::runtime_error("failed"); })
+            .then([](int i) { return i * 2; });
+    REQUIRE_THROWS_AS( oChained.get(), std::runtime_error );
+
+    // The worker survives exceptions of plain tasks
+    oPool.addTask([]() { throw std::runtime_error("failed"); });
+    REQUIRE( oPool.submit([]() { return 1; }).get() == 1 );
+}
+
+TEST_CASE( "SUBMIT_THEN_CHAINS", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(2);
+    oPool.execute();
+
+    auto oFuture = oPool.submit([]() { return std::string("abc"); })
+            .then([](std::string s) { return s.size(); })
+            .then([](size_t n) { return static_cast<int>(n) * 2; });
+    REQUIRE( oFuture.get() == 6 );
+
+    std::atomic<int> nValue = 0;
+    oPool.submit([]() {}).then([&nValue]() { nValue = 1; }).get();
+    REQUIRE( nValue == 1 );
+
+    // A continuation may be move-only
+    auto pOffset = std::make_unique<int>(10);
+    auto oMoveOnly = oPool.submit([]() { return 1; })
+            .then([pOffset = std::move(pOffset)](const int i_nValue) { return i_nValue + *pOffset; });
+    REQUIRE( oMoveOnly.get() == 11 );
+}
+
+TEST_CASE( "SUBMIT_BROKEN_PROMISE", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    std::atomic<bool> fRelease = false;
+    oPool.execute();
+
+    oPool.addTask([&fRelease]() {
+        while (!fRelease) {
+            std::this_thread::yield();
+        }
+    });
+    auto oDropped = oPool.submit([]() { return 1; });
+
+    std::thread oStopper([&oPool]() { oPool.stop(); });
+    Utils::sleep(10);
+    fRelease = true;
+    oStopper.join();
+
+    REQUIRE( oDropped.isReady() );
+    REQUIRE_THROWS_AS( oDropped.get(), std::logic_error );
+}
+
+TEST_CASE( "INPLACE_TASK_MOVE_ONLY_CAPTURE", "[THREADPOOL_TEST]" ) {
+    CThreadPool oPool(1);
+    oPool.execute();
+
+    auto pValue = std::make_unique<int>(42);
+    auto oFuture = oPool.submit([pValue = std::move(pValue)]() { return *pValue; });
+    REQUIRE( oFuture.get() == 42 );
+
+    ThreadPoolTaskFn fnEmpty;
+    REQUIRE_FALSE( fnEmpty );
+    REQUIRE_THROWS_AS( fnEmpty(), std::bad_function_call );
+
+    int nCalls = 0;
+    ThreadPoolTaskFn fnTask([&nCalls]() { nCalls++; });
+    ThreadPoolTaskFn fnMoved = std::move(fnTask);
+    REQUIRE_FALSE( fnTask );
+    fnMoved();
+    REQUIRE( nCalls == 1 );
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include "Devel.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+using namespace Devel;
+using namespace Devel::Threading;
+
+TEST_CASE( "TIMER_WHEEL_SCHEDULE_AFTER", "[TIMERWHEEL_TEST]" ) {
+    CThreadPool oPool(2);
+    CTimerWheel oTimers(oPool);
+    oPool.execute();
+    REQUIRE( oTimers.execute() );
+    REQUIRE_FALSE( oTimers.execute() );
+
+    const auto oStart = std::chrono::steady_clock::now();
+    std::atomic<int64_t> nElapsedMs = -1;
+    const CTimerHandle oHandle = oTimers.scheduleAfter(std::chrono::milliseconds(20), [&]() {
+        nElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - oStart).count();
+    });
+    REQUIRE( oHandle.isValid() );
+    REQUIRE( oTimers.isPending(oHandle) );
+    REQUIRE( oTimers.pendingCount() == 1 );
+
+    CTimer oTimer(true);
+    while (nElapsedMs < 0 && !oTimer.hasExpired(5000));
+    REQUIRE( nElapsedMs >= 20 );
+    REQUIRE_FALSE( oTimers.isPending(oHandle) );
+    REQUIRE_FALSE( oTimers.cancel(oHandle) );
+    REQUIRE( oTimers.pendingCount() == 0 );
+}
+
+TEST_CASE( "TIMER_WHEEL_CANCEL_AND_RESCHEDULE", "[TIMERWHEEL_TEST]" ) {
+    CThreadPool oPool(1);
+    CTimerWheel oTimers(oPool);
+    oPool.execute();
+    oTimers.execute();
+
+    std::atomic<size_t> nCancelled = 0;
+    std::atomic<size_t> nFired = 0;
+    const CTimerHandle oCancelled = oTimers.scheduleAfter(std::chrono::milliseconds(10), [&]() { nCancelled++; });
+    const CTimerHandle oMoved = oTimers.scheduleAfter(std::chrono::seconds(60), [&]() { nFired++; });
+
+    REQUIRE( oTimers.cancel(oCancelled) );
+    REQUIRE_FALSE( oTimers.cancel(oCancelled) );
+    REQUIRE( oTimers.reschedule(oMoved, std::chrono::milliseconds(10)) );
+
+    // The entry of the cancelled timer is reused, the old handle must not reach the new timer
+    const CTimerHandle oReused = oTimers.scheduleAfter(std::chrono::seconds(60), []() {});
+    REQUIRE_FALSE( oTimers.isPending(oCancelled) );
+    REQUIRE( oTimers.isPending(oReused) );
+
+    CTimer oTimer(true);
+    while (nFired == 0 && !oTimer.hasExpired(5000));
+    Utils::sleep(20);
+    REQUIRE( nFired == 1 );
+    REQUIRE( nCancelled == 0 );
+    REQUIRE( oTimers.cancel(oReused) );
+    REQUIRE_FALSE( oTimers.reschedule(oReused, std::chrono::milliseconds(1)) );
+}
+
+TEST_CASE( "TIMER_WHEEL_SCHEDULE_EVERY", "[TIMERWHEEL_TEST]" ) {
+    CThreadPool oPool(2);
+    CTimerWheel oTimers(oPool);
+    oPool.execute();
+    oTimers.execute();
+
+    std::atomic<size_t> nRuns = 0;
+    const CTimerHandle oHandle = oTimers.scheduleEvery(std::chrono::milliseconds(2), [&nRuns]() { nRuns++; });
+
+    CTimer oTimer(true);
+    while (nRuns < 5 && !oTimer.hasExpired(5000));
+    REQUIRE( nRuns >= 5 );
+    REQUIRE( oTimers.isPending(oHandle) );
+
+    REQUIRE( oTimers.cancel(oHandle) );
+    Utils::sleep(10);
+    const size_t nStopped = nRuns;
+    Utils::sleep(20);
+    REQUIRE( nRuns == nStopped );
+}
+
+TEST_CASE( "TIMER_WHEEL_CASCADES_LEVELS", "[TIMERWHEEL_TEST]" ) {
+    CThreadPool oPool(2);
+    // With 10us ticks the delays below span the first three levels of the wheel
+    CTimerWheel oTimers(oPool, std::chrono::microseconds(10));
+    oPool.execute();
+
+    constexpr size_t nCount = 2000;
+    const auto oStart = std::chrono::steady_clock::now();
+    std::atomic<size_t> nFired = 0;
+    std::atomic<size_t> nEarly = 0;
+
+    for (size_t i = 0; i < nCount; i++) {
+        const auto oDelay = std::chrono::microseconds((i * 7919) % 1000000);
+        oTimers.scheduleAfter(oDelay, [&, oDelay]() {
+            if (std::chrono::steady_clock::now() - oStart < oDelay) {
+                nEarly++;
+            }
+            nFired++;
+        });
+    }
+    REQUIRE( oTimers.pendingCount() == nCount );
+    oTimers.execute();
+
+    CTimer oTimer(true);
+    while (nFired != nCount && !oTimer.hasExpired(10000));
+    REQUIRE( nFired == nCount );
+    REQUIRE( nEarly == 0 );
+    REQUIRE( oTimers.pendingCount() == 0 );
+}
+
+TEST_CASE( "TIMER_WHEEL_PENDING_TIMEOUTS", "[.][TIMERWHEEL_BENCHMARK]" ) {
+    CThreadPool oPool(1);
+    CTimerWheel oTimers(oPool);
+    std::vector<CTimerHandle> aoHandles(1000000);
+
+    BENCHMARK("schedule 1M timeouts") {
+        for (size_t i = 0; i < aoHandles.size(); i++) {
+            aoHandles[i] = oTimers.scheduleAfter(std::chrono::seconds(30 + i % 60), []() {});
+        }
+    };
+
+    BENCHMARK("reschedule 1M timeouts") {
+        for (const CTimerHandle &oHandle: aoHandles) {
+            oTimers.reschedule(oHandle, std::chrono::seconds(45));
+        }
+    };
+
+    BENCHMARK("cancel 1M timeouts") {
+        for (const CTimerHandle &oHandle: aoHandles) {
+            oTimers.cancel(oHandle);
+        }
+    };
+}
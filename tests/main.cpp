@@ -10,4 +10,22 @@
 #include "Serializing_Test.h"
 #include "Json_Test.h"
 #include "StringUtils_Test.h"
-#include "VectorUtils_Test.h"
\ No newline at end of file
+#include "VectorUtils_Test.h"
+#include "SafeQueue_Test.h"
+#include "MutexVector_Test.h"
+#include "LockPolicy_Test.h"
+#include "LockProfiler_Test.h"
+#include "ConcurrentHashMap_Test.h"
+#include "SnapshotVector_Test.h"
+#include "CpuTopology_Test.h"
+#include "ThreadPool_Test.h"
+#include "TimerWheel_Test.h"
+#include "Task_Test.h"
+#include "TaskGraph_Test.h"
+#include "Pipeline_Test.h"
+#include "Latch_Test.h"
+#include "CancellationToken_Test.h"
+#include "ScratchArena_Test.h"
+#include "Parallel_Test.h"
+#include "BoundedQueue_Test.h"
+#include "SpscQueue_Test.h"